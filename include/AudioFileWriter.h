@@ -0,0 +1,95 @@
+#ifndef AUDIO_FILE_WRITER_H
+#define AUDIO_FILE_WRITER_H
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "MD5.h"
+
+// Formats de sortie du rendu hors ligne
+enum class AudioFileFormat {
+    Wav,    // PCM 16 bits little-endian
+    Flac,   // FLAC sans perte (encodeur interne, aucune dépendance externe)
+    Raw     // PCM 16 bits little-endian sans en-tête
+};
+
+// Écriture d'un flux PCM 16 bits entrelacé vers un fichier audio
+// open() puis write() autant de fois que nécessaire, close() finalise l'en-tête (tailles, MD5...)
+class AudioFileWriter {
+public:
+    virtual ~AudioFileWriter() = default;
+
+    virtual bool open(const std::string& filepath, int sampleRate, int channels) = 0;
+    // frames = nombre d'échantillons par canal
+    virtual bool write(const int16_t* samples, size_t frames) = 0;
+    virtual bool close() = 0;
+
+    // Déduit le format de l'extension (.wav, .flac, .raw/.pcm) ; false si inconnue
+    static bool formatFromPath(const std::string& filepath, AudioFileFormat& format);
+    static std::unique_ptr<AudioFileWriter> create(AudioFileFormat format);
+};
+
+class WavFileWriter : public AudioFileWriter {
+public:
+    ~WavFileWriter() override;
+    bool open(const std::string& filepath, int sampleRate, int channels) override;
+    bool write(const int16_t* samples, size_t frames) override;
+    bool close() override;
+
+private:
+    std::ofstream m_file;
+    int m_channels = 0;
+    uint64_t m_dataBytes = 0;
+};
+
+// Flux brut (s16le entrelacé) : aucun en-tête, lisible en continu pendant l'écriture
+class RawFileWriter : public AudioFileWriter {
+public:
+    ~RawFileWriter() override;
+    bool open(const std::string& filepath, int sampleRate, int channels) override;
+    bool write(const int16_t* samples, size_t frames) override;
+    bool close() override;
+
+private:
+    std::ofstream m_file;
+    int m_channels = 0;
+};
+
+/**
+ * Encodeur FLAC minimal (16 bits, blocs de taille fixe)
+ *
+ * Chaque bloc est codé en sous-trame constante (silence), prédicteur fixe d'ordre 0 à 4
+ * (le moins coûteux) ou verbatim, résidus en codes de Rice partitionnés. Pas de décorrélation
+ * stéréo ni de LPC : compression proche de "flac -1", suffisante pour un cache de rendus.
+ * Le MD5 du signal est écrit dans STREAMINFO, comme le fait l'encodeur de référence.
+ */
+class FlacFileWriter : public AudioFileWriter {
+public:
+    static const int BLOCK_SIZE = 4096;
+
+    ~FlacFileWriter() override;
+    bool open(const std::string& filepath, int sampleRate, int channels) override;
+    bool write(const int16_t* samples, size_t frames) override;
+    bool close() override;
+
+private:
+    bool encodeFrame(size_t frames); // Encode les frames en attente (m_pending) et les écrit
+    void writeStreamInfo(bool final); // final : tailles, durée et MD5 définitifs
+
+    std::ofstream m_file;
+    int m_sampleRate = 0;
+    int m_channels = 0;
+    uint64_t m_totalFrames = 0;
+    uint32_t m_frameNumber = 0;
+    uint32_t m_minFrameBytes = 0;
+    uint32_t m_maxFrameBytes = 0;
+    std::vector<int16_t> m_pending;     // Échantillons entrelacés en attente d'un bloc complet
+    std::vector<int32_t> m_channel;     // Un canal désentrelacé
+    std::vector<int32_t> m_residual;
+    std::vector<uint8_t> m_frameBytes;
+    imsid::ImSidMD5 m_md5;
+};
+
+#endif // AUDIO_FILE_WRITER_H
@@ -0,0 +1,79 @@
+#ifndef AUDIO_KERNELS_H
+#define AUDIO_KERNELS_H
+
+#include <cstdint>
+
+namespace imsid {
+namespace audio {
+
+/**
+ * Kernels vectorisés pour le chemin de rendu audio
+ *
+ * Chaque kernel a une version scalaire de référence et des versions SSE2/AVX2 (x86)
+ * ou NEON (ARM). La meilleure version supportée par le CPU est choisie au premier appel.
+ * Tous les kernels acceptent n'importe quel count (la queue est traitée en scalaire)
+ * et des buffers non alignés. Aucune allocation.
+ */
+enum class KernelPath {
+    Scalar,
+    SSE2,
+    AVX2,
+    NEON
+};
+
+/**
+ * Somme saturée de trois voix int16 : out[i] = clamp(a[i] + b[i] + c[i], -32768, 32767)
+ * La somme est faite sur 32 bits (pas de saturation intermédiaire)
+ */
+void mixSaturate3(const int16_t* a, const int16_t* b, const int16_t* c, int16_t* out, int count);
+
+/**
+ * Rampe de gain linéaire en place : buf[i] = int16(buf[i] * (gainStart + i * gainStep))
+ * Conversion par troncature (comme static_cast<int16_t>), saturée à la plage int16 (gain > 1 possible)
+ */
+void applyGainRamp(int16_t* buf, int count, float gainStart, float gainStep);
+
+/**
+ * Conversion int16 -> float normalisé : out[i] = in[i] / 32768.0f
+ */
+void int16ToFloat(const int16_t* in, float* out, int count);
+
+/**
+ * Produit scalaire float : somme des a[i] * b[i] (filtres FIR du rééchantillonneur)
+ * L'ordre des additions diffère selon le chemin : résultats égaux à l'arrondi près
+ */
+float dotProduct(const float* a, const float* b, int count);
+
+/**
+ * Chemin actuellement utilisé (détecté au premier appel)
+ */
+KernelPath getKernelPath();
+
+/**
+ * Forcer un chemin (tests, benchmarks)
+ * @return false si le chemin n'est pas supporté par ce CPU/cette compilation
+ */
+bool setKernelPath(KernelPath path);
+
+/**
+ * Vérifier si un chemin est utilisable sur ce CPU
+ */
+bool isKernelPathSupported(KernelPath path);
+
+/**
+ * Nom lisible d'un chemin ("Scalar", "SSE2", "AVX2", "NEON")
+ */
+const char* kernelPathName(KernelPath path);
+
+// Implémentations scalaires de référence (toujours disponibles)
+namespace scalar {
+    void mixSaturate3(const int16_t* a, const int16_t* b, const int16_t* c, int16_t* out, int count);
+    void applyGainRamp(int16_t* buf, int count, float gainStart, float gainStep);
+    void int16ToFloat(const int16_t* in, float* out, int count);
+    float dotProduct(const float* a, const float* b, int count);
+}
+
+} // namespace audio
+} // namespace imsid
+
+#endif // AUDIO_KERNELS_H
@@ -0,0 +1,78 @@
+#ifndef AUDIO_RING_BUFFER_H
+#define AUDIO_RING_BUFFER_H
+
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Ring buffer lock-free mono-producteur / mono-consommateur d'échantillons int16
+// Producteur : thread de rendu SID. Consommateur : callback audio SDL.
+// Aucune allocation ni verrou après la construction (utilisable en temps réel).
+class AudioRingBuffer {
+public:
+    // La capacité est arrondie à la puissance de 2 supérieure (masquage au lieu de modulo)
+    explicit AudioRingBuffer(size_t capacity) : m_writePos(0), m_readPos(0) {
+        resize(capacity);
+    }
+
+    // Réallouer (vide le buffer) : uniquement quand producteur ET consommateur sont à l'arrêt
+    void resize(size_t capacity) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        m_buffer.assign(cap, 0);
+        m_mask = cap - 1;
+        reset();
+    }
+
+    // Côté producteur : écrit jusqu'à count échantillons, retourne le nombre réellement écrits
+    size_t write(const int16_t* data, size_t count) {
+        size_t writePos = m_writePos.load(std::memory_order_relaxed);
+        size_t readPos = m_readPos.load(std::memory_order_acquire);
+        size_t toWrite = std::min(count, m_buffer.size() - (writePos - readPos));
+        size_t offset = writePos & m_mask;
+        size_t firstPart = std::min(toWrite, m_buffer.size() - offset);
+        std::memcpy(m_buffer.data() + offset, data, firstPart * sizeof(int16_t));
+        std::memcpy(m_buffer.data(), data + firstPart, (toWrite - firstPart) * sizeof(int16_t));
+        m_writePos.store(writePos + toWrite, std::memory_order_release);
+        return toWrite;
+    }
+
+    // Côté consommateur : lit jusqu'à count échantillons, retourne le nombre réellement lus
+    size_t read(int16_t* out, size_t count) {
+        size_t readPos = m_readPos.load(std::memory_order_relaxed);
+        size_t writePos = m_writePos.load(std::memory_order_acquire);
+        size_t toRead = std::min(count, writePos - readPos);
+        size_t offset = readPos & m_mask;
+        size_t firstPart = std::min(toRead, m_buffer.size() - offset);
+        std::memcpy(out, m_buffer.data() + offset, firstPart * sizeof(int16_t));
+        std::memcpy(out + firstPart, m_buffer.data(), (toRead - firstPart) * sizeof(int16_t));
+        m_readPos.store(readPos + toRead, std::memory_order_release);
+        return toRead;
+    }
+
+    // Nombre d'échantillons prêts à être lus (approximatif si appelé depuis un troisième thread)
+    size_t available() const {
+        return m_writePos.load(std::memory_order_acquire) - m_readPos.load(std::memory_order_acquire);
+    }
+    size_t freeSpace() const { return m_buffer.size() - available(); }
+    size_t capacity() const { return m_buffer.size(); }
+
+    // Vider le buffer : uniquement quand producteur ET consommateur sont à l'arrêt
+    void reset() {
+        m_writePos.store(0, std::memory_order_relaxed);
+        m_readPos.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::vector<int16_t> m_buffer;
+    size_t m_mask;
+    // Positions monotones (le débordement de size_t est sans effet grâce au masque)
+    // Sur des lignes de cache séparées pour éviter le faux partage producteur/consommateur
+    alignas(64) std::atomic<size_t> m_writePos;
+    alignas(64) std::atomic<size_t> m_readPos;
+};
+
+#endif // AUDIO_RING_BUFFER_H
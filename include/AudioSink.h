@@ -0,0 +1,126 @@
+#ifndef AUDIO_SINK_H
+#define AUDIO_SINK_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "AudioFileWriter.h"
+
+// Sorties audio de SidPlayer
+enum class AudioSinkType {
+    Sdl,    // Périphérique SDL (défaut)
+    Null,   // Aucun son, cadencé par une horloge haute résolution (CI, serveurs, mesures)
+    File    // Comme Null, mais le flux est écrit dans un fichier (.wav, .flac, .raw)
+};
+
+struct AudioSinkFormat {
+    int sampleRate = 0;
+    int channels = 0;
+    int bufferFrames = 0;   // Trames demandées par appel du callback
+};
+
+// Sortie audio pilotée par callback (modèle SDL) : la sortie réclame des blocs de trames
+// int16 entrelacées depuis son propre thread. pause(true) ne retourne qu'une fois le callback
+// en cours terminé, comme SDL_PauseAudioDevice.
+class AudioSink {
+public:
+    using Callback = void (*)(void* userdata, int16_t* out, int frames);
+
+    virtual ~AudioSink() = default;
+
+    // La sortie peut imposer un autre format (obtained) ; démarre en pause
+    virtual bool open(const AudioSinkFormat& desired, AudioSinkFormat& obtained, Callback callback, void* userdata) = 0;
+    virtual void close() = 0;
+    virtual void pause(bool paused) = 0;
+    virtual bool isOpen() const = 0;
+    virtual const char* getName() const = 0;
+    const std::string& getLastError() const { return m_lastError; }
+
+    // outputPath : fichier de sortie du type File (format déduit de l'extension)
+    static std::unique_ptr<AudioSink> create(AudioSinkType type, const std::string& outputPath = "");
+    static bool typeFromName(const std::string& name, AudioSinkType& type); // "sdl", "null", "file"
+    static const char* typeName(AudioSinkType type);
+
+protected:
+    std::string m_lastError;
+};
+
+class SdlAudioSink : public AudioSink {
+public:
+    ~SdlAudioSink() override;
+    bool open(const AudioSinkFormat& desired, AudioSinkFormat& obtained, Callback callback, void* userdata) override;
+    void close() override;
+    void pause(bool paused) override;
+    bool isOpen() const override { return m_device != 0; }
+    const char* getName() const override { return "SDL"; }
+
+private:
+    static void sdlCallback(void* userdata, Uint8* stream, int len);
+
+    SDL_AudioDeviceID m_device = 0;
+    int m_channels = 0;
+    Callback m_callback = nullptr;
+    void* m_userdata = nullptr;
+};
+
+// Sortie sans périphérique : un thread appelle le callback à chaque période de buffer
+// (échéances absolues sur steady_clock, sans dérive), puis remet le bloc à consume()
+class ClockedAudioSink : public AudioSink {
+public:
+    ~ClockedAudioSink() override;
+    bool open(const AudioSinkFormat& desired, AudioSinkFormat& obtained, Callback callback, void* userdata) override;
+    void close() override;
+    void pause(bool paused) override;
+    bool isOpen() const override { return m_thread.joinable(); }
+
+protected:
+    virtual bool openOutput(const AudioSinkFormat& /*format*/) { return true; }
+    virtual void consume(const int16_t* /*samples*/, int /*frames*/) {}
+    virtual void closeOutput() {}
+
+private:
+    void clockLoop();
+
+    AudioSinkFormat m_format;
+    Callback m_callback = nullptr;
+    void* m_userdata = nullptr;
+    std::vector<int16_t> m_buffer;
+    std::thread m_thread;
+    std::mutex m_mutex;                 // Protège m_paused / m_running pour la condition
+    std::condition_variable m_condition;
+    std::mutex m_callbackMutex;         // Tenu pendant le callback : pause(true) attend sa fin
+    bool m_running = false;
+    bool m_paused = true;
+};
+
+class NullAudioSink : public ClockedAudioSink {
+public:
+    ~NullAudioSink() override { close(); }
+    const char* getName() const override { return "Null"; }
+};
+
+// Écrit les blocs joués (pas les pauses) ; le fichier est finalisé à close()
+class FileAudioSink : public ClockedAudioSink {
+public:
+    explicit FileAudioSink(const std::string& outputPath) : m_outputPath(outputPath) {}
+    ~FileAudioSink() override { close(); }
+    const char* getName() const override { return "File"; }
+
+protected:
+    bool openOutput(const AudioSinkFormat& format) override;
+    void consume(const int16_t* samples, int frames) override;
+    void closeOutput() override;
+
+private:
+    std::string m_outputPath;
+    std::unique_ptr<AudioFileWriter> m_writer;
+    bool m_writeFailed = false;
+};
+
+#endif // AUDIO_SINK_H
@@ -0,0 +1,85 @@
+#ifndef AUDIO_TIMING_STATS_H
+#define AUDIO_TIMING_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Mesures de temps du chemin audio : une étape = un histogramme fixe (quarts d'octave en µs)
+// Écriture lock-free et sans allocation : chaque étape n'a qu'un écrivain (thread de rendu,
+// ou callback SDL pour STAGE_CALLBACK), l'UI lit en concurrence des valeurs approximatives.
+class AudioTimingStats {
+public:
+    enum Stage {
+        STAGE_MASTER,     // play() du moteur master
+        STAGE_VOICES,     // Moteurs d'analyse ou taps par registres
+        STAGE_CROSSFADE,  // Moteur de réserve pendant un fondu enchaîné
+        STAGE_POST,       // Silence, gain, oscilloscopes, spectre
+        STAGE_RESAMPLE,   // Rééchantillonnage vers le périphérique
+        STAGE_BLOCK,      // Bloc complet (budget : durée du bloc à la fréquence d'émulation)
+        STAGE_CALLBACK,   // Callback SDL (budget : durée d'un buffer périphérique)
+        STAGE_COUNT
+    };
+
+    // Seaux 0-3 : 0..3 µs exacts, puis 4 seaux par octave jusqu'à ~1 s
+    static const int BUCKETS = 80;
+
+    struct Summary {
+        uint64_t count = 0;
+        double meanUs = 0.0;
+        double p50Us = 0.0;   // Borne haute du seau contenant le percentile
+        double p99Us = 0.0;
+        double maxUs = 0.0;
+    };
+
+    AudioTimingStats();
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    static const char* stageName(int stage);
+    static int bucketIndex(int64_t us);
+    static int64_t bucketLowerUs(int bucket);
+
+    // Budgets temps réel (en ns) ; à fixer quand producteur et consommateur sont à l'arrêt
+    void setBudgets(int64_t callbackPeriodNs, int64_t blockPeriodNs);
+    int64_t getCallbackBudgetNs() const { return m_callbackBudgetNs.load(std::memory_order_relaxed); }
+    int64_t getBlockBudgetNs() const { return m_blockBudgetNs.load(std::memory_order_relaxed); }
+
+    // Un bloc plus long que sa durée audio compte un dépassement (émulation plus lente que le temps réel)
+    void record(int stage, int64_t ns);
+    // intervalNs : écart depuis le callback précédent (0 si inconnu) ; retard au-delà de 1,5 période
+    void recordCallback(int64_t ns, int64_t intervalNs);
+    void countUnderrun() { m_underruns.fetch_add(1, std::memory_order_relaxed); }
+
+    uint64_t getUnderruns() const { return m_underruns.load(std::memory_order_relaxed); }
+    uint64_t getLateCallbacks() const { return m_lateCallbacks.load(std::memory_order_relaxed); }
+    uint64_t getOverruns() const { return m_overruns.load(std::memory_order_relaxed); }
+    uint64_t getBucketCount(int stage, int bucket) const;
+    Summary getSummary(int stage) const;
+
+    // Remise à zéro depuis l'UI : les incréments concurrents peuvent être perdus (sans conséquence)
+    void reset();
+
+    // Ajoute un rapport texte (contexte, résumé par étape, histogrammes non vides) à la fin du fichier
+    bool appendReport(const std::string& path, const std::string& context) const;
+
+private:
+    struct StageData {
+        std::atomic<uint64_t> buckets[BUCKETS];
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> totalNs;
+        std::atomic<int64_t> maxNs;
+    };
+
+    StageData m_stages[STAGE_COUNT];
+    std::atomic<int64_t> m_callbackBudgetNs;
+    std::atomic<int64_t> m_blockBudgetNs;
+    std::atomic<uint64_t> m_underruns;
+    std::atomic<uint64_t> m_lateCallbacks;
+    std::atomic<uint64_t> m_overruns;
+};
+
+#endif // AUDIO_TIMING_STATS_H
@@ -0,0 +1,101 @@
+#ifndef BATCH_RENDERER_H
+#define BATCH_RENDERER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "AudioFileWriter.h"
+#include "OfflineRenderer.h"
+
+namespace fs = std::filesystem;
+
+struct RootFolderEntry;
+
+// Un subsong à rendre vers un fichier
+struct BatchRenderJob {
+    std::string inputPath;
+    std::string outputPath;
+    int song = 1;                    // 1-based
+    double durationSeconds = 0.0;    // <= 0 : résolue par OfflineRenderer (Songlengths.md5 ou défaut)
+};
+
+struct BatchRenderOptions {
+    int threads = 0;                 // 0 = un worker par cœur
+    int sampleRate = 44100;
+    std::string manifestPath;        // Journal de reprise (vide = pas de reprise)
+};
+
+struct BatchRenderProgress {
+    size_t total = 0;
+    size_t completed = 0;            // Rendus terminés avec succès pendant cette exécution
+    size_t failed = 0;
+    size_t skipped = 0;              // Déjà présents dans le manifeste
+    double audioSeconds = 0.0;       // Durée audio rendue pendant cette exécution
+    double elapsedSeconds = 0.0;
+};
+
+/**
+ * Rendu hors ligne d'une collection sur tous les cœurs
+ *
+ * Un OfflineRenderer (sidplayfp + ReSIDfpBuilder) par worker, réutilisé d'un job à l'autre.
+ * Les jobs sont répartis par blocs contigus (les subsongs d'un même fichier restent ensemble)
+ * dans une file par worker ; un worker à court de travail vole la seconde moitié de la file
+ * d'un autre. Chaque rendu est écrit au fil de l'eau dans "<sortie>.part", renommé une fois
+ * complet, puis consigné dans le manifeste : une exécution interrompue reprend là où elle s'est
+ * arrêtée.
+ */
+class BatchRenderer {
+public:
+    // Appelé après chaque job, sérialisé (jamais deux appels simultanés)
+    using ProgressCallback = std::function<void(const BatchRenderProgress& progress, const BatchRenderJob& job,
+                                                const OfflineRenderResult& result, bool ok, const std::string& error)>;
+
+    // Un job par subsong de chaque fichier, sous outputDir/<rootFolder>/<chemin relatif>_<NN>.<ext>
+    static void appendJobs(const RootFolderEntry& root, const fs::path& outputDir, AudioFileFormat format,
+                           std::vector<BatchRenderJob>& jobs);
+
+    // Bloquant ; false si au moins un job a échoué
+    bool run(const std::vector<BatchRenderJob>& jobs, const BatchRenderOptions& options,
+             ProgressCallback callback = nullptr);
+
+    // Demande d'arrêt (les jobs en cours se terminent, les suivants ne démarrent pas)
+    void cancel() { m_cancel = true; }
+
+    // Bilan de la dernière exécution (à lire après run())
+    const BatchRenderProgress& getProgress() const { return m_progress; }
+
+private:
+    // File d'un worker : le propriétaire prend à l'avant, les voleurs à l'arrière
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<size_t> jobs;
+    };
+
+    bool popJob(size_t worker, size_t& job);
+    bool stealJobs(size_t thief);
+    void workerLoop(size_t worker, const std::vector<BatchRenderJob>& jobs, const BatchRenderOptions& options);
+    void recordResult(const BatchRenderJob& job, const OfflineRenderResult& result, bool ok, const std::string& error);
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::atomic<bool> m_cancel{false};
+
+    std::mutex m_progressMutex;      // Protège m_progress, le manifeste et l'appel du callback
+    BatchRenderProgress m_progress;
+    std::ofstream m_manifest;
+    ProgressCallback m_callback;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// Mode ligne de commande "--render-batch" (voir main.cpp) ; retourne le code de sortie du processus
+bool isBatchRenderCommand(int argc, char* argv[]);
+int runBatchRenderCommand(int argc, char* argv[]);
+
+#endif // BATCH_RENDERER_H
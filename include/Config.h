@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <algorithm>
 
 // Classe singleton pour gérer la configuration
 class Config {
@@ -66,6 +67,48 @@ public:
     void setWindowPos(int x, int y) { m_windowX = x; m_windowY = y; }
     void setWindowSize(int w, int h) { m_windowWidth = w; m_windowHeight = h; }
     
+    // Audio : fréquence de sortie et taille du buffer du périphérique (profil de latence)
+    int getAudioSampleRate() const { return m_audioSampleRate; }
+    void setAudioSampleRate(int rate) { m_audioSampleRate = std::max(8000, std::min(192000, rate)); }
+    
+    int getAudioBufferSize() const { return m_audioBufferSize; }
+    void setAudioBufferSize(int samples) { m_audioBufferSize = std::max(64, std::min(8192, samples)); }
+    
+    // Émulation à fréquence fixe (0 = fréquence du périphérique), rééchantillonnée vers la sortie
+    // fastSampling : interpolation simple de reSIDfp au lieu du rééchantillonnage à sinc (moins de CPU)
+    int getEmulationRate() const { return m_emulationRate; }
+    void setEmulationRate(int rate) { m_emulationRate = (rate <= 0) ? 0 : std::max(8000, std::min(192000, rate)); }
+    bool isFastSamplingEnabled() const { return m_fastSampling; }
+    void setFastSamplingEnabled(bool enabled) { m_fastSampling = enabled; }
+    
+    // Sortie audio : "sdl" (périphérique), "null" (sans son, cadencée) ou "file" (audio_output_file)
+    std::string getAudioOutput() const { return m_audioOutput; }
+    void setAudioOutput(const std::string& output) { m_audioOutput = output; }
+    std::string getAudioOutputFile() const { return m_audioOutputFile; }
+    void setAudioOutputFile(const std::string& path) { m_audioOutputFile = path; }
+    
+    // Budget mémoire des snapshots d'émulation (Mo, 0 = désactivés)
+    int getSnapshotMemoryMB() const { return m_snapshotMemoryMB; }
+    void setSnapshotMemoryMB(int megabytes) { m_snapshotMemoryMB = std::max(0, std::min(256, megabytes)); }
+    
+    // Passage au morceau suivant après N secondes de silence (0 = désactivé)
+    int getSilenceSkipSeconds() const { return m_silenceSkipSeconds; }
+    void setSilenceSkipSeconds(int seconds) { m_silenceSkipSeconds = std::max(0, std::min(60, seconds)); }
+    
+    // Normalisation du volume d'après la sonie analysée (EBU R128) et niveau visé (LUFS)
+    bool isLoudnessNormalizationEnabled() const { return m_loudnessNormalization; }
+    void setLoudnessNormalizationEnabled(bool enabled) { m_loudnessNormalization = enabled; }
+    float getLoudnessTargetLufs() const { return m_loudnessTargetLufs; }
+    void setLoudnessTargetLufs(float lufs) { m_loudnessTargetLufs = std::max(-30.0f, std::min(-10.0f, lufs)); }
+    
+    // Durée de la fenêtre des oscilloscopes (ms)
+    float getOscilloscopeWindowMs() const { return m_oscilloscopeWindowMs; }
+    void setOscilloscopeWindowMs(float ms) { m_oscilloscopeWindowMs = std::max(5.0f, std::min(100.0f, ms)); }
+    
+    // Analyseur de spectre affiché sous les oscilloscopes
+    bool isSpectrumVisible() const { return m_spectrumVisible; }
+    void setSpectrumVisible(bool visible) { m_spectrumVisible = visible; }
+    
     // État des voix (Voice 1, 2, 3 actives)
     bool isVoiceActive(int voice) const {
         if (voice >= 0 && voice < 3) return m_voiceActive[voice];
@@ -110,6 +153,18 @@ private:
     int m_windowY = 100;
     int m_windowWidth = 1200;
     int m_windowHeight = 800;
+    int m_audioSampleRate = 44100; // 44100, 48000 ou 96000
+    int m_audioBufferSize = 256;   // 128 (faible latence), 256 (défaut), 4096 (économie d'énergie)
+    int m_emulationRate = 0;
+    bool m_fastSampling = false;
+    std::string m_audioOutput = "sdl";
+    std::string m_audioOutputFile;
+    int m_snapshotMemoryMB = 8;
+    int m_silenceSkipSeconds = 5;
+    bool m_loudnessNormalization = true;
+    float m_loudnessTargetLufs = -18.0f; // Référence ReplayGain 2.0
+    float m_oscilloscopeWindowMs = 20.0f;
+    bool m_spectrumVisible = false;
     bool m_voiceActive[3] = {true, true, true}; // Par défaut toutes actives
     
 #ifdef ENABLE_CLOUD_SAVE
@@ -2,11 +2,14 @@
 #define DATABASE_MANAGER_H
 
 #include "SidMetadata.h"
+#include "DatabaseSnapshot.h"
+#include "IndexingPipeline.h"
 #include "PlaylistManager.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
+#include <atomic>
 #include <filesystem>
 #include <functional>
 #include <glaze/glaze.hpp>
@@ -35,10 +38,11 @@ class DatabaseManager {
 public:
     DatabaseManager();
     
-    // Charger la base de données depuis le fichier JSON
+    // Charger la base de données : instantané binaire (database.bin) s'il est à jour,
+    // sinon import de database.json puis régénération de l'instantané
     bool load();
     
-    // Sauvegarder la base de données dans le fichier JSON
+    // Sauvegarder la base de données (export JSON puis instantané binaire)
     bool save();
     
     // Indexer tous les fichiers SID de la playlist
@@ -48,6 +52,17 @@ public:
     // rootFolder: nom du dossier racine (ex: "HVSCallofthem24"), vide si non spécifié
     bool indexFile(const std::string& filepath, const std::string& rootFolder = "");
     
+    // Indexer à partir de métadonnées déjà extraites (md5Hash renseigné), sans relire le fichier.
+    // Même logique que indexFile ; utilisé par IndexingPipeline depuis le thread de validation
+    bool indexMetadata(const std::string& filepath, const std::string& rootFolder, const SidMetadata& metadata);
+    
+    // Retirer de la base des fichiers disparus du disque (chemins absolus) ; retourne le nombre d'entrées retirées.
+    // Le cache est reconstruit : les pointeurs de getMetadata() sont invalidés
+    size_t removeFiles(const std::vector<std::string>& filepaths);
+    
+    // Taille/date de chaque fichier indexé (chemin absolu), pour écarter les fichiers inchangés sans les lire
+    std::unordered_map<std::string, IndexingPipeline::FileStamp> getFileStamps() const;
+    
     // Vérifier si un fichier est déjà indexé et à jour (par filepath ou metadataHash)
     bool isIndexed(const std::string& filepath) const;
     bool isIndexedByMetadataHash(uint32_t metadataHash) const;
@@ -62,18 +77,27 @@ public:
     // Obtenir tous les metadataHash indexés (pour vérification rapide)
     std::unordered_set<uint32_t> getIndexedMetadataHashes() const;
     
-    // Obtenir toutes les métadonnées (version plate pour compatibilité)
-    std::vector<SidMetadata> getAllMetadata() const;
+    // Obtenir toutes les métadonnées (version plate pour compatibilité, sans copie)
+    const std::vector<SidMetadata>& getAllMetadata() const;
     
     // Obtenir le nombre de fichiers indexés
     size_t getCount() const;
     
+    // Enregistrer la sonie mesurée d'un subsong (index 0-based) ; les pointeurs de getMetadata() restent valides
+    // Persisté au prochain save() ; false si le fichier n'est pas indexé
+    bool setLoudness(const std::string& filepath, int subsongIndex, float lufs);
+    
+    // Structure hiérarchique brute (chemins relatifs à rootPath), pour les traitements par dossier racine
+    const std::vector<RootFolderEntry>& getRootFolders() const { ensureRootFolders(); return m_rootFolders; }
+    
     // Supprimer la base de données (en mémoire et sur disque)
     bool clear();
     
 private:
     // Structure hiérarchique : groupement par rootFolder
-    std::vector<RootFolderEntry> m_rootFolders;
+    // (décodée à la demande depuis l'instantané binaire, voir ensureRootFolders)
+    mutable std::vector<RootFolderEntry> m_rootFolders;
+    mutable bool m_rootFoldersPending;
     
     // Cache pour accès rapide (reconstruit après load/save)
     mutable std::vector<SidMetadata> m_metadataCache; // Cache des métadonnées avec chemins absolus
@@ -82,12 +106,40 @@ private:
     mutable std::unordered_map<std::string, size_t> m_filepathIndex; // Index rapide par filepath (absolu)
     mutable std::unordered_map<uint32_t, size_t> m_hashIndex;       // Index rapide par metadataHash (clé primaire, 32-bit)
     std::string m_databasePath;
+    std::string m_snapshotPath;
+    
+    // Instantané projeté : ses index prébâtis remplacent m_filepathIndex / m_hashIndex
+    // tant que la base n'est pas modifiée (voir detachSnapshot)
+    mutable DatabaseSnapshot m_snapshot;
+    mutable std::atomic<bool> m_useSnapshotIndexes;
+    
+    // Charger depuis l'instantané binaire s'il est valide et correspond à database.json
+    bool loadSnapshot();
+    
+    // Écrire l'instantané de la structure persistée (chemins relatifs), estampillé avec database.json
+    void writeSnapshot(const std::vector<RootFolderEntry>& structure) const;
+    
+    // Décoder m_rootFolders depuis l'instantané si le chargement l'a différé (seul le cache sert au démarrage)
+    void ensureRootFolders() const;
+    
+    // Basculer des index projetés vers les index en mémoire (avant toute modification).
+    // La projection reste en place jusqu'au prochain load/save/clear : un lecteur concurrent
+    // qui vient de consulter l'ancien index ne lit jamais une zone démappée
+    void detachSnapshot() const;
+    
+    // Recherches dans l'index actif ; -1 si absent
+    int64_t findFilepathIndex(const std::string& filepath) const;
+    int64_t findHashIndex(uint32_t metadataHash) const;
+    
+    // indexFile / indexMetadata : prepared == nullptr pour extraire et hacher le fichier ici
+    bool applyIndexing(const std::string& filepath, const std::string& rootFolder, const SidMetadata* prepared);
     
     // Reconstruire le cache et les index
     void rebuildCacheAndIndexes() const;
     
-    // Extraire les métadonnées d'un fichier SID sans le jouer
-    SidMetadata extractMetadata(const std::string& filepath);
+    // Extraire les métadonnées et le MD5 d'un fichier SID sans le jouer, depuis une seule lecture
+    // (lastModified : date du statFile qui a précédé)
+    SidMetadata extractMetadata(const std::string& filepath, int64_t lastModified);
     
     // Récupérer les songlengths depuis SongLengthDB et les ajouter aux métadonnées
     void populateSongLengths(SidMetadata& metadata) const;
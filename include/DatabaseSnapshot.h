@@ -0,0 +1,84 @@
+#ifndef DATABASE_SNAPSHOT_H
+#define DATABASE_SNAPSHOT_H
+
+#include "SidMetadata.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct RootFolderEntry;
+
+/**
+ * Instantané binaire de la base (database.bin), projeté en mémoire et lu sur place
+ *
+ * Disposition (ordre natif de la machine, sections alignées sur 8 octets) :
+ *   - en-tête versionné (magic, marqueur d'endianness, taille, estampille du JSON écrit en même temps)
+ *   - dossiers racines puis enregistrements de taille fixe, dans l'ordre du cache de DatabaseManager
+ *   - table de chaînes (références offset/longueur, chaînes courtes dédupliquées)
+ *   - pools partagés : références des infoStrings, durées (double), sonies (float)
+ *   - index prébâtis à adressage ouvert : chemin absolu -> enregistrement, metadataHash -> enregistrement
+ * Les recherches se font directement dans la projection, sans table de hachage à reconstruire.
+ * Tout fichier incohérent (version, taille, références hors bornes) est refusé : l'appelant
+ * revient alors au JSON, qui reste le format d'import/export.
+ */
+class DatabaseSnapshot {
+public:
+    static const uint32_t VERSION = 1;
+
+    DatabaseSnapshot() = default;
+    ~DatabaseSnapshot();
+    DatabaseSnapshot(const DatabaseSnapshot&) = delete;
+    DatabaseSnapshot& operator=(const DatabaseSnapshot&) = delete;
+
+    // Écrire l'instantané (fichier temporaire puis renommage) depuis la structure persistée
+    // (chemins relatifs à rootPath). jsonSize/jsonMtime : estampille du database.json correspondant
+    static bool write(const std::string& path, const std::vector<RootFolderEntry>& roots,
+                      int64_t jsonSize, int64_t jsonMtime, std::string& error);
+
+    // Projeter le fichier en mémoire et valider l'en-tête et les sections
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+    const std::string& getLastError() const { return m_lastError; }
+
+    uint32_t getRootCount() const;
+    uint32_t getRecordCount() const;
+    int64_t getJsonSize() const;
+    int64_t getJsonMtime() const;
+
+    // Décoder le cache à chemins absolus (ordre des enregistrements, rootFolder restauré)
+    // et la structure persistée (chemins relatifs) ; false si une référence sort du fichier
+    bool materializeCache(std::vector<SidMetadata>& cache) const;
+    bool materializeRoots(std::vector<RootFolderEntry>& roots) const;
+
+    // Index prébâtis : indice d'enregistrement (= indice dans le cache), -1 si absent
+    int64_t findPath(std::string_view absolutePath) const;
+    int64_t findHash(uint32_t metadataHash) const;
+    std::vector<uint32_t> getMetadataHashes() const;
+
+    static uint64_t hashPath(std::string_view path);
+
+private:
+    template <typename T> const T* section(uint64_t offset) const {
+        return reinterpret_cast<const T*>(m_data + offset);
+    }
+    bool validate();
+    bool decodeRecord(uint32_t index, bool absolutePath, SidMetadata& meta) const;
+    bool readString(uint32_t offset, uint32_t length, std::string& out) const;
+    std::string_view stringAt(uint32_t offset, uint32_t length) const;
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    std::vector<uint8_t> m_fallback;   // Copie lue si la projection mémoire est indisponible
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#else
+    bool m_mapped = false;
+#endif
+    std::string m_lastError;
+};
+
+#endif // DATABASE_SNAPSHOT_H
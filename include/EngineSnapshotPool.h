@@ -0,0 +1,68 @@
+#ifndef ENGINE_SNAPSHOT_POOL_H
+#define ENGINE_SNAPSHOT_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <sidplayfp/sidplayfp.h>
+#include <sidplayfp/builders/residfp.h>
+
+// Point de reprise d'un morceau : libsidplayfp n'expose pas de sauvegarde/restauration de l'état
+// C64/SID, le "snapshot" est donc un moteur complet (avec son builder) garé à une position connue.
+// Le reprendre revient à l'échanger avec le moteur master, sans réémuler depuis le début.
+struct EngineSnapshot {
+    std::unique_ptr<sidplayfp> engine;
+    std::unique_ptr<ReSIDfpBuilder> builder;
+    int song = -1;            // Subsong (0-based) chargé dans le moteur
+    int64_t samplePos = 0;    // Position en échantillons depuis le début du subsong (après préchauffage)
+    uint64_t lastUse = 0;     // Ordre LRU pour l'éviction
+};
+
+// Pool borné de snapshots pour le morceau chargé (vidé à chaque changement de fichier)
+// Thread-safe : utilisé par le thread UI, le thread de seek et le thread de capture
+class EngineSnapshotPool {
+public:
+    // Empreinte estimée d'un moteur garé (RAM C64, puces émulées, buffers reSIDfp)
+    static const size_t ESTIMATED_SNAPSHOT_BYTES = 1024 * 1024;
+
+    EngineSnapshotPool();
+
+    // Budget mémoire : le nombre de places en découle (0 désactive les snapshots)
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const { return m_memoryBudget; }
+    size_t getCapacity() const { return m_memoryBudget / ESTIMATED_SNAPSHOT_BYTES; }
+    size_t size() const;
+    bool hasFreeSlot() const;
+    bool contains(int song, int64_t samplePos) const;
+
+    // Retire du pool le snapshot du subsong le plus avancé dans [minPos, maxPos]
+    // Compte un succès ou un échec pour le taux de réussite
+    bool take(int song, int64_t minPos, int64_t maxPos, EngineSnapshot& out);
+
+    // Gare un moteur (le moins récemment utilisé est évincé si le pool est plein)
+    // Retourne false (moteur détruit) si le budget ne permet aucun snapshot
+    bool park(EngineSnapshot&& snapshot);
+
+    // Détruire tous les snapshots (nouveau fichier : les moteurs référencent l'ancien SidTune)
+    void clear();
+
+    // Métriques
+    uint64_t getHits() const { return m_hits.load(std::memory_order_relaxed); }
+    uint64_t getMisses() const { return m_misses.load(std::memory_order_relaxed); }
+    float getHitRate() const;
+
+private:
+    void evictToCapacity(size_t capacity); // Appelé avec m_mutex verrouillé
+
+    mutable std::mutex m_mutex;
+    std::vector<EngineSnapshot> m_snapshots;
+    size_t m_memoryBudget;
+    uint64_t m_useCounter;
+    std::atomic<uint64_t> m_hits;
+    std::atomic<uint64_t> m_misses;
+};
+
+#endif // ENGINE_SNAPSHOT_POOL_H
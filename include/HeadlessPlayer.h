@@ -0,0 +1,12 @@
+#ifndef HEADLESS_PLAYER_H
+#define HEADLESS_PLAYER_H
+
+// Lecture temps réel sans fenêtre ni carte son : SidPlayer complet (thread de rendu, ring buffer,
+// enchaînements sans blanc) sur une sortie null ou fichier, suivie d'un bilan des temps audio.
+// Sert aux tests de non-régression en CI et à comparer le coût des réglages sur une machine donnée.
+
+// Mode ligne de commande "--play" (voir main.cpp) ; retourne le code de sortie du processus
+bool isHeadlessPlayCommand(int argc, char* argv[]);
+int runHeadlessPlayCommand(int argc, char* argv[]);
+
+#endif // HEADLESS_PLAYER_H
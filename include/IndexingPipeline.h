@@ -0,0 +1,194 @@
+#ifndef INDEXING_PIPELINE_H
+#define INDEXING_PIPELINE_H
+
+#include "SidMetadata.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// File bornée multi-producteurs / multi-consommateurs : push() bloque quand elle est pleine,
+// close() réveille tout le monde (push refusé, pop vide la file puis échoue)
+template <typename T>
+class BoundedQueue {
+public:
+    enum class PopStatus { Item, Timeout, Closed };
+
+    explicit BoundedQueue(size_t capacity) : m_capacity(capacity > 0 ? capacity : 1) {}
+
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [this] { return m_closed || m_items.size() < m_capacity; });
+        if (m_closed) return false;
+        m_items.push_back(std::move(item));
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this] { return m_closed || !m_items.empty(); });
+        return takeFront(item);
+    }
+
+    PopStatus popFor(T& item, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_notEmpty.wait_for(lock, timeout, [this] { return m_closed || !m_items.empty(); })) {
+            return PopStatus::Timeout;
+        }
+        return takeFront(item) ? PopStatus::Item : PopStatus::Closed;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_notFull.notify_all();
+        m_notEmpty.notify_all();
+    }
+
+    // Fermer et jeter le contenu (annulation)
+    void abort() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+            m_items.clear();
+        }
+        m_notFull.notify_all();
+        m_notEmpty.notify_all();
+    }
+
+private:
+    bool takeFront(T& item) {
+        if (m_items.empty()) return false;
+        item = std::move(m_items.front());
+        m_items.pop_front();
+        m_notFull.notify_one();
+        return true;
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_notFull;
+    std::condition_variable m_notEmpty;
+    std::deque<T> m_items;
+    size_t m_capacity;
+    bool m_closed = false;
+};
+
+/**
+ * Indexation parallèle en pipeline
+ *
+ *   parcours (1 thread) -> file bornée -> N workers -> file bornée -> validation (thread appelant)
+ *
+ * Le parcours écarte les fichiers absents et ceux déjà indexés et inchangés (taille/date connues,
+ * voir setKnownFiles) sans les lire. Chaque worker lit un fichier une seule fois en mémoire puis en
+ * tire les métadonnées et le MD5 depuis le même tampon. Seul le thread qui appelle run() reçoit les
+ * résultats (commit) : DatabaseManager n'est jamais modifié depuis plusieurs threads.
+ * Les files bornées limitent la mémoire (fichiers lus d'avance) et propagent la contre-pression.
+ */
+class IndexingPipeline {
+public:
+    enum Stage { STAGE_WALK, STAGE_READ, STAGE_PARSE, STAGE_HASH, STAGE_COMMIT, STAGE_COUNT };
+
+    struct FileStamp {
+        int64_t fileSize = 0;
+        int64_t lastModified = 0;   // Unité de SidMetadata::statFile
+    };
+
+    struct Job {
+        std::string filepath;
+        std::string rootFolder;
+        FileStamp stamp;            // Relevé par le parcours (un seul stat), reporté dans les métadonnées
+    };
+
+    struct Result {
+        Job job;
+        SidMetadata metadata;   // Chemin absolu, md5Hash renseigné
+    };
+
+    struct StageStats {
+        uint64_t items = 0;
+        uint64_t bytes = 0;
+        uint64_t busyNs = 0;    // Somme sur les threads de l'étape
+    };
+
+    struct Stats {
+        StageStats stages[STAGE_COUNT];
+        uint64_t skipped = 0;   // Déjà indexés et inchangés
+        uint64_t missing = 0;
+        uint64_t failed = 0;    // Illisibles ou tunes invalides
+        uint64_t committed = 0; // Acceptés par la validation
+        int workers = 0;
+        double wallSeconds = 0.0;
+        bool cancelled = false;
+    };
+
+    // Commit : thread appelant de run() uniquement ; true si la base a été modifiée
+    using CommitFn = std::function<bool(Result& result)>;
+    // Progression : fichiers traités (écartés compris) sur le total, appelée au moins toutes les ~100 ms
+    using ProgressFn = std::function<void(const std::string& filepath, size_t done, size_t total)>;
+    // Analyse du contenu lu (défaut : SidMetadata::fromFileData), appelée depuis les workers ; le MD5 est
+    // calculé ensuite par le pipeline sur le même tampon
+    using ExtractFn = std::function<bool(const std::string& filepath, const uint8_t* data, size_t size, SidMetadata& metadata)>;
+
+    static const size_t DEFAULT_QUEUE_CAPACITY = 256;
+    static const int MAX_WORKERS = 32;
+    static const size_t MAX_FILE_BYTES = 4 * 1024 * 1024; // Bien au-delà d'un .sid (64 Ko de données)
+
+    // workers <= 0 : un par cœur (au moins 2, les lectures bloquent sur disque ou réseau)
+    explicit IndexingPipeline(int workers = 0, size_t queueCapacity = DEFAULT_QUEUE_CAPACITY);
+
+    // Fichiers déjà indexés (chemin absolu -> taille/date) : écartés par le parcours s'ils n'ont pas changé
+    void setKnownFiles(std::unordered_map<std::string, FileStamp> known) { m_known = std::move(known); }
+    void setExtractor(ExtractFn extract) { m_extract = std::move(extract); }
+
+    // Bloquant ; retourne le nombre de commits ayant modifié la base
+    size_t run(const std::vector<Job>& jobs, const CommitFn& commit, const ProgressFn& progress = nullptr);
+
+    // Depuis n'importe quel thread (y compris les callbacks) : run() retourne au plus vite
+    void cancel();
+    bool isCancelled() const { return m_cancelled.load(); }
+
+    Stats getStats() const;
+    static const char* stageName(int stage);
+    // Résumé lisible : débit par étape (éléments/s et Mo/s sur le temps occupé) et totaux
+    static std::string formatStats(const Stats& stats);
+
+private:
+    struct StageCounters {
+        std::atomic<uint64_t> items{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> busyNs{0};
+    };
+
+    void walk(const std::vector<Job>& jobs);
+    void work();
+    void count(Stage stage, std::chrono::steady_clock::time_point start, uint64_t bytes = 0);
+
+    int m_workerCount;
+    size_t m_queueCapacity;
+    std::unordered_map<std::string, FileStamp> m_known;
+    ExtractFn m_extract;
+
+    BoundedQueue<Job>* m_jobs = nullptr;
+    BoundedQueue<Result>* m_results = nullptr;
+    std::mutex m_queuesMutex;              // Protège les pointeurs de files pour cancel()
+    std::atomic<int> m_activeWorkers{0};
+    std::atomic<bool> m_cancelled{false};
+
+    StageCounters m_stages[STAGE_COUNT];
+    std::atomic<uint64_t> m_skipped{0};
+    std::atomic<uint64_t> m_missing{0};
+    std::atomic<uint64_t> m_failed{0};
+    std::atomic<uint64_t> m_committed{0};
+    std::atomic<uint64_t> m_wallNs{0};
+};
+
+#endif // INDEXING_PIPELINE_H
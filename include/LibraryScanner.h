@@ -0,0 +1,83 @@
+#ifndef LIBRARY_SCANNER_H
+#define LIBRARY_SCANNER_H
+
+#include "IndexingPipeline.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Rescan incrémental des dossiers racines de la base
+ *
+ * Un journal (scan_journal.bin) garde, pour chaque dossier parcouru, sa date de modification et
+ * son contenu (sous-dossiers, fichiers .sid avec inode/taille/date). Au scan suivant :
+ *   - un dossier dont la date n'a pas bougé n'est pas relu (aucun ajout/suppression/renommage dedans),
+ *     sa liste vient du journal ;
+ *   - chaque fichier est comparé au journal par un seul stat (une modification sur place ne change
+ *     pas la date du dossier) ;
+ *   - seuls les fichiers ajoutés, modifiés ou supprimés sont rendus à l'appelant.
+ * Le journal est un cache : absent, d'une autre version ou incohérent, il est ignoré et tout est relu.
+ */
+class LibraryScanner {
+public:
+    static const uint32_t VERSION = 1;
+
+    struct Root {
+        std::string rootPath;       // Chemin absolu du dossier déposé
+        std::string rootFolder;
+    };
+
+    struct Changes {
+        std::vector<IndexingPipeline::Job> changed; // Ajoutés et modifiés (à indexer)
+        std::vector<std::string> removed;           // Disparus du disque (à retirer de la base)
+        size_t added = 0;
+        size_t modified = 0;
+        size_t unchanged = 0;
+        size_t directories = 0;
+        size_t directoriesListed = 0;               // Relus sur disque (nouveaux ou date changée)
+        double seconds = 0.0;
+        bool cancelled = false;
+    };
+
+    using KnownFiles = std::unordered_map<std::string, IndexingPipeline::FileStamp>;
+
+    // false si le journal est absent ou refusé (getLastError) : le prochain scan relit tout
+    bool load(const std::string& path);
+    // Fichier temporaire puis renommage, comme l'instantané de la base
+    bool save(const std::string& path) const;
+    void clear() { m_dirs.clear(); }
+    const std::string& getLastError() const { return m_lastError; }
+
+    // Parcourir les racines et mettre le journal à jour. known : fichiers présents dans la base ;
+    // un fichier inchangé selon le journal mais absent de la base est rendu comme ajouté.
+    // Annulé (stop) : le journal n'est pas modifié
+    Changes scan(const std::vector<Root>& roots, const KnownFiles& known, const std::atomic<bool>* stop = nullptr);
+
+    size_t getDirectoryCount() const { return m_dirs.size(); }
+
+private:
+    struct FileEntry {
+        std::string name;
+        uint64_t inode = 0;
+        int64_t size = 0;
+        int64_t mtimeNs = 0;
+    };
+
+    struct DirEntry {
+        int64_t mtimeNs = 0;
+        std::vector<std::string> subdirs;
+        std::vector<FileEntry> files;
+    };
+
+    using DirMap = std::unordered_map<std::string, DirEntry>;
+
+    // Fichiers d'un sous-arbre du journal, tous rendus comme supprimés
+    void collectRemoved(const std::string& dir, Changes& changes) const;
+
+    DirMap m_dirs;                  // Chemin absolu du dossier -> contenu au dernier scan
+    std::string m_lastError;
+};
+
+#endif // LIBRARY_SCANNER_H
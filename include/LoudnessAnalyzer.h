@@ -0,0 +1,73 @@
+#ifndef LOUDNESS_ANALYZER_H
+#define LOUDNESS_ANALYZER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Analyse de sonie (EBU R128) en arrière-plan, pour la normalisation du volume
+ *
+ * Un seul worker à basse priorité (cœurs inoccupés uniquement : la lecture garde la main)
+ * rend chaque subsong hors ligne, sans fichier de sortie (OfflineRenderer + LoudnessMeter),
+ * sur sa durée Songlengths.md5 bornée à MAX_ANALYSIS_S. Les résultats sont récupérés par le
+ * thread principal (takeResults) et enregistrés dans SidMetadata::loudness par DatabaseManager.
+ */
+class LoudnessAnalyzer {
+public:
+    struct Result {
+        std::string filepath;
+        std::vector<float> loudness;   // LUFS par subsong
+    };
+
+    static LoudnessAnalyzer& getInstance();
+
+    // Mettre un tune en file (tous ses subsongs) ; sans effet s'il est déjà en file ou déjà analysé
+    void request(const std::string& filepath, const std::string& md5Hash, int numberOfSongs);
+
+    // Résultats terminés depuis l'appel précédent (thread principal)
+    std::vector<Result> takeResults();
+
+    // Arrêter le worker (interrompt l'analyse en cours)
+    void shutdown();
+
+    size_t getPendingCount() const;
+    uint64_t getAnalyzedCount() const { return m_analyzedCount.load(std::memory_order_relaxed); }
+
+    static const int ANALYSIS_SAMPLE_RATE = 32000;  // Au-delà de la bande utile du SID pour la pondération K
+    static constexpr double MAX_ANALYSIS_S = 180.0;
+    static constexpr double DEFAULT_ANALYSIS_S = 120.0; // Tune absent de Songlengths.md5
+
+private:
+    LoudnessAnalyzer() = default;
+    ~LoudnessAnalyzer();
+    LoudnessAnalyzer(const LoudnessAnalyzer&) = delete;
+    LoudnessAnalyzer& operator=(const LoudnessAnalyzer&) = delete;
+
+    struct Job {
+        std::string filepath;
+        std::string md5Hash;
+        int numberOfSongs = 1;
+    };
+
+    void workerLoop();
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Job> m_queue;
+    std::unordered_set<std::string> m_known;   // Fichiers demandés pendant la session
+    std::vector<Result> m_results;
+    std::thread m_worker;
+    bool m_running = false;
+    size_t m_activeJobs = 0;
+    std::atomic<bool> m_stopping{false};
+    std::atomic<uint64_t> m_analyzedCount{0};
+};
+
+#endif // LOUDNESS_ANALYZER_H
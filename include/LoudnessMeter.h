@@ -0,0 +1,53 @@
+#ifndef LOUDNESS_METER_H
+#define LOUDNESS_METER_H
+
+#include <cstdint>
+#include <vector>
+
+namespace imsid {
+namespace audio {
+
+/**
+ * Sonie intégrée EBU R128 / ITU-R BS.1770 d'un signal mono int16
+ *
+ * Pondération K (shelf haute fréquence + passe-haut RLB, coefficients recalculés pour la
+ * fréquence d'échantillonnage), énergie par segments de 100 ms, blocs de 400 ms à 75 %
+ * de recouvrement, porte absolue à -70 LUFS puis porte relative à -10 LU.
+ * Conversion int16 -> float par les kernels vectorisés ; la somme des carrés de chaque tranche
+ * filtrée est une réduction vectorisée. Les filtres IIR restent séquentiels (récursifs).
+ * Mémoire : un double par 100 ms de signal analysé.
+ */
+class LoudnessMeter {
+public:
+    static constexpr double SILENCE_LUFS = -70.0; // Résultat quand aucun bloc ne passe la porte absolue
+
+    explicit LoudnessMeter(int sampleRate);
+
+    void reset();
+    void process(const int16_t* samples, int count);
+
+    // Sonie intégrée sur tout ce qui a été traité (LUFS)
+    double getIntegratedLufs() const;
+
+private:
+    struct Biquad {
+        double b0, b1, b2, a1, a2;
+        double z1 = 0.0, z2 = 0.0;   // Forme directe II transposée
+    };
+
+    static const int CHUNK = 1024;
+
+    Biquad m_shelf;
+    Biquad m_highPass;
+    int m_segmentLength;               // Échantillons par segment de 100 ms
+    int m_segmentFill;
+    double m_segmentSum;
+    std::vector<double> m_segments;    // Énergie moyenne pondérée K de chaque segment
+    float m_input[CHUNK];
+    float m_filtered[CHUNK];
+};
+
+} // namespace audio
+} // namespace imsid
+
+#endif // LOUDNESS_METER_H
@@ -0,0 +1,60 @@
+#ifndef OFFLINE_RENDERER_H
+#define OFFLINE_RENDERER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <sidplayfp/sidplayfp.h>
+#include <sidplayfp/SidTune.h>
+#include <sidplayfp/builders/residfp.h>
+
+struct OfflineRenderOptions {
+    std::string inputPath;
+    std::string outputPath;          // Format déduit de l'extension (.wav ou .flac) ; vide = analyse seule
+    int song = 0;                    // Subsong 1-based, 0 = subsong par défaut du tune
+    double durationSeconds = 0.0;    // <= 0 : durée Songlengths.md5, sinon DEFAULT_DURATION_S
+    int sampleRate = 44100;
+    bool measureLoudness = true;     // Sonie intégrée EBU R128 du rendu (OfflineRenderResult::loudnessLufs)
+    const std::atomic<bool>* cancel = nullptr; // Interruption entre deux blocs (render() retourne false)
+};
+
+struct OfflineRenderResult {
+    int song = 0;                    // Subsong effectivement rendu (1-based)
+    uint64_t samples = 0;
+    double audioSeconds = 0.0;
+    double wallSeconds = 0.0;
+    double realtimeFactor = 0.0;     // Durée audio / temps de calcul
+    bool durationFromDatabase = false;
+    double loudnessLufs = 0.0;       // 0 si non mesurée
+};
+
+/**
+ * Rendu hors ligne d'un tune vers un fichier, sans SDL ni périphérique audio
+ *
+ * Même configuration d'émulation que le master de SidPlayer (ReSIDfp filtré, mono, modèle SID
+ * du tune forcé), mais l'émulation tourne aussi vite que le CPU le permet. Le moteur est réutilisé
+ * d'un rendu à l'autre : une instance par thread pour rendre plusieurs tunes en parallèle.
+ */
+class OfflineRenderer {
+public:
+    static constexpr double DEFAULT_DURATION_S = 180.0; // Tune absent de Songlengths.md5
+
+    OfflineRenderer();
+
+    bool render(const OfflineRenderOptions& options, OfflineRenderResult& result);
+    const std::string& getLastError() const { return m_lastError; }
+
+private:
+    static const int RENDER_CHUNK_SAMPLES = 8192;
+
+    std::unique_ptr<sidplayfp> m_engine;
+    std::unique_ptr<ReSIDfpBuilder> m_builder;
+    std::string m_lastError;
+};
+
+// Mode ligne de commande "--render" (voir main.cpp) ; retourne le code de sortie du processus
+bool isOfflineRenderCommand(int argc, char* argv[]);
+int runOfflineRenderCommand(int argc, char* argv[]);
+
+#endif // OFFLINE_RENDERER_H
@@ -0,0 +1,68 @@
+#ifndef POLYPHASE_RESAMPLER_H
+#define POLYPHASE_RESAMPLER_H
+
+#include <cstdint>
+#include <vector>
+
+namespace imsid {
+namespace audio {
+
+/**
+ * Rééchantillonneur polyphase int16 entrelacé (flux continu, 1 à 2 canaux)
+ *
+ * Rapport rationnel L/M réduit par le PGCD des fréquences ; filtre passe-bas sinc fenêtré
+ * (Kaiser) décomposé en phases, normalisées à un gain unitaire en continu. Au-delà de
+ * MAX_PHASES phases (rapports exotiques), la phase est quantifiée sur MAX_PHASES positions.
+ * En sous-échantillonnage, la coupure suit la nouvelle fréquence de Nyquist et le filtre
+ * s'allonge d'autant (MAX_TAPS au plus). Chaque échantillon de sortie est un produit
+ * scalaire vectorisé (dotProduct) sur un historique planaire par canal.
+ * Mémoire allouée dans configure() uniquement : process() n'alloue jamais.
+ */
+class PolyphaseResampler {
+public:
+    static const int MAX_CHANNELS = 2;
+    static const int MAX_PHASES = 1024;
+    static const int BASE_TAPS = 64;       // Taps par phase sans sous-échantillonnage
+    static const int MAX_TAPS = 256;
+
+    PolyphaseResampler();
+
+    // Reconfigure et vide l'historique ; fréquences égales = recopie directe
+    void configure(int inputRate, int outputRate, int channels);
+    void reset();
+
+    bool isPassthrough() const { return m_passthrough; }
+    int getInputRate() const { return m_inputRate; }
+    int getOutputRate() const { return m_outputRate; }
+    int getTapsPerPhase() const { return m_taps; }
+
+    // Borne supérieure du nombre de trames produites par process() pour inputFrames trames
+    int maxOutputFrames(int inputFrames) const;
+
+    // Consomme toutes les trames d'entrée ; retourne le nombre de trames écrites dans out
+    int process(const int16_t* in, int inputFrames, int16_t* out);
+
+private:
+    static const int BLOCK = 512;          // Trames d'entrée ajoutées à l'historique par passe
+
+    void buildFilter();
+
+    int m_inputRate;
+    int m_outputRate;
+    int m_channels;
+    bool m_passthrough;
+    int m_up;            // L
+    int m_down;          // M
+    int m_phases;        // min(L, MAX_PHASES)
+    int m_taps;
+    std::vector<float> m_coefficients;     // m_phases x m_taps
+    std::vector<float> m_history[MAX_CHANNELS]; // m_taps + BLOCK trames par canal
+    int m_fill;          // Trames valides dans l'historique
+    int m_index;         // Début de la fenêtre du prochain échantillon de sortie
+    int m_phase;         // Position fractionnaire, en 1/L de trame d'entrée
+};
+
+} // namespace audio
+} // namespace imsid
+
+#endif // POLYPHASE_RESAMPLER_H
@@ -0,0 +1,55 @@
+#ifndef REAL_FFT_H
+#define REAL_FFT_H
+
+#include <vector>
+
+namespace imsid {
+namespace audio {
+
+/**
+ * FFT réelle de taille fixe (puissance de 2)
+ *
+ * Les N échantillons réels sont empaquetés en N/2 complexes, transformés par une FFT
+ * complexe radix-2 itérative, puis séparés en spectre réel. Données en SoA (parties réelles
+ * et imaginaires dans des tableaux distincts) et twiddles contigus par étage : la boucle
+ * interne des papillons est à pas unitaire et vectorisée par le compilateur.
+ * Les twiddles et buffers de travail sont alloués à la construction : aucune allocation ensuite.
+ */
+class RealFft {
+public:
+    explicit RealFft(int size);
+
+    int size() const { return m_size; }
+
+    /**
+     * Spectre de puissance |X[k]|^2 pour k = 0..N/2 (N/2 + 1 valeurs)
+     * @param input N échantillons réels
+     * @param power sortie, N/2 + 1 valeurs
+     */
+    void powerSpectrum(const float* input, float* power);
+
+    /**
+     * Spectre complexe X[k] pour k = 0..N/2 (N/2 + 1 valeurs)
+     */
+    void forward(const float* input, float* outRe, float* outIm);
+
+private:
+    void complexFft(); // FFT complexe en place sur m_re/m_im (taille N/2)
+
+    int m_size;
+    int m_half;
+    std::vector<int> m_bitReverse;      // Permutation d'entrée (taille N/2)
+    std::vector<float> m_stageCos;      // Twiddles par étage : l'étage de demi-taille h occupe [h-1, 2h-1)
+    std::vector<float> m_stageSin;
+    std::vector<float> m_splitCos;      // exp(-2*pi*i*k/N) pour la séparation réelle (k = 0..N/2)
+    std::vector<float> m_splitSin;
+    std::vector<float> m_re;
+    std::vector<float> m_im;
+    std::vector<float> m_specRe;        // Sortie intermédiaire de powerSpectrum()
+    std::vector<float> m_specIm;
+};
+
+} // namespace audio
+} // namespace imsid
+
+#endif // REAL_FFT_H
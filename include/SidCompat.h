@@ -0,0 +1,13 @@
+#ifndef SID_COMPAT_H
+#define SID_COMPAT_H
+
+#include <sidplayfp/sidversion.h>
+
+// sidplayfp::getSidStatus() (lecture des registres) est disponible depuis libsidplayfp 2.2
+#if LIBSIDPLAYFP_VERSION_MAJ > 2 || (LIBSIDPLAYFP_VERSION_MAJ == 2 && LIBSIDPLAYFP_VERSION_MIN >= 2)
+#define HAS_SID_STATUS 1
+#else
+#define HAS_SID_STATUS 0
+#endif
+
+#endif // SID_COMPAT_H
@@ -30,6 +30,7 @@ struct SidMetadata {
     uint16_t hvscNum;               // Numéro de version HVSC (ex: 84)
     std::string rootFolder;         // Dossier racine (nom du dossier déposé, ex: "HVSCallofthem24")
     std::vector<double> songLengths; // Durées des subsongs en secondes (depuis Songlengths.md5)
+    std::vector<float> loudness;    // Sonie intégrée EBU R128 par subsong (LUFS, 0 = non analysé)
     
     // Constructeur par défaut
     SidMetadata() : numberOfSongs(0), defaultSong(1), clockSpeed(0), metadataHash(0), fileSize(0), lastModified(0), hvscNum(0) {}
@@ -37,8 +38,31 @@ struct SidMetadata {
     // Extraire les métadonnées depuis un SidTune
     static SidMetadata fromSidTune(const std::string& filepath, SidTune* tune);
     
+    // Extraire les métadonnées depuis le contenu déjà lu du fichier (constructeur mémoire de SidTune) ;
+    // le même tampon sert ensuite au MD5 (calculateDataMD5). false si ce n'est pas un tune valide.
+    // fileSize = size ; lastModified n'est pas lu ici : l'appelant reporte celui du statFile qui a précédé la lecture
+    static bool fromFileData(const std::string& filepath, const uint8_t* data, size_t size, SidMetadata& metadata);
+    
+    // Taille et date de modification d'un fichier régulier en un seul appel système ;
+    // lastModified dans l'unité stockée en base (secondes depuis l'époque de fs::file_time_type)
+    static bool statFile(const std::string& filepath, int64_t& fileSize, int64_t& lastModified);
+    
     // Vérifier si le fichier a changé depuis l'indexation
     bool isFileChanged() const;
+    // Même test avec une taille/date déjà obtenues (statFile), sans nouvel accès disque
+    bool isFileChanged(int64_t currentSize, int64_t currentModified) const {
+        return currentSize != fileSize || currentModified != lastModified;
+    }
+    
+    // Sonie connue pour chaque subsong (0 = non analysé) ; sinon le tune est à confier à LoudnessAnalyzer
+    bool isLoudnessAnalyzed() const {
+        size_t songs = numberOfSongs > 1 ? static_cast<size_t>(numberOfSongs) : 1;
+        if (loudness.size() < songs) return false;
+        for (size_t i = 0; i < songs; ++i) {
+            if (loudness[i] == 0.0f) return false;
+        }
+        return true;
+    }
     
     // Générer un hash 32-bit basé sur les métadonnées (title+author+released+sidModel+clockSpeed)
     // SANS le path pour la compatibilité avec les ratings existants
@@ -68,7 +92,8 @@ struct glz::meta<SidMetadata> {
         "lastModified", &T::lastModified,
         "hvscNum", &T::hvscNum,
         "rootFolder", &T::rootFolder,
-        "songLengths", &T::songLengths
+        "songLengths", &T::songLengths,
+        "loudness", &T::loudness
     );
 };
 
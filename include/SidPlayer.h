@@ -1,16 +1,41 @@
 #ifndef SIDPLAYER_H
 #define SIDPLAYER_H
 
+#include <algorithm>
 #include <string>
 #include <memory>
 #include <atomic>
 #include <thread>
 #include <chrono>
+#include <mutex>
+#include <cstdint>
+#include <vector>
 #include <sidplayfp/sidplayfp.h>
 #include <sidplayfp/SidTune.h>
 #include <sidplayfp/SidConfig.h>
 #include <sidplayfp/builders/residfp.h>
 #include <SDL2/SDL.h>
+#include "AudioRingBuffer.h"
+#include "VoiceTap.h"
+#include "EngineSnapshotPool.h"
+#include "TripleBuffer.h"
+#include "SpectrumAnalyzer.h"
+#include "PolyphaseResampler.h"
+#include "AudioTimingStats.h"
+#include "AudioSink.h"
+
+// Profils de latence : taille du buffer demandée au périphérique audio (en échantillons)
+enum class LatencyProfile {
+    LowLatency = 128,
+    Default = 256,
+    PowerSaving = 4096
+};
+
+// Source des signaux par voix alimentant les oscilloscopes
+enum class VoiceCaptureMode {
+    SingleEngine,   // Moteur master seul + voix reconstruites depuis les registres SID (1 émulation)
+    MultiEngine     // 3 moteurs d'analyse + master (référence, ~4x le coût CPU)
+};
 
 class SidPlayer {
 public:
@@ -38,7 +63,16 @@ public:
     bool selectSong(int songNum);           // Sélectionner un subsong spécifique (1-based)
     bool hasMultipleSongs() const;          // Vérifier si plusieurs subsongs
     
-    // Contrôle du mute des voix
+    // Tunes 2SID/3SID : jusqu'à MAX_SID_CHIPS puces de 3 voix, voix numérotées puce * 3 + voix
+    // Sortie toujours stéréo : un tune mono est dupliqué sur les deux canaux, un multi-SID
+    // est émulé en stéréo (placement des puces décidé par libsidplayfp)
+    static const int MAX_SID_CHIPS = 3;
+    static const int MAX_VOICES = MAX_SID_CHIPS * 3;
+    int getSidChipCount() const { return m_sidChips; }
+    int getVoiceCount() const { return m_sidChips * 3; }
+    bool isStereo() const { return m_masterChannels == 2; }
+    
+    // Contrôle du mute des voix (0 à MAX_VOICES - 1)
     void setVoiceMute(int voice, bool muted);
     bool isVoiceMuted(int voice) const;
     
@@ -46,27 +80,139 @@ public:
     void setUseMasterEngine(bool useMaster);
     bool isUsingMasterEngine() const { return m_useMasterEngine; }
     
+    // Mode de capture des voix (single engine par défaut, multi engine pour comparaison)
+    // Changer de mode recharge le subsong courant pour resynchroniser les moteurs
+    void setVoiceCaptureMode(VoiceCaptureMode mode);
+    VoiceCaptureMode getVoiceCaptureMode() const { return m_captureMode; }
+    static bool isSingleEngineCaptureSupported();
+    
+    // Visibilité des oscilloscopes (fenêtre minimisée, onglet Player masqué)
+    // Masqués : seul le master est émulé ; à nouveau visibles : les moteurs d'analyse
+    // rattrapent le master en avance rapide sur le thread de rendu
+    void setAnalysisVisible(bool visible);
+    bool isAnalysisVisible() const { return m_analysisVisible; }
+    bool isAnalysisResyncing() const { return m_analysisResyncing; }
+    
+    // Paramètres audio (appliqués au prochain loadFile, ou immédiatement si un morceau est chargé)
+    // Le périphérique n'est rouvert que dans ce cas : loadFile() le garde ouvert d'un morceau à l'autre
+    // bufferSize est arrondi à une puissance de 2 (64-8192), sampleRate borné à 8000-192000
+    void setAudioSettings(int sampleRate, int bufferSize);
+    int getSampleRate() const { return audioOpen() ? m_sinkFormat.sampleRate : m_sampleRate; }
+    int getDeviceBufferSize() const { return audioOpen() ? m_sinkFormat.bufferFrames : m_bufferSize; }
+    
+    // Sortie audio : périphérique SDL, ou sortie cadencée sans son (null) / vers un fichier (file)
+    // pour les machines sans carte son. Appliqué comme setAudioSettings (rechargement du morceau courant)
+    void setAudioSink(AudioSinkType type, const std::string& outputPath = "");
+    AudioSinkType getAudioSinkType() const { return m_sinkType; }
+    const char* getAudioSinkName() const { return m_sink ? m_sink->getName() : AudioSink::typeName(m_sinkType); }
+    std::string getAudioSinkError() const { return m_sink ? m_sink->getLastError() : std::string(); }
+    void closeAudioOutput() { closeAudioDevice(); } // Arrête la lecture et ferme la sortie (fichier finalisé)
+    
+    // Fréquence d'émulation fixe (0 = celle du périphérique) et méthode d'échantillonnage de reSIDfp
+    // (fastSampling : INTERPOLATE au lieu de RESAMPLE_INTERPOLATE). Si elle diffère du périphérique,
+    // un rééchantillonneur polyphase fait le lien : le coût de l'émulation ne dépend plus de la sortie.
+    // Appliqué comme setAudioSettings (rechargement du morceau courant)
+    void setEmulationSettings(int emulationRate, bool fastSampling);
+    int getEmulationRate() const { return m_emulationFreq; } // Fréquence effective des moteurs
+    bool isResampling() const { return !m_resampler.isPassthrough(); }
+    
+    // Seek dans le subsong courant (en cours de lecture) : avance rapide de l'émulation sur un thread
+    // dédié, sans sortie audio, puis reprise en temps réel. Un seek en arrière repart du début du subsong
+    bool seek(float seconds);
+    bool isSeeking() const { return m_seeking; }
+    float getSeekProgress() const { return m_seekProgress; } // 0.0 - 1.0
+    
+    // Snapshots du morceau chargé : moteurs garés au début du subsong (selectSong, redémarrage)
+    // et toutes les SNAPSHOT_INTERVAL_S de lecture (point de départ des seeks), dans un budget mémoire
+    void setSnapshotMemoryBudget(int megabytes);
+    const EngineSnapshotPool& getSnapshotPool() const { return m_snapshots; }
+    
+    // Enchaînement sans blanc (gapless) : le morceau suivant est préparé en arrière-plan
+    // (parsing, configuration et préchauffage d'un moteur de réserve), puis le thread de rendu
+    // bascule dessus entre deux blocs, sans fermer le périphérique audio ni vider le ring buffer
+    void preloadNextFile(const std::string& filepath); // Asynchrone, sans effet si déjà préparé
+    bool isNextFilePreloaded(const std::string& filepath) const;
+    bool playPreloadedFile(const std::string& filepath); // false si non préparé : utiliser loadFile() + play()
+    
     // Contrôle du loop
     void setLoop(bool loop) { m_loopEnabled = loop; }
     bool isLoopEnabled() const { return m_loopEnabled; }
     
-    // Pour les oscilloscopes - accès direct aux buffers (pas de copies!)
-    static const int OSCILLOSCOPE_SIZE = 256;
-    const float* getVoiceBuffer(int voice) const { 
-        if (voice == 0) return m_voice0Samples;
-        if (voice == 1) return m_voice1Samples;
-        if (voice == 2) return m_voice2Samples;
-        return nullptr;
-    }
+    // Fin de morceau détectée sur la sortie : silence continu pendant la durée donnée (0 = désactivé)
+    // Levé une fois par plage de silence par le thread de rendu ; l'UI le consomme pour passer au suivant
+    void setSilenceTimeout(float seconds) { m_silenceTimeoutS = std::max(0.0f, seconds); }
+    bool consumeTuneEnded() { return m_tuneEnded.exchange(false, std::memory_order_acq_rel); }
+    
+    // Normalisation du volume : gain précalculé (dB) appliqué au mixage, en rampe sur un bloc quand il change
+    void setNormalizationGain(float gainDb);
+    float getNormalizationGain() const { return m_normalizationGainDb.load(std::memory_order_relaxed); }
+    
+    // Pour les oscilloscopes : trame cohérente des voix du tune (3 par puce), alignée sur un déclenchement (front montant)
+    // et décimée en OSCILLOSCOPE_POINTS paires min/max quelle que soit la durée de la fenêtre,
+    // publiée par le thread de rendu via un triple buffer lock-free
+    static const int OSCILLOSCOPE_POINTS = 256;
+    struct OscilloscopeFrame {
+        float minValues[MAX_VOICES][OSCILLOSCOPE_POINTS] = {};
+        float maxValues[MAX_VOICES][OSCILLOSCOPE_POINTS] = {};
+        int voiceCount = 3;      // Voix valides dans la trame
+        float windowMs = 0.0f;   // Durée réellement couverte par la trame
+        uint64_t sequence = 0;   // Numéro de trame (incrémenté à chaque publication)
+    };
+    // Durée de la fenêtre affichée (5-100 ms)
+    void setOscilloscopeWindowMs(float ms);
+    float getOscilloscopeWindowMs() const { return m_scopeWindowMs; }
+    // Thread UI uniquement : récupère la dernière trame publiée ; la référence reste valide
+    // et inchangée jusqu'à l'appel suivant
+    const OscilloscopeFrame& acquireOscilloscopeFrame() { m_scopeFrames.update(); return m_scopeFrames.readBuffer(); }
+    
+    // Analyseur de spectre (voix + master), alimenté par le thread de rendu quand l'analyse est visible
+    SpectrumAnalyzer& getSpectrumAnalyzer() { return m_spectrum; }
+    
+    // Métriques du thread de rendu (lecture depuis l'UI)
+    float getRingFillLevel() const { return static_cast<float>(m_ringBuffer.available()) / m_ringBuffer.capacity(); }
+    size_t getRingFillSamples() const { return m_ringBuffer.available() / OUTPUT_CHANNELS; } // En trames stéréo
+    uint64_t getUnderrunCount() const { return m_timing.getUnderruns(); }
+    
+    // Temps par étape du rendu et du callback (histogrammes lock-free), comparés à leur budget temps réel
+    const AudioTimingStats& getTimingStats() const { return m_timing; }
+    void resetTimingStats() { m_timing.reset(); }
+    // Ajoute un rapport (morceau et réglages courants) à la fin du fichier
+    bool dumpTimingStats(const std::string& path) const;
 
 private:
-    void audioCallback(void* userdata, Uint8* stream, int len);
-    static void audioCallbackWrapper(void* userdata, Uint8* stream, int len);
-    void applyVoiceMuting(); // Fonction utilitaire pour appliquer le mute sur l'engine audio
+    void audioCallback(int16_t* out, int frames);
+    static void audioCallbackWrapper(void* userdata, int16_t* out, int frames);
+    void renderThreadLoop(); // Boucle du thread producteur (émulation en avance dans le ring buffer)
+    void renderBlock(int16_t* out, int samples); // Émule et mixe un bloc stéréo entrelacé (appelé avec m_engineMutex verrouillé)
+    void renderBlockMultiEngine(int16_t* out, int samples); // Chemin de référence : 3 moteurs d'analyse + master (mono)
+    void renderBlockMasterOnly(int16_t* out, int samples); // Master seul, au format du tune (single engine, ou analyse suspendue)
+    void renderVoiceTaps(int samples); // Taps par voix depuis les registres de chaque puce du master
+    bool usesAnalysisEngines() const; // Mode MultiEngine et tune mono (les moteurs d'analyse n'isolent que la puce 0)
+    void resyncAnalysisEngines(); // Avance rapide des moteurs d'analyse jusqu'à la position du master
+    void captureOscilloscope(int samples); // Copie les voix du bloc courant vers les buffers des oscilloscopes
+    void publishOscilloscopeFrame(); // Extrait une fenêtre déclenchée de l'historique et la publie
+    void applyFadeIn(int16_t* const* buffers, int numBuffers, int samples, int channels = 1); // Rampe de fade-in (kernels vectorisés)
+    void applyVoiceMuting(); // Fonction utilitaire pour appliquer le mute sur l'engine audio (toutes les puces)
     void applyAnalysisEngineMuting(); // Fonction utilitaire pour appliquer le mute sur les engines d'analyse
-    void drainAudioBuffer(); // Draine le buffer audio pour éviter les clics
+    bool openAudioDevice(); // Ouvre le périphérique une seule fois (no-op s'il est déjà ouvert)
+    bool audioOpen() const { return m_sink && m_sink->isOpen(); }
+    void closeAudioDevice(); // Arrête la lecture et ferme le périphérique (changement de paramètres audio)
     void fadeOut(int samples); // Fade-out rapide pour éviter les clics
     void fadeIn(int samples); // Fade-in rapide au démarrage
+    void seekThreadFunc(int64_t targetSamples); // Avance rapide du master jusqu'à la cible (thread de seek)
+    void cancelSeek(); // Interrompt et attend un seek en cours (à appeler sans m_engineMutex)
+    void restartMaster(); // Master au début du subsong courant, depuis un snapshot si possible (m_engineMutex verrouillé)
+    int64_t swapMasterWithSnapshot(EngineSnapshot& snapshot); // Gare le master, reprend le snapshot ; retourne sa position
+    bool createSnapshotEngine(EngineSnapshot& snapshot, int freq, SidConfig::sid_model_t sidModel, int channels);
+    SidConfig engineConfig(int freq, SidConfig::sid_model_t sidModel, int channels) const; // Configuration commune des moteurs
+    void reopenAudioDevice(); // Réouverture après changement de paramètres, subsong et état de lecture conservés
+    void snapshotThreadLoop(); // Capture des snapshots en tâche de fond
+    void preloadThreadFunc(std::string filepath, int freq); // Prépare le moteur de réserve (thread de préchargement)
+    void updateTuneInfo(const SidTuneInfo* tuneInfo); // Chaîne d'infos affichée (Latin-1 -> UTF-8)
+    void applyCrossfade(int16_t* mixBuffer, int samples); // Fondu de sortie de l'ancien morceau après bascule (sortie stéréo)
+    static int sidChipCount(const SidTuneInfo* tuneInfo, unsigned int maxSids); // Puces émulées pour un tune
+    int16_t* voiceBuffer(int voice) { return m_voiceAudioBuffers.data() + voice * MAX_AUDIO_BUFFER_SIZE; }
+    void updateSilenceDetector(const int16_t* mixBuffer, int samples); // Thread de rendu, avant l'avance de m_masterSamplePos
 
     // 3 moteurs SID en parallèle pour l'analyse (mixage manuel pour l'audio) :
     // Engine #1 → analyse voix 1 (voix 2+3 mutées)
@@ -87,53 +233,167 @@ private:
     std::unique_ptr<ReSIDfpBuilder> m_builderVoice2;
     std::unique_ptr<ReSIDfpBuilder> m_builderMaster;
     
-    SDL_AudioDeviceID m_audioDevice;
-    SDL_AudioSpec m_audioSpec;
+    // Emplacement "morceau suivant" (double buffer du master) : échangé avec le master à la bascule,
+    // il contient ensuite l'ancien master le temps du fondu enchaîné
+    std::unique_ptr<sidplayfp> m_engineNext;
+    std::unique_ptr<ReSIDfpBuilder> m_builderNext;
+    std::unique_ptr<SidTune> m_nextTune;
+    std::string m_nextFile;                 // Fichier préparé (vide si l'emplacement est libre)
+    int m_nextFreq;                         // Fréquence de configuration (invalide si le périphérique a changé)
+    SidConfig::sid_model_t m_nextSidModel;
+    int m_nextSidChips;
+    int m_nextChannels;                     // Après la bascule : format de l'ancien master (fondu)
+    std::string m_preloadRequested;         // Dernier fichier demandé (thread UI uniquement)
+    std::thread m_preloadThread;
+    mutable std::mutex m_nextMutex;         // Tenu seulement pour vider/publier l'emplacement (m_nextTune, m_nextFile...)
+    std::atomic<bool> m_preloading;         // Thread de préchargement actif : m_engineNext lui appartient
+    std::atomic<int> m_crossfadeRemaining;  // Échantillons de fondu restants (l'ancien master est dans m_engineNext)
+    
+    AudioSinkType m_sinkType;
+    std::string m_sinkOutputPath;        // Fichier de sortie (AudioSinkType::File)
+    std::unique_ptr<AudioSink> m_sink;   // Créé à la première ouverture
+    AudioSinkFormat m_sinkFormat;        // Format obtenu à l'ouverture
     
     std::string m_currentFile;
     std::string m_tuneInfo;
     SidConfig::sid_model_t m_currentSidModel; // Modèle SID actuellement utilisé
-    bool m_playing;
-    bool m_paused;
+    // Configuration appliquée aux moteurs (master + analyse) : config() n'est refait que si elle change
+    SidConfig::sid_model_t m_configuredSidModel;
+    int m_configuredFreq; // 0 : jamais configurés pour le périphérique
+    int m_configuredChannels; // Format de sortie du master (1 ou 2)
+    // Tune courant : puces SID émulées et canaux produits par le master (lus par l'UI)
+    std::atomic<int> m_sidChips;
+    std::atomic<int> m_masterChannels;
+    std::atomic<bool> m_playing;
+    std::atomic<bool> m_paused;
     
     // Synchronisation pour l'arrêt propre
     std::atomic<bool> m_audioCallbackActive;
     std::atomic<bool> m_stopping;
     
+    // Thread de rendu : l'émulation tourne hors du callback SDL (temps réel)
+    // Le callback ne fait plus qu'une copie depuis le ring buffer SPSC
+    std::thread m_renderThread;
+    std::atomic<bool> m_renderThreadRunning;
+    std::mutex m_engineMutex; // Protège les engines entre le thread UI et le thread de rendu
+    AudioRingBuffer m_ringBuffer;
+    AudioTimingStats m_timing;  // Underruns : callbacks servis incomplètement (ring buffer vide)
+    int64_t m_lastCallbackNs;   // Début du callback précédent en lecture (callback SDL uniquement, 0 = inconnu)
+    
     // État du sub-tune
     int m_currentSong;
     
-    // État du mute pour chaque voix
-    bool m_voice0Muted;
-    bool m_voice1Muted;
-    bool m_voice2Muted;
+    // État du mute pour chaque voix (puce * 3 + voix), conservé d'un tune à l'autre
+    bool m_voiceMuted[MAX_VOICES];
     
-    // Buffers statiques pour les oscilloscopes (approche bas niveau C)
-    float m_voice0Samples[OSCILLOSCOPE_SIZE];
-    float m_voice1Samples[OSCILLOSCOPE_SIZE];
-    float m_voice2Samples[OSCILLOSCOPE_SIZE];
+    // Historique circulaire des voix pour les oscilloscopes (thread de rendu, sous m_engineMutex)
+    // Deux fenêtres de 100 ms à 192 kHz : le déclenchement est cherché dans la plus ancienne
+    static const int OSCILLOSCOPE_HISTORY = 65536; // Puissance de 2 (masquage)
+    static const int OSCILLOSCOPE_PUBLISH_HZ = 120; // Trames publiées par seconde au plus
+    std::vector<int16_t> m_scopeHistory[MAX_VOICES]; // Sur le tas (1,1 Mo : SidPlayer peut vivre sur la pile)
     int m_writeIndex; // Index d'écriture circulaire
+    int m_scopeSamplesSincePublish;
+    std::atomic<float> m_scopeWindowMs;
+    // Producteur : thread de rendu (ou thread UI dans play(), toujours sous m_engineMutex)
+    TripleBuffer<OscilloscopeFrame> m_scopeFrames;
+    uint64_t m_scopeSequence;
+    SpectrumAnalyzer m_spectrum; // Son propre worker : le thread de rendu ne fait que copier
     
     // Fade-in pour éviter les glitches au démarrage
     int m_fadeInCounter; // Compteur d'échantillons pour le fondu à l'ouverture
     static const int FADE_IN_DURATION = 2000; // Environ 45ms à 44.1kHz
     
-    // Buffers statiques pour le mixage audio (évite new/delete dans le callback)
-    // Taille suffisante pour gérer les callbacks audio (BUFFER_SIZE = 256, mais on prend une marge)
+    // Buffers statiques pour le mixage audio (évite new/delete dans le thread de rendu)
+    // Le rendu se fait par blocs de m_renderChunkSize <= MAX_AUDIO_BUFFER_SIZE, quelle que soit
+    // la taille du buffer du périphérique (le ring buffer fait le lien)
+    // Tailles en trames ; les buffers de sortie contiennent jusqu'à OUTPUT_CHANNELS échantillons par trame
     static const int MAX_AUDIO_BUFFER_SIZE = 512;
-    int16_t m_voice0AudioBuffer[MAX_AUDIO_BUFFER_SIZE];
-    int16_t m_voice1AudioBuffer[MAX_AUDIO_BUFFER_SIZE];
-    int16_t m_voice2AudioBuffer[MAX_AUDIO_BUFFER_SIZE];
-    int16_t m_masterAudioBuffer[MAX_AUDIO_BUFFER_SIZE]; // Buffer pour le moteur master
+    static const int OUTPUT_CHANNELS = 2;
+    std::vector<int16_t> m_voiceAudioBuffers; // MAX_VOICES blocs de MAX_AUDIO_BUFFER_SIZE, alloués une fois (voiceBuffer())
+    int16_t m_masterAudioBuffer[MAX_AUDIO_BUFFER_SIZE * OUTPUT_CHANNELS]; // Buffer pour le moteur master (format du tune)
+    int16_t m_renderAudioBuffer[MAX_AUDIO_BUFFER_SIZE * OUTPUT_CHANNELS]; // Bloc stéréo mixé avant écriture dans le ring buffer
+    int16_t m_crossfadeAudioBuffer[MAX_AUDIO_BUFFER_SIZE * OUTPUT_CHANNELS]; // Queue de l'ancien morceau pendant la bascule
+    int16_t m_monoAudioBuffer[MAX_AUDIO_BUFFER_SIZE]; // Mixage mono (chemin MultiEngine, entrée master du spectre)
+    std::vector<int16_t> m_resampledAudioBuffer; // Bloc à la fréquence du périphérique (dimensionné par configureRenderPath)
     
-    // Flag pour basculer entre master et mixage manuel
+    // Flag pour basculer entre master et mixage manuel (mode MultiEngine uniquement)
     bool m_useMasterEngine;
     
+    // Mode SingleEngine : taps par voix synthétisés depuis les registres du moteur master
+    VoiceCaptureMode m_captureMode;
+    VoiceTap m_voiceTaps[MAX_VOICES];
+    double m_sidClockHz; // Horloge C64 du tune (PAL/NTSC) pour les taps
+    
+    // Analyse paresseuse : positions (en échantillons) du master et des moteurs d'analyse
+    // Écrites par le thread de rendu uniquement ; égales quand l'analyse est synchronisée
+    std::atomic<bool> m_analysisVisible;
+    std::atomic<bool> m_analysisResyncing;
+    std::atomic<int64_t> m_masterSamplePos;
+    std::atomic<int64_t> m_analysisSamplePos;
+    
     // Flag pour le loop (redémarrer automatiquement à la fin)
     bool m_loopEnabled;
     
-    static const int SAMPLE_RATE = 44100;
-    static const int BUFFER_SIZE = 256;
+    // Détection de fin par le silence (état du thread de rendu, remis à zéro à chaque saut de position :
+    // chargement, changement de subsong, seek, bascule gapless)
+    static const int SILENCE_PEAK_TO_PEAK = 96; // Crête à crête par bloc (~ -56 dBFS, ignore l'offset DC du 6581)
+    std::atomic<float> m_silenceTimeoutS;
+    std::atomic<bool> m_tuneEnded;
+    int64_t m_silenceExpectedPos;   // Position attendue du prochain bloc (continuité du rendu)
+    int64_t m_silentSamples;        // Durée de la plage de silence en cours
+    bool m_heardSound;              // Un bloc non silencieux a été rendu depuis le début
+    bool m_endReported;             // Événement déjà levé pour la plage en cours
+    
+    // Normalisation du volume (cible écrite par l'UI, gain courant propre au thread de rendu)
+    std::atomic<float> m_normalizationGainDb;
+    std::atomic<float> m_normalizationGain;  // Linéaire
+    float m_appliedGain;
+    
+    static const int DEFAULT_SAMPLE_RATE = 44100;
+    static const int DEFAULT_BUFFER_SIZE = static_cast<int>(LatencyProfile::Default);
+    
+    // Paramètres demandés (config) ; les valeurs obtenues sont dans m_sinkFormat
+    int m_sampleRate;
+    int m_bufferSize;
+    int m_emulationRate;                // 0 : fréquence du périphérique
+    std::atomic<bool> m_fastSampling;
+    
+    // Fréquence des moteurs (positions, seeks, snapshots, taps et analyse sont dans cette unité)
+    // et étage de rééchantillonnage vers le périphérique (thread de rendu)
+    int m_emulationFreq;
+    imsid::audio::PolyphaseResampler m_resampler;
+    
+    // Dimensionnement du rendu, recalculé à l'ouverture du périphérique (configureRenderPath)
+    // Avance visée : 4 blocs ou 2 buffers périphérique (le plus grand), pour absorber les à-coups de l'émulation
+    int m_renderChunkSize;      // Taille d'un bloc émulé (<= MAX_AUDIO_BUFFER_SIZE, à la fréquence d'émulation)
+    int m_renderOutputChunk;    // Trames produites au plus par un bloc après rééchantillonnage
+    // Lus sans verrou par le thread de rendu pendant que le thread UI rouvre le périphérique
+    std::atomic<int> m_renderAheadSamples;  // Remplissage visé du ring buffer (en trames du périphérique)
+    std::atomic<int> m_renderSleepMs;       // Attente du thread de rendu quand le ring buffer est plein
+    void configureRenderPath(int deviceSamples, int deviceFreq);
+    
+    // Avance rapide (resynchronisation des moteurs d'analyse, seek) : facteur maximal de libsidplayfp (3200%)
+    // Durée maximale d'une tranche de rattrapage entre deux remplissages du ring buffer
+    static const int FAST_FORWARD_PERCENT = 3200;
+    static const int RESYNC_SLICE_MS = 2;
+    
+    // Seek : thread dédié, verrou des moteurs relâché toutes les SEEK_SLICE_MS
+    std::thread m_seekThread;
+    std::atomic<bool> m_seeking;
+    std::atomic<bool> m_seekCancel;
+    std::atomic<float> m_seekProgress;
+    static const int SEEK_SLICE_MS = 10;
+    
+    // Snapshots (voir EngineSnapshotPool) : vidés à chaque changement de fichier (m_snapshotGeneration)
+    EngineSnapshotPool m_snapshots;
+    std::thread m_snapshotThread;
+    unsigned int m_maxSids;
+    std::atomic<uint64_t> m_snapshotGeneration;
+    bool m_masterAtStart; // Master préchauffé au début du subsong et pas encore joué (play() ne le recharge pas)
+    static const int DEFAULT_SNAPSHOT_BUDGET_MB = 8;
+    static const int SNAPSHOT_INTERVAL_S = 10;
+    static const int SNAPSHOT_POLL_MS = 100;
+    static const int SNAPSHOT_SLICE_MS = 5; // Tranche d'avance rapide, suivie d'une pause de même durée
 };
 
 #endif // SIDPLAYER_H
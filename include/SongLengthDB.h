@@ -5,6 +5,9 @@
 #include <vector>
 #include <unordered_map>
 #include <filesystem>
+#include <istream>
+#include <mutex>
+#include <shared_mutex>
 
 namespace fs = std::filesystem;
 
@@ -21,6 +24,9 @@ namespace fs = std::filesystem;
  * [Database]
  * ; /DEMOS/0-9/12345.sid
  * 2727236ead44a62f0c6e01f6dd4dc484=0:56
+ * 
+ * Un overlay local (même format) complète la base officielle avec les durées détectées
+ * par SongLengthDetector ; getDurations() le consulte quand le hash est absent de la base.
  */
 class SongLengthDB {
 public:
@@ -30,7 +36,8 @@ public:
     bool load(const std::string& filepath);
     
     // Obtenir les durées pour un hash MD5 donné (retourne un vecteur de durées en secondes)
-    // Retourne un vecteur vide si le hash n'existe pas
+    // Base officielle d'abord, puis overlay local ; vecteur vide si le hash n'existe dans aucun des deux
+    // Une durée de 0 signifie "analysée, fin non détectée"
     std::vector<double> getDurations(const std::string& md5Hash) const;
     
     // Obtenir la durée d'un subsong spécifique (index 0-based)
@@ -41,17 +48,24 @@ public:
     bool hasHash(const std::string& md5Hash) const;
     
     // Obtenir le chemin du fichier actuellement chargé
-    std::string getFilePath() const { return m_filepath; }
+    std::string getFilePath() const;
     
     // Vérifier si la base est chargée
-    bool isLoaded() const { return !m_filepath.empty() && !m_database.empty(); }
+    bool isLoaded() const;
     
     // Obtenir le nombre d'entrées dans la base
-    size_t getCount() const { return m_database.size(); }
+    size_t getCount() const;
     
-    // Vider la base de données
+    // Vider la base de données (l'overlay local est conservé)
     void clear();
     
+    // Overlay local des durées détectées (thread-safe : écrit par les workers de détection)
+    // Chargé au démarrage ; chaque ajout est aussitôt consigné en fin de fichier
+    bool loadOverlay(const std::string& filepath);
+    void addDetectedDurations(const std::string& md5Hash, const std::vector<double>& durations);
+    bool hasOverlayEntry(const std::string& md5Hash) const;
+    size_t getOverlayCount() const;
+    
 private:
     SongLengthDB() = default;
     ~SongLengthDB() = default;
@@ -64,8 +78,20 @@ private:
     // Vérifier le format d'un fichier Songlengths.md5
     static bool isValidFormat(const std::string& filepath);
     
+    // Lire les entrées md5=durées qui suivent l'en-tête [Database] (les doublons remplacent les précédents)
+    static size_t parseEntries(std::istream& input, std::unordered_map<std::string, std::vector<double>>& database);
+    
+    // Secondes -> "m:ss.SSS"
+    static std::string formatDuration(double seconds);
+    
+    // Base officielle : rechargée par le thread UI (glisser-déposer), lue par les workers d'analyse
     std::unordered_map<std::string, std::vector<double>> m_database; // md5 -> vector de durées (secondes)
     std::string m_filepath; // Chemin du fichier chargé
+    mutable std::shared_mutex m_databaseMutex; // Protège m_database et m_filepath
+    
+    std::unordered_map<std::string, std::vector<double>> m_overlay; // Durées détectées localement
+    std::string m_overlayPath;
+    mutable std::mutex m_overlayMutex;
 };
 
 #endif // SONGLENGTH_DB_H
@@ -0,0 +1,72 @@
+#ifndef SONGLENGTH_DETECTOR_H
+#define SONGLENGTH_DETECTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+class sidplayfp;
+
+/**
+ * Détection automatique de la durée des tunes absents de Songlengths.md5
+ *
+ * Chaque subsong est émulé hors temps réel sur un petit pool de workers à basse priorité
+ * (moteurs propres, aucun partage avec SidPlayer). La fin est détectée :
+ * - par le silence en sortie (SILENCE_MIN_S sans signal après le premier son) ;
+ * - par le bouclage de la partition : les attaques de notes (gate des 3 voix, fréquence,
+ *   forme d'onde) relevées dans les registres SID se répètent à l'identique, avec le même
+ *   rythme, sur au moins une période complète.
+ * Les résultats sont ajoutés à l'overlay local de SongLengthDB (0 = fin non détectée).
+ */
+class SongLengthDetector {
+public:
+    static SongLengthDetector& getInstance();
+
+    // Mettre un tune en file (tous ses subsongs) ; sans effet s'il a déjà une durée ou est déjà en file
+    void request(const std::string& filepath, const std::string& md5Hash);
+
+    // Arrêter les workers (à appeler avant la fin du programme)
+    void shutdown();
+
+    size_t getPendingCount() const;
+    uint64_t getDetectedCount() const { return m_detectedCount.load(std::memory_order_relaxed); }
+
+    // Analyse synchrone d'un subsong déjà sélectionné et chargé dans engine (secondes, 0 si non détectée)
+    static double analyzeSubsong(sidplayfp& engine, int sampleRate, const std::atomic<bool>* cancel = nullptr);
+
+    static const int ANALYSIS_SAMPLE_RATE = 22050; // La sortie ne sert qu'à détecter le silence
+    static const int MAX_ANALYSIS_S = 20 * 60;     // Boucles jusqu'à 10 min (une période de vérification)
+    static constexpr double SILENCE_MIN_S = 3.0;
+
+private:
+    SongLengthDetector() = default;
+    ~SongLengthDetector();
+    SongLengthDetector(const SongLengthDetector&) = delete;
+    SongLengthDetector& operator=(const SongLengthDetector&) = delete;
+
+    struct Job {
+        std::string filepath;
+        std::string md5Hash;
+    };
+
+    void startWorkers();
+    void workerLoop();
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Job> m_queue;
+    std::unordered_set<std::string> m_known; // md5 en file ou en cours
+    std::vector<std::thread> m_workers;
+    bool m_running = false;
+    size_t m_activeJobs = 0;                 // Jobs en cours d'analyse (protégé par m_mutex)
+    std::atomic<bool> m_stopping{false};
+    std::atomic<uint64_t> m_detectedCount{0};
+};
+
+#endif // SONGLENGTH_DETECTOR_H
@@ -0,0 +1,70 @@
+#ifndef SPECTRUM_ANALYZER_H
+#define SPECTRUM_ANALYZER_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "AudioRingBuffer.h"
+#include "TripleBuffer.h"
+#include "RealFft.h"
+
+// Analyseur de spectre des 3 voix et du master, calculé hors du thread UI
+// Producteur : thread de rendu (push() après chaque bloc). Worker : FFT fenêtrée (Hann) toutes les
+// HOP_SIZE échantillons, réduite en NUM_BANDS bandes logarithmiques, publiée par triple buffer.
+class SpectrumAnalyzer {
+public:
+    static const int NUM_CHANNELS = 4;      // Voix 0, 1, 2 puis master
+    static const int MASTER_CHANNEL = 3;
+    static const int FFT_SIZE = 2048;
+    static const int HOP_SIZE = FFT_SIZE / 2;
+    static const int NUM_BANDS = 64;
+    static constexpr float MIN_FREQUENCY = 20.0f;
+    static constexpr float MIN_DB = -90.0f;
+
+    struct Frame {
+        float bands[NUM_CHANNELS][NUM_BANDS] = {}; // Niveau normalisé 0..1 (MIN_DB..0 dB)
+        uint64_t sequence = 0;
+    };
+
+    SpectrumAnalyzer();
+    ~SpectrumAnalyzer();
+
+    // Activer le worker (sans effet sur le thread de rendu quand désactivé : push() ne copie rien)
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    void setSampleRate(int sampleRate) { m_sampleRate.store(sampleRate, std::memory_order_relaxed); }
+
+    // Côté producteur (thread de rendu) : jamais bloquant, les échantillons sont perdus si le worker est en retard
+    void push(const int16_t* voice0, const int16_t* voice1, const int16_t* voice2, const int16_t* master, int samples);
+
+    // Côté UI (un seul thread) : dernière trame publiée, stable jusqu'à l'appel suivant
+    const Frame& acquireFrame() { m_frames.update(); return m_frames.readBuffer(); }
+
+    // Coût moyen d'une analyse complète (4 FFT + bandes), en millisecondes
+    float getAnalysisTimeMs() const { return m_analysisTimeMs.load(std::memory_order_relaxed); }
+
+private:
+    void workerLoop();
+    void analyze(); // FFT des NUM_CHANNELS fenêtres courantes et publication
+
+    AudioRingBuffer m_input[NUM_CHANNELS];
+    std::vector<float> m_window[NUM_CHANNELS];  // FFT_SIZE derniers échantillons (glissants de HOP_SIZE)
+    std::vector<float> m_hann;
+    std::vector<float> m_windowed;
+    std::vector<float> m_power;
+    std::vector<int16_t> m_hop;
+    imsid::audio::RealFft m_fft;
+    float m_smoothed[NUM_CHANNELS][NUM_BANDS];   // Retombée progressive des crêtes (lisibilité)
+
+    TripleBuffer<Frame> m_frames;
+    uint64_t m_sequence;
+
+    std::thread m_worker;
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_enabled;
+    std::atomic<int> m_sampleRate;
+    std::atomic<float> m_analysisTimeMs;
+};
+
+#endif // SPECTRUM_ANALYZER_H
@@ -0,0 +1,42 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+// Triple buffer lock-free mono-producteur / mono-consommateur
+// Le producteur remplit writeBuffer() puis publish() ; le consommateur appelle update() puis lit
+// readBuffer(), qui reste stable (jamais réécrit) jusqu'au prochain update(). Aucune attente
+// d'un côté comme de l'autre : le producteur écrase simplement la trame non lue la plus ancienne.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : m_writeIndex(0), m_middle(1), m_readIndex(2) {}
+
+    // Côté producteur
+    T& writeBuffer() { return m_buffers[m_writeIndex]; }
+    void publish() {
+        // Échanger le buffer écrit avec celui du milieu, marqué "nouveau"
+        int previous = m_middle.exchange(m_writeIndex | NEW_FRAME, std::memory_order_acq_rel);
+        m_writeIndex = previous & INDEX_MASK;
+    }
+
+    // Côté consommateur : true si une nouvelle trame est devenue lisible
+    bool update() {
+        if (!(m_middle.load(std::memory_order_relaxed) & NEW_FRAME)) return false;
+        int previous = m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+        m_readIndex = previous & INDEX_MASK;
+        return true;
+    }
+    const T& readBuffer() const { return m_buffers[m_readIndex]; }
+
+private:
+    static const int INDEX_MASK = 0x3;
+    static const int NEW_FRAME = 0x4;
+
+    T m_buffers[3];
+    int m_writeIndex;            // Propriété du producteur
+    alignas(64) std::atomic<int> m_middle; // Index du buffer d'échange + bit NEW_FRAME
+    alignas(64) int m_readIndex; // Propriété du consommateur
+};
+
+#endif // TRIPLE_BUFFER_H
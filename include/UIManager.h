@@ -77,6 +77,9 @@ public:
     std::string getDatabaseOperationStatus() const { return m_databaseOperationStatus; }
     float getDatabaseOperationProgress() const { return m_databaseOperationProgress; }
     
+    // Sonie enregistrée en base (résultats de LoudnessAnalyzer) : gain de normalisation à recalculer
+    void invalidateLoudnessNormalization() { m_loudnessDirty = true; }
+    
 private:
     SidPlayer& m_player;
     PlaylistManager& m_playlist;
@@ -101,9 +104,8 @@ private:
     
     // Timings des oscilloscopes pour la fenêtre de debug
     float m_oscilloscopeTime;  // Temps total des oscilloscopes (en ms)
-    float m_oscilloscopePlot0Time;  // Temps du plot 0 (en ms)
-    float m_oscilloscopePlot1Time;  // Temps du plot 1 (en ms)
-    float m_oscilloscopePlot2Time;  // Temps du plot 2 (en ms)
+    float m_oscilloscopePlotTime;   // Temps cumulé des plots de toutes les voix (en ms)
+    bool m_oscilloscopesVisible;  // Oscilloscopes affichés pendant la frame courante (pilote l'analyse paresseuse)
     
     // Palette arc-en-ciel pour les étoiles (255 couleurs)
     std::vector<ImVec4> m_rainbowPalette;
@@ -155,6 +157,18 @@ private:
     int m_cachedCurrentIndex;  // Index courant mis en cache (-1 = invalide)
     bool m_navigationCacheValid;  // Flag indiquant si le cache est valide
     
+    // Durée inconnue : dernier (fichier, subsong) signalé à SongLengthDetector (une requête par changement)
+    std::string m_songLengthRequestFile;
+    int m_songLengthRequestSong;
+    
+    // Normalisation : état pour lequel le gain a été calculé (recalcul seulement s'il change)
+    std::string m_loudnessFile;
+    int m_loudnessSong;
+    bool m_loudnessHadMetadata;
+    bool m_loudnessEnabled;
+    float m_loudnessTargetLufs;
+    bool m_loudnessDirty;
+    
     // Méthodes de rendu
     void renderMainPanel();
     void renderPlayerTab();
@@ -166,6 +180,8 @@ private:
     
     // Composants UI
     void renderOscilloscopes();
+    void renderScopeTrace(const float* minValues, const float* maxValues, int count, const ImVec2& size); // Tracé min/max d'une voix
+    void renderSpectrum(const ImVec2& size); // Spectre master (barres) et voix (courbes)
     void renderPlayerControls();
     void renderPlaylistTree();
     void renderPlaylistNavigation();
@@ -198,6 +214,14 @@ private:
     
     // Obtenir le prochain fichier dans la liste filtrée (utilise le cache si disponible)
     PlaylistNode* getNextFilteredFile();
+    
+    // Fin de morceau (durée atteinte ou silence) : enchaîner sur le suivant de la liste filtrée, ou arrêter
+    void playNextTune();
+    
+    // Gain de normalisation du morceau courant (sonie de la base) ; met en file l'analyse des tunes non mesurés.
+    // Appelée à chaque frame, ne fait rien tant que morceau, subsong, réglages et sonie en base sont inchangés
+    void updateLoudnessNormalization(const SidMetadata* metadata);
+    static constexpr float MAX_NORMALIZATION_DB = 12.0f;
 };
 
 #endif // UI_MANAGER_H
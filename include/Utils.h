@@ -1,8 +1,11 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <string>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -12,6 +15,15 @@ fs::path getConfigDir();
 // Calculer le hash MD5 d'un fichier (pour Songlengths.md5)
 std::string calculateFileMD5(const std::string& filepath);
 
+// Même hash depuis le contenu du fichier déjà en mémoire (évite une seconde lecture)
+std::string calculateDataMD5(const uint8_t* data, size_t size);
+
+// Lire un fichier entier en une fois (un seul open/read) ; false s'il est illisible, vide ou plus grand que maxBytes
+bool readFileBytes(const std::string& filepath, std::vector<uint8_t>& data, size_t maxBytes);
+
+// Abaisser la priorité du thread appelant (travaux de fond qui ne doivent pas gêner l'audio ni l'UI)
+void lowerCurrentThreadPriority();
+
 // Convertir une chaîne Latin-1 vers UTF-8
 // Les fichiers SID utilisent souvent Latin-1 (ISO-8859-1) au lieu d'UTF-8
 std::string latin1ToUtf8(const std::string& latin1);
@@ -0,0 +1,32 @@
+#ifndef VOICE_TAP_H
+#define VOICE_TAP_H
+
+#include <cstdint>
+
+// Reconstruction légère du signal d'une voix SID à partir de ses registres.
+// Utilisé par le mode "single engine" : seul le moteur master est émulé, et les
+// oscilloscopes sont alimentés par ces taps (oscillateur + enveloppe simplifiés)
+// au lieu de trois émulations reSIDfp complètes. Pas destiné à la sortie audio.
+class VoiceTap {
+public:
+    VoiceTap();
+
+    // Remettre l'oscillateur, le LFSR de bruit et l'enveloppe à zéro (changement de morceau)
+    void reset();
+
+    // Synthétiser `samples` échantillons de la voix `voice` (0-2)
+    // regs : 32 registres du SID (dernières valeurs écrites)
+    // cyclesPerSample : horloge C64 / fréquence d'échantillonnage
+    void render(const uint8_t regs[32], int voice, int16_t* out, int samples, double cyclesPerSample, int sampleRate);
+
+private:
+    enum class EnvelopeState { Attack, DecaySustain, Release };
+
+    uint32_t m_accumulator;   // Accumulateur de phase 24 bits
+    uint32_t m_noiseLfsr;     // Registre à décalage 23 bits du générateur de bruit
+    float m_envelope;         // Niveau d'enveloppe (0..1)
+    EnvelopeState m_envState;
+    bool m_prevGate;
+};
+
+#endif // VOICE_TAP_H
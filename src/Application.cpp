@@ -1,6 +1,10 @@
 #include "Application.h"
 #include "Version.h"
 #include "SongLengthDB.h"
+#include "SongLengthDetector.h"
+#include "LoudnessAnalyzer.h"
+#include "IndexingPipeline.h"
+#include "LibraryScanner.h"
 #include "Utils.h"
 #include "Config.h"
 #include "Logger.h"
@@ -16,6 +20,8 @@
 #include <functional>
 #include <cstring>
 #include <chrono>
+#include <iterator>
+#include <unordered_map>
 
 namespace fs = std::filesystem;
 
@@ -108,6 +114,20 @@ bool Application::initialize() {
             LOG_WARNING("Failed to load Songlengths.md5 at startup: {}", m_config.getSonglengthsPath());
         }
     }
+    // Durées détectées localement pour les tunes absents de Songlengths.md5
+    SongLengthDB::getInstance().loadOverlay((getConfigDir() / "songlengths-detected.md5").string());
+    
+    // Paramètres audio (avant l'ouverture du périphérique par loadFile)
+    AudioSinkType sinkType = AudioSinkType::Sdl;
+    if (!AudioSink::typeFromName(m_config.getAudioOutput(), sinkType)) {
+        LOG_WARNING("Unknown audio_output '{}', using SDL", m_config.getAudioOutput());
+    }
+    m_player.setAudioSink(sinkType, m_config.getAudioOutputFile());
+    m_player.setAudioSettings(m_config.getAudioSampleRate(), m_config.getAudioBufferSize());
+    m_player.setEmulationSettings(m_config.getEmulationRate(), m_config.isFastSamplingEnabled());
+    m_player.setSnapshotMemoryBudget(m_config.getSnapshotMemoryMB());
+    m_player.setSilenceTimeout(static_cast<float>(m_config.getSilenceSkipSeconds()));
+    m_player.setOscilloscopeWindowMs(m_config.getOscilloscopeWindowMs());
     
     // Restaurer le fichier en cours
     if (!m_config.getCurrentFile().empty() && fs::exists(m_config.getCurrentFile())) {
@@ -377,6 +397,8 @@ int Application::run() {
         
         // Si la fenêtre est minimisée, attendre plus longtemps pour économiser le CPU
         if (isMinimized) {
+            // Rien n'est affiché : l'audio n'a besoin que du moteur master
+            m_player.setAnalysisVisible(false);
             SDL_Event event;
             // Utiliser WaitEventTimeout pour ne pas bloquer indéfiniment
             if (SDL_WaitEventTimeout(&event, 100)) {
@@ -465,6 +487,19 @@ int Application::run() {
             indexingDone = false; // Reset pour la prochaine fois
         }
         
+        // Sonie analysée en arrière-plan : enregistrée dans la base hors opérations de fond (persistée au save())
+        if (m_database && m_databaseOperation.load() == DatabaseOperation::None) {
+            std::vector<LoudnessAnalyzer::Result> results = LoudnessAnalyzer::getInstance().takeResults();
+            for (const LoudnessAnalyzer::Result& result : results) {
+                for (size_t i = 0; i < result.loudness.size(); ++i) {
+                    m_database->setLoudness(result.filepath, static_cast<int>(i), result.loudness[i]);
+                }
+            }
+            if (!results.empty() && m_uiManager) {
+                m_uiManager->invalidateLoudnessNormalization();
+            }
+        }
+        
         // Vérifier périodiquement si le renderer est toujours valide
         // (toutes les 1000 frames environ, soit ~16 secondes à 60 FPS)
         static int frameCount = 0;
@@ -644,6 +679,10 @@ void Application::shutdown() {
     
     SDL_Quit();
     
+    // Arrêter les analyses en arrière-plan (durées, sonie)
+    SongLengthDetector::getInstance().shutdown();
+    LoudnessAnalyzer::getInstance().shutdown();
+    
     // Arrêter le logger en dernier
     Logger::shutdown();
 }
@@ -655,61 +694,110 @@ void Application::indexPlaylistAsync() {
     m_databaseProgress = 0.0f;
     m_databaseCurrent = 0;
     
-    auto allFiles = m_playlist.getAllFiles();
-    m_databaseTotal = allFiles.size();
+    // Liste des fichiers et de leur rootFolder, construite ici : l'arbre de la playlist
+    // n'est pas parcouru depuis les threads d'indexation
+    std::vector<IndexingPipeline::Job> jobs;
+    for (PlaylistNode* node : m_playlist.getAllFiles()) {
+        if (!node || node->filepath.empty()) continue;
+        
+        // Déterminer le rootFolder : remonter jusqu'au premier enfant direct de m_root
+        std::string rootFolder = "";
+        PlaylistNode* current = node->parent;
+        while (current && current->parent) {
+            // Si le parent de current est m_root (parent == nullptr), alors current est le rootFolder
+            if (current->parent->parent == nullptr) {
+                // current->parent est m_root, donc current est le rootFolder
+                if (current->isFolder) {
+                    rootFolder = current->name;
+                }
+                break;
+            }
+            current = current->parent;
+        }
+        jobs.push_back({node->filepath, rootFolder, {}});
+    }
+    m_databaseTotal = jobs.size();
     
     {
         std::lock_guard<std::mutex> lock(m_databaseStatusMutex);
         m_databaseStatusMessage = "Indexing playlist...";
     }
     
-    m_databaseThread = std::thread([this, allFiles]() {
+    m_databaseThread = std::thread([this, jobs = std::move(jobs)]() mutable {
         if (!m_database) return;
         
-        int indexed = 0;
-        int total = allFiles.size();
+        // Dossiers racines déjà en base : rescan incrémental (journal des dossiers et fichiers).
+        // Les fichiers isolés (sans rootFolder) restent vérifiés un par un via la playlist
+        std::unordered_map<std::string, std::string> rootPaths;
+        std::vector<LibraryScanner::Root> roots;
+        for (const auto& entry : m_database->getRootFolders()) {
+            if (entry.rootFolder.empty() || entry.rootPath.empty() || rootPaths.count(entry.rootFolder)) continue;
+            rootPaths[entry.rootFolder] = entry.rootPath;
+            roots.push_back({entry.rootPath, entry.rootFolder});
+        }
+        const std::string journalPath = (getConfigDir() / "scan_journal.bin").string();
+        LibraryScanner scanner;
+        if (!scanner.load(journalPath) && fs::exists(journalPath)) {
+            LOG_WARNING("Ignoring scan journal: {}", scanner.getLastError());
+        }
+        auto known = m_database->getFileStamps();
+        LibraryScanner::Changes changes = scanner.scan(roots, known, &m_shouldStopDatabaseThread);
+        LOG_INFO("Library scan: {} added, {} modified, {} removed, {} unchanged; {} of {} folders listed in {:.3f} s",
+                 changes.added, changes.modified, changes.removed.size(), changes.unchanged,
+                 changes.directoriesListed, changes.directories, changes.seconds);
         
-        for (size_t i = 0; i < allFiles.size(); ++i) {
-            if (m_shouldStopDatabaseThread.load()) break;
-            
-            PlaylistNode* node = allFiles[i];
-            if (!node || node->filepath.empty()) continue;
-            
-            m_databaseCurrent = i + 1;
-            m_databaseProgress = static_cast<float>(i + 1) / total;
-            
-            std::string statusMsg = "Indexing: " + fs::path(node->filepath).filename().string();
-            {
-                std::lock_guard<std::mutex> lock(m_databaseStatusMutex);
-                m_databaseStatusMessage = statusMsg;
-            }
-            
-            // Mettre à jour l'UI
-            if (m_uiManager) {
-                m_uiManager->setDatabaseOperationInProgress(true, statusMsg, m_databaseProgress.load());
-            }
-            
-            // Déterminer le rootFolder : remonter jusqu'au premier enfant direct de m_root
-            std::string rootFolder = "";
-            PlaylistNode* current = node->parent;
-            while (current && current->parent) {
-                // Si le parent de current est m_root (parent == nullptr), alors current est le rootFolder
-                if (current->parent->parent == nullptr) {
-                    // current->parent est m_root, donc current est le rootFolder
-                    if (current->isFolder) {
-                        rootFolder = current->name;
-                    }
-                    break;
+        // Fichiers de la playlist couverts par le scan : seuls ses changements sont traités
+        std::erase_if(jobs, [&](const IndexingPipeline::Job& job) {
+            auto root = rootPaths.find(job.rootFolder);
+            if (root == rootPaths.end()) return false;
+            const std::string& rootPath = root->second;
+            return job.filepath.size() > rootPath.size() && job.filepath.compare(0, rootPath.size(), rootPath) == 0 &&
+                   (job.filepath[rootPath.size()] == '/' || job.filepath[rootPath.size()] == '\\');
+        });
+        jobs.insert(jobs.end(), std::make_move_iterator(changes.changed.begin()),
+                    std::make_move_iterator(changes.changed.end()));
+        m_databaseTotal = jobs.size();
+        size_t removed = changes.cancelled ? 0 : m_database->removeFiles(changes.removed);
+        
+        // Lecture, analyse et MD5 en parallèle ; les résultats sont appliqués à la base depuis ce thread seul
+        IndexingPipeline pipeline;
+        pipeline.setKnownFiles(std::move(known));
+        if (changes.cancelled) pipeline.cancel();
+        
+        size_t indexed = pipeline.run(jobs,
+            [this](IndexingPipeline::Result& result) {
+                return m_database->indexMetadata(result.job.filepath, result.job.rootFolder, result.metadata);
+            },
+            [this, &pipeline](const std::string& filepath, size_t done, size_t total) {
+                if (m_shouldStopDatabaseThread.load()) {
+                    pipeline.cancel();
+                    return;
                 }
-                current = current->parent;
-            }
-            
-            if (m_database->indexFile(node->filepath, rootFolder)) {
-                indexed++;
-            }
-        }
+                m_databaseCurrent = done;
+                m_databaseProgress = total > 0 ? static_cast<float>(done) / total : 1.0f;
+                
+                std::string statusMsg = "Indexing: " + fs::path(filepath).filename().string();
+                {
+                    std::lock_guard<std::mutex> lock(m_databaseStatusMutex);
+                    m_databaseStatusMessage = statusMsg;
+                }
+                
+                // Mettre à jour l'UI
+                if (m_uiManager) {
+                    m_uiManager->setDatabaseOperationInProgress(true, statusMsg, m_databaseProgress.load());
+                }
+            });
         
-        m_database->save();
+        LOG_INFO("Indexing pipeline: {}", IndexingPipeline::formatStats(pipeline.getStats()));
+        
+        // Rien de changé : pas de réécriture de la base (JSON + instantané)
+        if (indexed > 0 || removed > 0) {
+            m_database->save();
+        }
+        // Journal conservé seulement si tout a été traité : un scan interrompu est repris au prochain
+        if (!pipeline.isCancelled() && !scanner.save(journalPath)) {
+            LOG_WARNING("Failed to write scan journal {}", journalPath);
+        }
         
         m_databaseOperation = DatabaseOperation::None;
         m_databaseProgress = 1.0f;
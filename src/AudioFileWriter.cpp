@@ -0,0 +1,395 @@
+#include "AudioFileWriter.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+
+namespace {
+    // Écriture MSB en premier (ordre des bits FLAC)
+    class BitWriter {
+    public:
+        explicit BitWriter(std::vector<uint8_t>& out) : m_out(out), m_acc(0), m_bits(0) {}
+
+        void put(uint32_t value, int bits) {
+            if (bits == 0) return;
+            uint64_t mask = (bits == 32) ? 0xFFFFFFFFull : ((1ull << bits) - 1);
+            m_acc = (m_acc << bits) | (value & mask);
+            m_bits += bits;
+            while (m_bits >= 8) {
+                m_bits -= 8;
+                m_out.push_back(static_cast<uint8_t>(m_acc >> m_bits));
+            }
+        }
+        void putSigned(int32_t value, int bits) { put(static_cast<uint32_t>(value), bits); }
+        void putRice(uint32_t folded, int k) {
+            uint32_t q = folded >> k;
+            while (q >= 31) { put(0, 31); q -= 31; }
+            put(1, q + 1); // q zéros puis un 1
+            put(folded, k);
+        }
+        void alignToByte() { if (m_bits) put(0, 8 - m_bits); }
+
+    private:
+        std::vector<uint8_t>& m_out;
+        uint64_t m_acc;
+        int m_bits;
+    };
+
+    uint8_t crc8(const uint8_t* data, size_t size) {
+        uint8_t crc = 0;
+        for (size_t i = 0; i < size; ++i) {
+            crc ^= data[i];
+            for (int b = 0; b < 8; ++b) crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+        }
+        return crc;
+    }
+
+    // Table calculée à la compilation : les workers du rendu par lots encodent en parallèle
+    constexpr std::array<uint16_t, 256> CRC16_TABLE = [] {
+        std::array<uint16_t, 256> table{};
+        for (int i = 0; i < 256; ++i) {
+            uint16_t crc = static_cast<uint16_t>(i << 8);
+            for (int b = 0; b < 8; ++b) crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x8005) : static_cast<uint16_t>(crc << 1);
+            table[i] = crc;
+        }
+        return table;
+    }();
+
+    uint16_t crc16(const uint8_t* data, size_t size) {
+        uint16_t crc = 0;
+        for (size_t i = 0; i < size; ++i) crc = static_cast<uint16_t>((crc << 8) ^ CRC16_TABLE[(crc >> 8) ^ data[i]]);
+        return crc;
+    }
+
+    inline uint32_t foldSigned(int32_t value) {
+        return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    }
+
+    const int MAX_FIXED_ORDER = 4;
+    const int MAX_PARTITION_ORDER = 8;
+    const int MAX_RICE_PARAMETER = 14; // 15 = échappement, jamais utilisé
+
+    // Meilleur paramètre de Rice d'une partition (autour de l'estimation log2(moyenne)), coût en bits
+    uint64_t bestRiceParameter(const int32_t* residual, size_t count, int& parameter) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < count; ++i) sum += foldSigned(residual[i]);
+        int estimate = 0;
+        if (count > 0) {
+            uint64_t mean = sum / count;
+            while (estimate < MAX_RICE_PARAMETER && (1ull << (estimate + 1)) <= mean) ++estimate;
+        }
+        uint64_t bestCost = UINT64_MAX;
+        for (int k = std::max(0, estimate - 1); k <= std::min(MAX_RICE_PARAMETER, estimate + 1); ++k) {
+            uint64_t cost = count * static_cast<uint64_t>(k + 1);
+            for (size_t i = 0; i < count; ++i) cost += foldSigned(residual[i]) >> k;
+            if (cost < bestCost) { bestCost = cost; parameter = k; }
+        }
+        return bestCost;
+    }
+
+    void encodeSubframe(BitWriter& bits, const int32_t* samples, int count, std::vector<int32_t>& residual) {
+        // Silence ou signal constant : un seul échantillon
+        if (std::all_of(samples, samples + count, [&](int32_t s) { return s == samples[0]; })) {
+            bits.put(0x00, 8); // padding, type CONSTANT, pas de wasted bits
+            bits.putSigned(samples[0], 16);
+            return;
+        }
+
+        // Ordre du prédicteur fixe minimisant la somme des résidus (différences successives)
+        int order = 0;
+        if (count > MAX_FIXED_ORDER) {
+            uint64_t errorSum[MAX_FIXED_ORDER + 1] = {};
+            for (int i = MAX_FIXED_ORDER; i < count; ++i) {
+                int32_t e0 = samples[i];
+                int32_t e1 = e0 - samples[i - 1];
+                int32_t e2 = e1 - (samples[i - 1] - samples[i - 2]);
+                int32_t e3 = e2 - (samples[i - 1] - 2 * samples[i - 2] + samples[i - 3]);
+                int32_t e4 = e3 - (samples[i - 1] - 3 * samples[i - 2] + 3 * samples[i - 3] - samples[i - 4]);
+                errorSum[0] += std::abs(e0); errorSum[1] += std::abs(e1); errorSum[2] += std::abs(e2);
+                errorSum[3] += std::abs(e3); errorSum[4] += std::abs(e4);
+            }
+            for (int o = 1; o <= MAX_FIXED_ORDER; ++o) {
+                if (errorSum[o] < errorSum[order]) order = o;
+            }
+        }
+
+        residual.resize(count);
+        for (int i = order; i < count; ++i) {
+            switch (order) {
+                case 0: residual[i] = samples[i]; break;
+                case 1: residual[i] = samples[i] - samples[i - 1]; break;
+                case 2: residual[i] = samples[i] - 2 * samples[i - 1] + samples[i - 2]; break;
+                case 3: residual[i] = samples[i] - 3 * samples[i - 1] + 3 * samples[i - 2] - samples[i - 3]; break;
+                default: residual[i] = samples[i] - 4 * samples[i - 1] + 6 * samples[i - 2] - 4 * samples[i - 3] + samples[i - 4]; break;
+            }
+        }
+
+        // Ordre de partition : la première partition contient (taille >> p) - order résidus
+        int bestOrder = 0;
+        uint64_t bestBits = UINT64_MAX;
+        int parameters[1 << MAX_PARTITION_ORDER];
+        int bestParameters[1 << MAX_PARTITION_ORDER];
+        for (int p = 0; p <= MAX_PARTITION_ORDER; ++p) {
+            int partitions = 1 << p;
+            if (count % partitions != 0 || (count >> p) <= order) break;
+            int partitionSize = count >> p;
+            uint64_t total = 0;
+            for (int part = 0; part < partitions; ++part) {
+                int start = (part == 0) ? order : part * partitionSize;
+                int end = (part + 1) * partitionSize;
+                total += 4 + bestRiceParameter(residual.data() + start, end - start, parameters[part]);
+            }
+            if (total < bestBits) {
+                bestBits = total;
+                bestOrder = p;
+                std::copy(parameters, parameters + partitions, bestParameters);
+            }
+        }
+
+        // Verbatim si la prédiction ne fait pas mieux que le PCM brut
+        uint64_t fixedBits = 16ull * order + 6 + bestBits;
+        if (fixedBits >= 16ull * count) {
+            bits.put(0x02, 8); // type VERBATIM
+            for (int i = 0; i < count; ++i) bits.putSigned(samples[i], 16);
+            return;
+        }
+
+        bits.put(0x10 | (order << 1), 8); // type FIXED (001xxx)
+        for (int i = 0; i < order; ++i) bits.putSigned(samples[i], 16);
+        bits.put(0, 2); // Rice à paramètres 4 bits
+        bits.put(bestOrder, 4);
+        int partitionSize = count >> bestOrder;
+        for (int part = 0; part < (1 << bestOrder); ++part) {
+            int start = (part == 0) ? order : part * partitionSize;
+            int end = (part + 1) * partitionSize;
+            bits.put(bestParameters[part], 4);
+            for (int i = start; i < end; ++i) bits.putRice(foldSigned(residual[i]), bestParameters[part]);
+        }
+    }
+
+    void writeLE16(std::ofstream& file, uint16_t value) {
+        char bytes[2] = { static_cast<char>(value & 0xFF), static_cast<char>(value >> 8) };
+        file.write(bytes, 2);
+    }
+
+    void writeLE32(std::ofstream& file, uint32_t value) {
+        char bytes[4] = { static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF),
+                          static_cast<char>((value >> 16) & 0xFF), static_cast<char>(value >> 24) };
+        file.write(bytes, 4);
+    }
+
+    // PCM 16 bits little-endian quel que soit l'hôte (WAV et MD5 FLAC)
+    void toLittleEndian(const int16_t* samples, size_t count, std::vector<uint8_t>& out) {
+        out.resize(count * 2);
+        for (size_t i = 0; i < count; ++i) {
+            uint16_t value = static_cast<uint16_t>(samples[i]);
+            out[i * 2] = static_cast<uint8_t>(value & 0xFF);
+            out[i * 2 + 1] = static_cast<uint8_t>(value >> 8);
+        }
+    }
+}
+
+bool AudioFileWriter::formatFromPath(const std::string& filepath, AudioFileFormat& format) {
+    std::string ext = std::filesystem::path(filepath).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (ext == ".wav") { format = AudioFileFormat::Wav; return true; }
+    if (ext == ".flac") { format = AudioFileFormat::Flac; return true; }
+    if (ext == ".raw" || ext == ".pcm") { format = AudioFileFormat::Raw; return true; }
+    return false;
+}
+
+std::unique_ptr<AudioFileWriter> AudioFileWriter::create(AudioFileFormat format) {
+    if (format == AudioFileFormat::Flac) return std::make_unique<FlacFileWriter>();
+    if (format == AudioFileFormat::Raw) return std::make_unique<RawFileWriter>();
+    return std::make_unique<WavFileWriter>();
+}
+
+// ---------------------------------------------------------------------------
+// WAV
+// ---------------------------------------------------------------------------
+
+WavFileWriter::~WavFileWriter() {
+    if (m_file.is_open()) close();
+}
+
+bool WavFileWriter::open(const std::string& filepath, int sampleRate, int channels) {
+    m_file.open(filepath, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open()) return false;
+    m_channels = channels;
+    m_dataBytes = 0;
+    // En-tête canonique de 44 octets, tailles corrigées à la fermeture
+    m_file.write("RIFF", 4); writeLE32(m_file, 0); m_file.write("WAVE", 4);
+    m_file.write("fmt ", 4); writeLE32(m_file, 16);
+    writeLE16(m_file, 1); // PCM
+    writeLE16(m_file, static_cast<uint16_t>(channels));
+    writeLE32(m_file, static_cast<uint32_t>(sampleRate));
+    writeLE32(m_file, static_cast<uint32_t>(sampleRate * channels * 2));
+    writeLE16(m_file, static_cast<uint16_t>(channels * 2));
+    writeLE16(m_file, 16);
+    m_file.write("data", 4); writeLE32(m_file, 0);
+    return m_file.good();
+}
+
+bool WavFileWriter::write(const int16_t* samples, size_t frames) {
+    static thread_local std::vector<uint8_t> bytes;
+    toLittleEndian(samples, frames * m_channels, bytes);
+    m_file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    m_dataBytes += bytes.size();
+    return m_file.good();
+}
+
+bool WavFileWriter::close() {
+    if (!m_file.is_open()) return false;
+    uint32_t dataBytes = static_cast<uint32_t>(std::min<uint64_t>(m_dataBytes, 0xFFFFFFFFull - 36));
+    m_file.seekp(4); writeLE32(m_file, 36 + dataBytes);
+    m_file.seekp(40); writeLE32(m_file, dataBytes);
+    bool ok = m_file.good();
+    m_file.close();
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Brut
+// ---------------------------------------------------------------------------
+
+RawFileWriter::~RawFileWriter() {
+    if (m_file.is_open()) close();
+}
+
+bool RawFileWriter::open(const std::string& filepath, int /*sampleRate*/, int channels) {
+    m_file.open(filepath, std::ios::binary | std::ios::trunc);
+    m_channels = channels;
+    return m_file.is_open();
+}
+
+bool RawFileWriter::write(const int16_t* samples, size_t frames) {
+    static thread_local std::vector<uint8_t> bytes;
+    toLittleEndian(samples, frames * m_channels, bytes);
+    m_file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    return m_file.good();
+}
+
+bool RawFileWriter::close() {
+    if (!m_file.is_open()) return false;
+    m_file.flush();
+    bool ok = m_file.good();
+    m_file.close();
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// FLAC
+// ---------------------------------------------------------------------------
+
+FlacFileWriter::~FlacFileWriter() {
+    if (m_file.is_open()) close();
+}
+
+bool FlacFileWriter::open(const std::string& filepath, int sampleRate, int channels) {
+    if (channels < 1 || channels > 8 || sampleRate <= 0 || sampleRate >= (1 << 20)) return false;
+    m_file.open(filepath, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open()) return false;
+    m_sampleRate = sampleRate;
+    m_channels = channels;
+    m_totalFrames = 0;
+    m_frameNumber = 0;
+    m_minFrameBytes = 0;
+    m_maxFrameBytes = 0;
+    m_pending.clear();
+    m_pending.reserve(BLOCK_SIZE * channels);
+    m_md5.reset();
+    m_file.write("fLaC", 4);
+    writeStreamInfo(false); // Provisoire : réécrit à la fermeture
+    return m_file.good();
+}
+
+bool FlacFileWriter::write(const int16_t* samples, size_t frames) {
+    static thread_local std::vector<uint8_t> bytes;
+    toLittleEndian(samples, frames * m_channels, bytes);
+    m_md5.update(bytes.data(), bytes.size());
+    m_totalFrames += frames;
+
+    size_t blockSamples = static_cast<size_t>(BLOCK_SIZE) * m_channels;
+    size_t offset = 0;
+    size_t total = frames * m_channels;
+    while (offset < total) {
+        size_t take = std::min(blockSamples - m_pending.size(), total - offset);
+        m_pending.insert(m_pending.end(), samples + offset, samples + offset + take);
+        offset += take;
+        if (m_pending.size() == blockSamples && !encodeFrame(BLOCK_SIZE)) return false;
+    }
+    return m_file.good();
+}
+
+bool FlacFileWriter::encodeFrame(size_t frames) {
+    m_frameBytes.clear();
+    BitWriter bits(m_frameBytes);
+    // En-tête : synchro + stratégie fixe, taille du bloc sur 16 bits en fin d'en-tête,
+    // fréquence lue dans STREAMINFO, canaux indépendants, 16 bits par échantillon
+    bits.put(0xFFF8, 16);
+    bits.put(0x70, 8);
+    bits.put(((m_channels - 1) << 4) | (0x4 << 1), 8);
+    // Numéro de trame codé "UTF-8"
+    uint32_t number = m_frameNumber++;
+    if (number < 0x80) {
+        bits.put(number, 8);
+    } else {
+        int continuation = 1;
+        while (continuation < 6 && number >= (1u << (6 + 5 * continuation))) ++continuation;
+        uint32_t lead = (0xFF00u >> (continuation + 1)) & 0xFF;
+        bits.put(lead | (number >> (6 * continuation)), 8);
+        for (int c = continuation - 1; c >= 0; --c) bits.put(0x80 | ((number >> (6 * c)) & 0x3F), 8);
+    }
+    bits.put(static_cast<uint32_t>(frames - 1), 16);
+    bits.put(crc8(m_frameBytes.data(), m_frameBytes.size()), 8);
+
+    m_channel.resize(frames);
+    for (int c = 0; c < m_channels; ++c) {
+        for (size_t i = 0; i < frames; ++i) m_channel[i] = m_pending[i * m_channels + c];
+        encodeSubframe(bits, m_channel.data(), static_cast<int>(frames), m_residual);
+    }
+    bits.alignToByte();
+    uint16_t crc = crc16(m_frameBytes.data(), m_frameBytes.size());
+    m_frameBytes.push_back(static_cast<uint8_t>(crc >> 8));
+    m_frameBytes.push_back(static_cast<uint8_t>(crc & 0xFF));
+
+    uint32_t size = static_cast<uint32_t>(m_frameBytes.size());
+    m_minFrameBytes = (m_minFrameBytes == 0) ? size : std::min(m_minFrameBytes, size);
+    m_maxFrameBytes = std::max(m_maxFrameBytes, size);
+    m_file.write(reinterpret_cast<const char*>(m_frameBytes.data()), m_frameBytes.size());
+    m_pending.clear();
+    return m_file.good();
+}
+
+void FlacFileWriter::writeStreamInfo(bool final) {
+    std::vector<uint8_t> block;
+    BitWriter bits(block);
+    bits.put(0x80, 8);  // Dernier bloc de métadonnées, type STREAMINFO
+    bits.put(34, 24);
+    bits.put(BLOCK_SIZE, 16);
+    bits.put(BLOCK_SIZE, 16);
+    bits.put(m_minFrameBytes, 24);
+    bits.put(m_maxFrameBytes, 24);
+    bits.put(static_cast<uint32_t>(m_sampleRate), 20);
+    bits.put(static_cast<uint32_t>(m_channels - 1), 3);
+    bits.put(15, 5);    // 16 bits par échantillon
+    bits.put(static_cast<uint32_t>(m_totalFrames >> 32) & 0xF, 4);
+    bits.put(static_cast<uint32_t>(m_totalFrames), 32);
+    m_file.write(reinterpret_cast<const char*>(block.data()), block.size());
+    unsigned char digest[16] = {};
+    if (final) m_md5.getDigest(digest);
+    m_file.write(reinterpret_cast<const char*>(digest), 16);
+}
+
+bool FlacFileWriter::close() {
+    if (!m_file.is_open()) return false;
+    size_t pendingFrames = m_pending.size() / m_channels;
+    if (pendingFrames > 0) encodeFrame(pendingFrames);
+    m_md5.finalize();
+    m_file.seekp(4);
+    writeStreamInfo(true);
+    bool ok = m_file.good();
+    m_file.close();
+    return ok;
+}
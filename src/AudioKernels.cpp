@@ -0,0 +1,430 @@
+#include "AudioKernels.h"
+#include <algorithm>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define IMSID_ARCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64) || (defined(__ARM_NEON) && defined(__arm__))
+#define IMSID_ARCH_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Sous GCC/Clang, les fonctions AVX2 sont compilées avec l'attribut target
+// (pas besoin de -mavx2 global : le binaire reste exécutable sur un CPU sans AVX2)
+#if defined(IMSID_ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+#define IMSID_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define IMSID_TARGET_AVX2
+#endif
+
+namespace imsid {
+namespace audio {
+
+// Un échantillon de rampe : troncature puis saturation, comme cvtt + packs côté SIMD
+static inline int16_t applyGain(int16_t sample, float gain) {
+    return static_cast<int16_t>(std::clamp(sample * gain, -32768.0f, 32767.0f));
+}
+
+// ============================================================================
+// Références scalaires
+// ============================================================================
+
+namespace scalar {
+
+void mixSaturate3(const int16_t* a, const int16_t* b, const int16_t* c, int16_t* out, int count) {
+    for (int i = 0; i < count; ++i) {
+        int32_t sum = static_cast<int32_t>(a[i]) + static_cast<int32_t>(b[i]) + static_cast<int32_t>(c[i]);
+        out[i] = static_cast<int16_t>(std::clamp(sum, -32768, 32767));
+    }
+}
+
+void applyGainRamp(int16_t* buf, int count, float gainStart, float gainStep) {
+    for (int i = 0; i < count; ++i) {
+        float gain = gainStart + gainStep * static_cast<float>(i);
+        buf[i] = applyGain(buf[i], gain);
+    }
+}
+
+void int16ToFloat(const int16_t* in, float* out, int count) {
+    for (int i = 0; i < count; ++i) {
+        out[i] = in[i] / 32768.0f;
+    }
+}
+
+float dotProduct(const float* a, const float* b, int count) {
+    float sum = 0.0f;
+    for (int i = 0; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+} // namespace scalar
+
+// ============================================================================
+// SSE2 / AVX2
+// ============================================================================
+
+#ifdef IMSID_ARCH_X86
+
+namespace sse2 {
+
+// Étendre 8 int16 en deux vecteurs de 4 int32 (avec signe)
+static inline void widen(__m128i v, __m128i& lo, __m128i& hi) {
+    lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+}
+
+void mixSaturate3(const int16_t* a, const int16_t* b, const int16_t* c, int16_t* out, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        __m128i vc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + i));
+        __m128i aLo, aHi, bLo, bHi, cLo, cHi;
+        widen(va, aLo, aHi); widen(vb, bLo, bHi); widen(vc, cLo, cHi);
+        __m128i sumLo = _mm_add_epi32(_mm_add_epi32(aLo, bLo), cLo);
+        __m128i sumHi = _mm_add_epi32(_mm_add_epi32(aHi, bHi), cHi);
+        // packs_epi32 sature vers int16
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(sumLo, sumHi));
+    }
+    scalar::mixSaturate3(a + i, b + i, c + i, out + i, count - i);
+}
+
+void applyGainRamp(int16_t* buf, int count, float gainStart, float gainStep) {
+    int i = 0;
+    const __m128 lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 step = _mm_set1_ps(gainStep);
+    const __m128 start = _mm_set1_ps(gainStart);
+    for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + i));
+        __m128i lo, hi;
+        widen(v, lo, hi);
+        __m128 idxLo = _mm_add_ps(_mm_set1_ps(static_cast<float>(i)), lane);
+        __m128 idxHi = _mm_add_ps(_mm_set1_ps(static_cast<float>(i + 4)), lane);
+        __m128 gainLo = _mm_add_ps(start, _mm_mul_ps(step, idxLo));
+        __m128 gainHi = _mm_add_ps(start, _mm_mul_ps(step, idxHi));
+        __m128i rLo = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(lo), gainLo));
+        __m128i rHi = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(hi), gainHi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buf + i), _mm_packs_epi32(rLo, rHi));
+    }
+    // Queue : continuer la rampe à partir de l'index i
+    for (; i < count; ++i) {
+        float gain = gainStart + gainStep * static_cast<float>(i);
+        buf[i] = applyGain(buf[i], gain);
+    }
+}
+
+void int16ToFloat(const int16_t* in, float* out, int count) {
+    int i = 0;
+    const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+    for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i lo, hi;
+        widen(v, lo, hi);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+    scalar::int16ToFloat(in + i, out + i, count - i);
+}
+
+// Somme horizontale des 4 lanes
+static inline float horizontalSum(__m128 v) {
+    __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+}
+
+float dotProduct(const float* a, const float* b, int count) {
+    int i = 0;
+    // Deux accumulateurs : masque la latence de l'addition
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (; i + 8 <= count; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    return horizontalSum(_mm_add_ps(acc0, acc1)) + scalar::dotProduct(a + i, b + i, count - i);
+}
+
+} // namespace sse2
+
+namespace avx2 {
+
+IMSID_TARGET_AVX2
+void mixSaturate3(const int16_t* a, const int16_t* b, const int16_t* c, int16_t* out, int count) {
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 8));
+        __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 8));
+        __m128i c0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + i));
+        __m128i c1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + i + 8));
+        __m256i sum0 = _mm256_add_epi32(_mm256_add_epi32(_mm256_cvtepi16_epi32(a0), _mm256_cvtepi16_epi32(b0)), _mm256_cvtepi16_epi32(c0));
+        __m256i sum1 = _mm256_add_epi32(_mm256_add_epi32(_mm256_cvtepi16_epi32(a1), _mm256_cvtepi16_epi32(b1)), _mm256_cvtepi16_epi32(c1));
+        // packs travaille par lane de 128 bits : remettre les quadwords dans l'ordre
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(sum0, sum1), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+    }
+    sse2::mixSaturate3(a + i, b + i, c + i, out + i, count - i);
+}
+
+IMSID_TARGET_AVX2
+void applyGainRamp(int16_t* buf, int count, float gainStart, float gainStep) {
+    int i = 0;
+    const __m256 lane = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+    const __m256 step = _mm256_set1_ps(gainStep);
+    const __m256 start = _mm256_set1_ps(gainStart);
+    for (; i + 16 <= count; i += 16) {
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + i));
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + i + 8));
+        __m256 idx0 = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(i)), lane);
+        __m256 idx1 = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(i + 8)), lane);
+        __m256 gain0 = _mm256_add_ps(start, _mm256_mul_ps(step, idx0));
+        __m256 gain1 = _mm256_add_ps(start, _mm256_mul_ps(step, idx1));
+        __m256i r0 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v0)), gain0));
+        __m256i r1 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v1)), gain1));
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(r0, r1), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(buf + i), packed);
+    }
+    for (; i < count; ++i) {
+        float gain = gainStart + gainStep * static_cast<float>(i);
+        buf[i] = applyGain(buf[i], gain);
+    }
+}
+
+IMSID_TARGET_AVX2
+void int16ToFloat(const int16_t* in, float* out, int count) {
+    int i = 0;
+    const __m256 scale = _mm256_set1_ps(1.0f / 32768.0f);
+    for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v)), scale));
+    }
+    scalar::int16ToFloat(in + i, out + i, count - i);
+}
+
+IMSID_TARGET_AVX2
+float dotProduct(const float* a, const float* b, int count) {
+    int i = 0;
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    for (; i + 16 <= count; i += 16) {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+    }
+    __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    return sse2::horizontalSum(sum) + sse2::dotProduct(a + i, b + i, count - i);
+}
+
+} // namespace avx2
+
+static bool cpuHasAvx2() {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+#endif // IMSID_ARCH_X86
+
+// ============================================================================
+// NEON
+// ============================================================================
+
+#ifdef IMSID_ARCH_NEON
+
+namespace neon {
+
+void mixSaturate3(const int16_t* a, const int16_t* b, const int16_t* c, int16_t* out, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t va = vld1q_s16(a + i);
+        int16x8_t vb = vld1q_s16(b + i);
+        int16x8_t vc = vld1q_s16(c + i);
+        int32x4_t lo = vaddw_s16(vaddl_s16(vget_low_s16(va), vget_low_s16(vb)), vget_low_s16(vc));
+        int32x4_t hi = vaddw_s16(vaddl_s16(vget_high_s16(va), vget_high_s16(vb)), vget_high_s16(vc));
+        // vqmovn sature vers int16
+        vst1q_s16(out + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+    }
+    scalar::mixSaturate3(a + i, b + i, c + i, out + i, count - i);
+}
+
+void applyGainRamp(int16_t* buf, int count, float gainStart, float gainStep) {
+    int i = 0;
+    const float laneInit[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+    const float32x4_t lane = vld1q_f32(laneInit);
+    const float32x4_t step = vdupq_n_f32(gainStep);
+    const float32x4_t start = vdupq_n_f32(gainStart);
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t v = vld1q_s16(buf + i);
+        float32x4_t idxLo = vaddq_f32(vdupq_n_f32(static_cast<float>(i)), lane);
+        float32x4_t idxHi = vaddq_f32(vdupq_n_f32(static_cast<float>(i + 4)), lane);
+        float32x4_t gainLo = vaddq_f32(start, vmulq_f32(step, idxLo));
+        float32x4_t gainHi = vaddq_f32(start, vmulq_f32(step, idxHi));
+        int32x4_t rLo = vcvtq_s32_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), gainLo));
+        int32x4_t rHi = vcvtq_s32_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), gainHi));
+        vst1q_s16(buf + i, vcombine_s16(vqmovn_s32(rLo), vqmovn_s32(rHi)));
+    }
+    for (; i < count; ++i) {
+        float gain = gainStart + gainStep * static_cast<float>(i);
+        buf[i] = applyGain(buf[i], gain);
+    }
+}
+
+void int16ToFloat(const int16_t* in, float* out, int count) {
+    int i = 0;
+    const float32x4_t scale = vdupq_n_f32(1.0f / 32768.0f);
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t v = vld1q_s16(in + i);
+        vst1q_f32(out + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), scale));
+        vst1q_f32(out + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), scale));
+    }
+    scalar::int16ToFloat(in + i, out + i, count - i);
+}
+
+float dotProduct(const float* a, const float* b, int count) {
+    int i = 0;
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    for (; i + 8 <= count; i += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    float32x4_t acc = vaddq_f32(acc0, acc1);
+    float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    return vget_lane_f32(vpadd_f32(pair, pair), 0) + scalar::dotProduct(a + i, b + i, count - i);
+}
+
+} // namespace neon
+
+#endif // IMSID_ARCH_NEON
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+namespace {
+
+struct KernelTable {
+    void (*mixSaturate3)(const int16_t*, const int16_t*, const int16_t*, int16_t*, int);
+    void (*applyGainRamp)(int16_t*, int, float, float);
+    void (*int16ToFloat)(const int16_t*, float*, int);
+    float (*dotProduct)(const float*, const float*, int);
+};
+
+const KernelTable SCALAR_TABLE = { scalar::mixSaturate3, scalar::applyGainRamp, scalar::int16ToFloat, scalar::dotProduct };
+#ifdef IMSID_ARCH_X86
+const KernelTable SSE2_TABLE = { sse2::mixSaturate3, sse2::applyGainRamp, sse2::int16ToFloat, sse2::dotProduct };
+const KernelTable AVX2_TABLE = { avx2::mixSaturate3, avx2::applyGainRamp, avx2::int16ToFloat, avx2::dotProduct };
+#endif
+#ifdef IMSID_ARCH_NEON
+const KernelTable NEON_TABLE = { neon::mixSaturate3, neon::applyGainRamp, neon::int16ToFloat, neon::dotProduct };
+#endif
+
+const KernelTable* tableFor(KernelPath path) {
+    switch (path) {
+#ifdef IMSID_ARCH_X86
+        case KernelPath::SSE2: return &SSE2_TABLE;
+        case KernelPath::AVX2: return &AVX2_TABLE;
+#endif
+#ifdef IMSID_ARCH_NEON
+        case KernelPath::NEON: return &NEON_TABLE;
+#endif
+        default: return &SCALAR_TABLE;
+    }
+}
+
+KernelPath detectBestPath() {
+#ifdef IMSID_ARCH_X86
+    return cpuHasAvx2() ? KernelPath::AVX2 : KernelPath::SSE2;
+#elif defined(IMSID_ARCH_NEON)
+    return KernelPath::NEON;
+#else
+    return KernelPath::Scalar;
+#endif
+}
+
+// Chemin actif : détecté une fois (statique local thread-safe), modifiable par setKernelPath()
+std::atomic<KernelPath>& activePath() {
+    static std::atomic<KernelPath> path(detectBestPath());
+    return path;
+}
+
+inline const KernelTable& activeTable() {
+    return *tableFor(activePath().load(std::memory_order_relaxed));
+}
+
+} // namespace
+
+void mixSaturate3(const int16_t* a, const int16_t* b, const int16_t* c, int16_t* out, int count) {
+    activeTable().mixSaturate3(a, b, c, out, count);
+}
+
+void applyGainRamp(int16_t* buf, int count, float gainStart, float gainStep) {
+    activeTable().applyGainRamp(buf, count, gainStart, gainStep);
+}
+
+void int16ToFloat(const int16_t* in, float* out, int count) {
+    activeTable().int16ToFloat(in, out, count);
+}
+
+float dotProduct(const float* a, const float* b, int count) {
+    return activeTable().dotProduct(a, b, count);
+}
+
+KernelPath getKernelPath() {
+    return activePath().load(std::memory_order_relaxed);
+}
+
+bool isKernelPathSupported(KernelPath path) {
+    switch (path) {
+        case KernelPath::Scalar: return true;
+#ifdef IMSID_ARCH_X86
+        case KernelPath::SSE2: return true;
+        case KernelPath::AVX2: return cpuHasAvx2();
+#endif
+#ifdef IMSID_ARCH_NEON
+        case KernelPath::NEON: return true;
+#endif
+        default: return false;
+    }
+}
+
+bool setKernelPath(KernelPath path) {
+    if (!isKernelPathSupported(path)) return false;
+    activePath().store(path, std::memory_order_relaxed);
+    return true;
+}
+
+const char* kernelPathName(KernelPath path) {
+    switch (path) {
+        case KernelPath::Scalar: return "Scalar";
+        case KernelPath::SSE2: return "SSE2";
+        case KernelPath::AVX2: return "AVX2";
+        case KernelPath::NEON: return "NEON";
+    }
+    return "Unknown";
+}
+
+} // namespace audio
+} // namespace imsid
@@ -0,0 +1,187 @@
+#include "AudioSink.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+std::unique_ptr<AudioSink> AudioSink::create(AudioSinkType type, const std::string& outputPath) {
+    switch (type) {
+        case AudioSinkType::Null: return std::make_unique<NullAudioSink>();
+        case AudioSinkType::File: return std::make_unique<FileAudioSink>(outputPath);
+        case AudioSinkType::Sdl: break;
+    }
+    return std::make_unique<SdlAudioSink>();
+}
+
+bool AudioSink::typeFromName(const std::string& name, AudioSinkType& type) {
+    if (name == "sdl") { type = AudioSinkType::Sdl; return true; }
+    if (name == "null") { type = AudioSinkType::Null; return true; }
+    if (name == "file") { type = AudioSinkType::File; return true; }
+    return false;
+}
+
+const char* AudioSink::typeName(AudioSinkType type) {
+    switch (type) {
+        case AudioSinkType::Null: return "null";
+        case AudioSinkType::File: return "file";
+        case AudioSinkType::Sdl: break;
+    }
+    return "sdl";
+}
+
+// ---------------------------------------------------------------------------
+// SDL
+// ---------------------------------------------------------------------------
+
+SdlAudioSink::~SdlAudioSink() {
+    close();
+}
+
+bool SdlAudioSink::open(const AudioSinkFormat& desired, AudioSinkFormat& obtained, Callback callback, void* userdata) {
+    close();
+    // Sous-système compté par SDL : sans effet si l'application l'a déjà initialisé
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+        m_lastError = SDL_GetError();
+        return false;
+    }
+    m_callback = callback;
+    m_userdata = userdata;
+    SDL_AudioSpec want, have;
+    SDL_zero(want);
+    want.freq = desired.sampleRate; want.format = AUDIO_S16SYS; want.channels = static_cast<Uint8>(desired.channels);
+    want.samples = static_cast<Uint16>(desired.bufferFrames);
+    want.callback = sdlCallback; want.userdata = this;
+    // Le périphérique peut imposer une autre taille de buffer : le rendu par blocs s'y adapte
+    m_device = SDL_OpenAudioDevice(nullptr, 0, &want, &have, SDL_AUDIO_ALLOW_SAMPLES_CHANGE);
+    if (m_device == 0) {
+        m_lastError = SDL_GetError();
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return false;
+    }
+    m_channels = have.channels;
+    obtained.sampleRate = have.freq;
+    obtained.channels = have.channels;
+    obtained.bufferFrames = have.samples;
+    return true;
+}
+
+void SdlAudioSink::close() {
+    if (m_device == 0) return;
+    SDL_CloseAudioDevice(m_device);
+    m_device = 0;
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+}
+
+void SdlAudioSink::pause(bool paused) {
+    if (m_device != 0) SDL_PauseAudioDevice(m_device, paused ? 1 : 0);
+}
+
+void SdlAudioSink::sdlCallback(void* userdata, Uint8* stream, int len) {
+    SdlAudioSink* sink = static_cast<SdlAudioSink*>(userdata);
+    int frames = len / static_cast<int>(sizeof(int16_t) * sink->m_channels);
+    sink->m_callback(sink->m_userdata, reinterpret_cast<int16_t*>(stream), frames);
+}
+
+// ---------------------------------------------------------------------------
+// Sorties cadencées (null, fichier)
+// ---------------------------------------------------------------------------
+
+ClockedAudioSink::~ClockedAudioSink() {
+    close();
+}
+
+bool ClockedAudioSink::open(const AudioSinkFormat& desired, AudioSinkFormat& obtained, Callback callback, void* userdata) {
+    close();
+    m_format = desired;
+    m_format.sampleRate = std::max(1, desired.sampleRate);
+    m_format.channels = std::max(1, desired.channels);
+    m_format.bufferFrames = std::max(1, desired.bufferFrames);
+    if (!openOutput(m_format)) return false;
+    m_callback = callback;
+    m_userdata = userdata;
+    m_buffer.assign(static_cast<size_t>(m_format.bufferFrames) * m_format.channels, 0);
+    m_running = true;
+    m_paused = true;
+    m_thread = std::thread(&ClockedAudioSink::clockLoop, this);
+    obtained = m_format;
+    return true;
+}
+
+void ClockedAudioSink::close() {
+    if (!m_thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+    closeOutput();
+}
+
+void ClockedAudioSink::pause(bool paused) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_paused = paused;
+    }
+    m_condition.notify_all();
+    if (paused) {
+        // Comme SDL : au retour de pause(true), aucun callback n'est en cours
+        std::lock_guard<std::mutex> callbackLock(m_callbackMutex);
+    }
+}
+
+void ClockedAudioSink::clockLoop() {
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::nanoseconds(static_cast<int64_t>(m_format.bufferFrames) * 1000000000LL / m_format.sampleRate));
+    Clock::time_point deadline = Clock::now();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_running) {
+        if (m_paused) {
+            m_condition.wait(lock, [this] { return !m_running || !m_paused; });
+            deadline = Clock::now(); // Reprise : pas de rattrapage des périodes passées en pause
+            continue;
+        }
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> callbackLock(m_callbackMutex);
+            m_callback(m_userdata, m_buffer.data(), m_format.bufferFrames);
+        }
+        consume(m_buffer.data(), m_format.bufferFrames);
+        lock.lock();
+        // Échéances absolues ; après un gros retard (machine suspendue), repartir de maintenant
+        deadline += period;
+        Clock::time_point now = Clock::now();
+        if (now - deadline > period * 4) deadline = now;
+        m_condition.wait_until(lock, deadline, [this] { return !m_running || m_paused; });
+    }
+}
+
+bool FileAudioSink::openOutput(const AudioSinkFormat& format) {
+    AudioFileFormat fileFormat;
+    if (!AudioFileWriter::formatFromPath(m_outputPath, fileFormat)) {
+        m_lastError = "Unsupported output format (expected .wav, .flac or .raw): " + m_outputPath;
+        return false;
+    }
+    m_writer = AudioFileWriter::create(fileFormat);
+    if (!m_writer->open(m_outputPath, format.sampleRate, format.channels)) {
+        m_lastError = "Cannot write " + m_outputPath;
+        m_writer.reset();
+        return false;
+    }
+    m_writeFailed = false;
+    return true;
+}
+
+void FileAudioSink::consume(const int16_t* samples, int frames) {
+    if (m_writeFailed || !m_writer) return;
+    // Disque plein ou fichier retiré : on continue à cadencer sans écrire (erreur signalée à la fermeture)
+    if (!m_writer->write(samples, static_cast<size_t>(frames))) m_writeFailed = true;
+}
+
+void FileAudioSink::closeOutput() {
+    if (!m_writer) return;
+    bool closed = m_writer->close();
+    if (m_writeFailed) m_lastError = "Write error on " + m_outputPath;
+    else if (!closed) m_lastError = "Cannot finalize " + m_outputPath;
+    m_writer.reset();
+}
@@ -0,0 +1,138 @@
+#include "AudioTimingStats.h"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+
+namespace {
+    const char* const STAGE_NAMES[AudioTimingStats::STAGE_COUNT] = {
+        "Master", "Voices", "Crossfade", "Post", "Resample", "Block", "Callback"
+    };
+
+    // Percentile estimé par la borne haute du seau qui le contient (plafonnée au maximum observé)
+    double percentileUs(const uint64_t* buckets, uint64_t count, double fraction, double maxUs) {
+        uint64_t target = static_cast<uint64_t>(fraction * (count - 1)) + 1;
+        uint64_t seen = 0;
+        for (int b = 0; b < AudioTimingStats::BUCKETS; ++b) {
+            seen += buckets[b];
+            if (seen >= target) {
+                if (b + 1 >= AudioTimingStats::BUCKETS) return maxUs;
+                return std::min(static_cast<double>(AudioTimingStats::bucketLowerUs(b + 1)), maxUs);
+            }
+        }
+        return maxUs;
+    }
+}
+
+AudioTimingStats::AudioTimingStats()
+    : m_callbackBudgetNs(0), m_blockBudgetNs(0), m_underruns(0), m_lateCallbacks(0), m_overruns(0) {
+    reset();
+}
+
+const char* AudioTimingStats::stageName(int stage) {
+    return (stage >= 0 && stage < STAGE_COUNT) ? STAGE_NAMES[stage] : "?";
+}
+
+int AudioTimingStats::bucketIndex(int64_t us) {
+    if (us < 4) return static_cast<int>(std::max<int64_t>(us, 0));
+    int msb = std::bit_width(static_cast<uint64_t>(us)) - 1;
+    int sub = static_cast<int>((us >> (msb - 2)) & 3);
+    return std::min((msb - 1) * 4 + sub, BUCKETS - 1);
+}
+
+int64_t AudioTimingStats::bucketLowerUs(int bucket) {
+    if (bucket < 4) return bucket;
+    int msb = bucket / 4 + 1;
+    return static_cast<int64_t>(4 + bucket % 4) << (msb - 2);
+}
+
+void AudioTimingStats::setBudgets(int64_t callbackPeriodNs, int64_t blockPeriodNs) {
+    m_callbackBudgetNs.store(callbackPeriodNs, std::memory_order_relaxed);
+    m_blockBudgetNs.store(blockPeriodNs, std::memory_order_relaxed);
+}
+
+void AudioTimingStats::record(int stage, int64_t ns) {
+    StageData& data = m_stages[stage];
+    data.buckets[bucketIndex(ns / 1000)].fetch_add(1, std::memory_order_relaxed);
+    data.count.fetch_add(1, std::memory_order_relaxed);
+    data.totalNs.fetch_add(static_cast<uint64_t>(std::max<int64_t>(ns, 0)), std::memory_order_relaxed);
+    // Un seul écrivain par étape : pas besoin de boucle compare-exchange
+    if (ns > data.maxNs.load(std::memory_order_relaxed)) data.maxNs.store(ns, std::memory_order_relaxed);
+    if (stage == STAGE_BLOCK) {
+        int64_t budget = m_blockBudgetNs.load(std::memory_order_relaxed);
+        if (budget > 0 && ns > budget) m_overruns.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AudioTimingStats::recordCallback(int64_t ns, int64_t intervalNs) {
+    record(STAGE_CALLBACK, ns);
+    int64_t budget = m_callbackBudgetNs.load(std::memory_order_relaxed);
+    if (budget > 0 && (ns > budget || intervalNs > budget + budget / 2)) {
+        m_lateCallbacks.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+uint64_t AudioTimingStats::getBucketCount(int stage, int bucket) const {
+    return m_stages[stage].buckets[bucket].load(std::memory_order_relaxed);
+}
+
+AudioTimingStats::Summary AudioTimingStats::getSummary(int stage) const {
+    const StageData& data = m_stages[stage];
+    uint64_t buckets[BUCKETS];
+    uint64_t count = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+        buckets[b] = data.buckets[b].load(std::memory_order_relaxed);
+        count += buckets[b];
+    }
+    Summary summary;
+    if (count == 0) return summary;
+    // Compte dérivé de l'histogramme copié : percentiles cohérents malgré les écritures concurrentes
+    summary.count = count;
+    uint64_t recorded = std::max<uint64_t>(1, data.count.load(std::memory_order_relaxed));
+    summary.meanUs = data.totalNs.load(std::memory_order_relaxed) / 1000.0 / recorded;
+    summary.maxUs = data.maxNs.load(std::memory_order_relaxed) / 1000.0;
+    summary.p50Us = percentileUs(buckets, count, 0.50, summary.maxUs);
+    summary.p99Us = percentileUs(buckets, count, 0.99, summary.maxUs);
+    return summary;
+}
+
+void AudioTimingStats::reset() {
+    for (StageData& data : m_stages) {
+        for (std::atomic<uint64_t>& bucket : data.buckets) bucket.store(0, std::memory_order_relaxed);
+        data.count.store(0, std::memory_order_relaxed);
+        data.totalNs.store(0, std::memory_order_relaxed);
+        data.maxNs.store(0, std::memory_order_relaxed);
+    }
+    m_underruns.store(0, std::memory_order_relaxed);
+    m_lateCallbacks.store(0, std::memory_order_relaxed);
+    m_overruns.store(0, std::memory_order_relaxed);
+}
+
+bool AudioTimingStats::appendReport(const std::string& path, const std::string& context) const {
+    std::ofstream file(path, std::ios::app);
+    if (!file.is_open()) return false;
+    char line[160];
+    std::time_t now = std::time(nullptr);
+    std::strftime(line, sizeof(line), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
+    file << "=== Audio timing " << line << " ===\n" << context << "\n";
+    std::snprintf(line, sizeof(line), "Budgets: callback %.1f us, block %.1f us\n",
+                  getCallbackBudgetNs() / 1000.0, getBlockBudgetNs() / 1000.0);
+    file << line;
+    file << "Underruns: " << getUnderruns() << ", late callbacks: " << getLateCallbacks()
+         << ", block overruns: " << getOverruns() << "\n";
+    for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+        Summary summary = getSummary(stage);
+        if (summary.count == 0) continue;
+        std::snprintf(line, sizeof(line), "%-10s n=%llu mean=%.1f p50<=%.0f p99<=%.0f max=%.1f us\n", stageName(stage),
+                      static_cast<unsigned long long>(summary.count), summary.meanUs, summary.p50Us, summary.p99Us, summary.maxUs);
+        file << line;
+        for (int b = 0; b < BUCKETS; ++b) {
+            uint64_t n = getBucketCount(stage, b);
+            if (n == 0) continue;
+            file << "    [" << bucketLowerUs(b) << ", " << bucketLowerUs(b + 1) << ") us: " << n << "\n";
+        }
+    }
+    file << "\n";
+    return file.good();
+}
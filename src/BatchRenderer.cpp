@@ -0,0 +1,305 @@
+#include "BatchRenderer.h"
+#include "Config.h"
+#include "DatabaseManager.h"
+#include "SongLengthDB.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+namespace {
+    // "tune_01.flac" -> "tune_01.part.flac" (l'extension détermine toujours le format)
+    std::string partialPath(const std::string& outputPath) {
+        fs::path path(outputPath);
+        std::string extension = path.extension().string();
+        return path.replace_extension(".part" + extension).string();
+    }
+
+    // Sorties déjà rendues lors d'une exécution précédente (lignes "done\t<sortie>\t...")
+    std::unordered_set<std::string> loadCompletedOutputs(const std::string& manifestPath) {
+        std::unordered_set<std::string> completed;
+        if (manifestPath.empty()) return completed;
+        std::ifstream file(manifestPath);
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream fields(line);
+            std::string status, output;
+            if (std::getline(fields, status, '\t') && std::getline(fields, output, '\t') && status == "done") {
+                completed.insert(output);
+            }
+        }
+        return completed;
+    }
+}
+
+void BatchRenderer::appendJobs(const RootFolderEntry& root, const fs::path& outputDir, AudioFileFormat format,
+                               std::vector<BatchRenderJob>& jobs) {
+    const char* extension = (format == AudioFileFormat::Flac) ? ".flac" : ".wav";
+    fs::path rootPath(root.rootPath);
+    for (const SidMetadata& meta : root.sidList) {
+        fs::path file(meta.filepath);
+        fs::path absolute = file.is_relative() ? rootPath / file : file;
+        fs::path relative = file.is_relative() ? file : file.lexically_relative(rootPath);
+        if (relative.empty() || *relative.begin() == "..") relative = file.filename();
+        std::string base = (outputDir / root.rootFolder / relative.parent_path() / relative.stem()).string();
+
+        int songs = std::max(1, meta.numberOfSongs);
+        for (int song = 1; song <= songs; ++song) {
+            BatchRenderJob job;
+            job.inputPath = absolute.string();
+            std::ostringstream name;
+            name << base << "_" << std::setw(songs > 99 ? 3 : 2) << std::setfill('0') << song << extension;
+            job.outputPath = name.str();
+            job.song = song;
+            // Durée déjà connue à l'indexation : évite de recalculer le MD5 du fichier à chaque subsong
+            if (static_cast<size_t>(song - 1) < meta.songLengths.size()) job.durationSeconds = meta.songLengths[song - 1];
+            jobs.push_back(std::move(job));
+        }
+    }
+}
+
+bool BatchRenderer::run(const std::vector<BatchRenderJob>& jobs, const BatchRenderOptions& options,
+                        ProgressCallback callback) {
+    m_cancel = false;
+    m_callback = std::move(callback);
+    m_progress = BatchRenderProgress();
+    m_progress.total = jobs.size();
+
+    // Reprise : ignorer les sorties consignées comme terminées et toujours présentes
+    std::unordered_set<std::string> completed = loadCompletedOutputs(options.manifestPath);
+    std::vector<size_t> pending;
+    pending.reserve(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        std::error_code ec;
+        if (completed.count(jobs[i].outputPath) && fs::exists(jobs[i].outputPath, ec)) {
+            m_progress.skipped++;
+        } else {
+            pending.push_back(i);
+        }
+    }
+    if (pending.empty()) return true;
+
+    if (!options.manifestPath.empty()) {
+        std::error_code ec;
+        fs::path manifestDir = fs::path(options.manifestPath).parent_path();
+        if (!manifestDir.empty()) fs::create_directories(manifestDir, ec);
+        m_manifest.open(options.manifestPath, std::ios::app);
+    }
+
+    size_t threads = (options.threads > 0) ? static_cast<size_t>(options.threads)
+                                           : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, pending.size());
+
+    // Blocs contigus : les subsongs d'un fichier restent sur le même worker (cache disque chaud)
+    m_queues.clear();
+    for (size_t w = 0; w < threads; ++w) {
+        auto queue = std::make_unique<WorkerQueue>();
+        size_t begin = w * pending.size() / threads;
+        size_t end = (w + 1) * pending.size() / threads;
+        queue->jobs.assign(pending.begin() + begin, pending.begin() + end);
+        m_queues.push_back(std::move(queue));
+    }
+
+    m_start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (size_t w = 0; w < threads; ++w) {
+        workers.emplace_back(&BatchRenderer::workerLoop, this, w, std::cref(jobs), std::cref(options));
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    m_queues.clear();
+    if (m_manifest.is_open()) m_manifest.close();
+    return m_progress.failed == 0 && !m_cancel;
+}
+
+bool BatchRenderer::popJob(size_t worker, size_t& job) {
+    WorkerQueue& queue = *m_queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) return false;
+    job = queue.jobs.front();
+    queue.jobs.pop_front();
+    return true;
+}
+
+bool BatchRenderer::stealJobs(size_t thief) {
+    // Jamais deux verrous à la fois : retirer chez la victime, puis déposer chez soi
+    for (size_t offset = 1; offset < m_queues.size(); ++offset) {
+        WorkerQueue& victim = *m_queues[(thief + offset) % m_queues.size()];
+        std::deque<size_t> stolen;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            size_t count = (victim.jobs.size() + 1) / 2;
+            if (count == 0) continue;
+            stolen.assign(victim.jobs.end() - count, victim.jobs.end());
+            victim.jobs.erase(victim.jobs.end() - count, victim.jobs.end());
+        }
+        WorkerQueue& own = *m_queues[thief];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.jobs.insert(own.jobs.end(), stolen.begin(), stolen.end());
+        return true;
+    }
+    return false;
+}
+
+void BatchRenderer::workerLoop(size_t worker, const std::vector<BatchRenderJob>& jobs, const BatchRenderOptions& options) {
+    OfflineRenderer renderer; // Moteur et builder réutilisés pour tous les jobs de ce worker
+    size_t index = 0;
+    while (!m_cancel) {
+        if (!popJob(worker, index) && !(stealJobs(worker) && popJob(worker, index))) break;
+        const BatchRenderJob& job = jobs[index];
+
+        OfflineRenderOptions renderOptions;
+        renderOptions.inputPath = job.inputPath;
+        renderOptions.outputPath = partialPath(job.outputPath);
+        renderOptions.song = job.song;
+        renderOptions.durationSeconds = job.durationSeconds;
+        renderOptions.sampleRate = options.sampleRate;
+
+        std::error_code ec;
+        fs::create_directories(fs::path(job.outputPath).parent_path(), ec);
+        OfflineRenderResult result;
+        bool ok = renderer.render(renderOptions, result);
+        std::string error = renderer.getLastError();
+        if (ok) {
+            fs::rename(renderOptions.outputPath, job.outputPath, ec);
+            if (ec) {
+                ok = false;
+                error = "Cannot rename " + renderOptions.outputPath + ": " + ec.message();
+            }
+        }
+        if (!ok) fs::remove(renderOptions.outputPath, ec);
+        recordResult(job, result, ok, error);
+    }
+}
+
+void BatchRenderer::recordResult(const BatchRenderJob& job, const OfflineRenderResult& result, bool ok, const std::string& error) {
+    std::lock_guard<std::mutex> lock(m_progressMutex);
+    if (ok) {
+        m_progress.completed++;
+        m_progress.audioSeconds += result.audioSeconds;
+    } else {
+        m_progress.failed++;
+    }
+    m_progress.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    // Une ligne par job, vidée immédiatement : le manifeste reste exploitable après une interruption
+    if (m_manifest.is_open()) {
+        m_manifest << (ok ? "done" : "failed") << '\t' << job.outputPath << '\t' << job.inputPath << '\t' << job.song
+                   << '\t' << result.audioSeconds << '\t' << result.wallSeconds << '\t' << result.realtimeFactor
+                   << '\t' << error << '\n';
+        m_manifest.flush();
+    }
+    if (m_callback) m_callback(m_progress, job, result, ok, error);
+}
+
+namespace {
+    void printBatchUsage() {
+        std::cerr << "Usage: imSidPlayer --render-batch -o <output dir> [options]\n"
+                  << "  --root NAME|PATH    Only render this root folder of the database (default: all)\n"
+                  << "  --format flac|wav   Output format (default: flac)\n"
+                  << "  --jobs N            Worker threads (default: one per core)\n"
+                  << "  --rate HZ           Output sample rate (default: 44100)\n"
+                  << "  --manifest PATH     Resumable job manifest (default: <output dir>/render-manifest.tsv)\n"
+                  << "  --songlengths PATH  Songlengths.md5 for tunes indexed without lengths\n";
+    }
+}
+
+bool isBatchRenderCommand(int argc, char* argv[]) {
+    return argc > 1 && std::strcmp(argv[1], "--render-batch") == 0;
+}
+
+int runBatchRenderCommand(int argc, char* argv[]) {
+    std::string outputDir;
+    std::string rootFilter;
+    std::string songlengthsPath;
+    AudioFileFormat format = AudioFileFormat::Flac;
+    BatchRenderOptions options;
+    try {
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = (i + 1 < argc);
+            if ((arg == "-o" || arg == "--output") && hasValue) outputDir = argv[++i];
+            else if (arg == "--root" && hasValue) rootFilter = argv[++i];
+            else if (arg == "--format" && hasValue) {
+                std::string name = argv[++i];
+                if (name == "wav") format = AudioFileFormat::Wav;
+                else if (name == "flac") format = AudioFileFormat::Flac;
+                else { printBatchUsage(); return 2; }
+            }
+            else if (arg == "--jobs" && hasValue) options.threads = std::max(1, std::stoi(argv[++i]));
+            else if (arg == "--rate" && hasValue) options.sampleRate = std::clamp(std::stoi(argv[++i]), 8000, 192000);
+            else if (arg == "--manifest" && hasValue) options.manifestPath = argv[++i];
+            else if (arg == "--songlengths" && hasValue) songlengthsPath = argv[++i];
+            else { printBatchUsage(); return 2; }
+        }
+    } catch (...) {
+        printBatchUsage();
+        return 2;
+    }
+    if (outputDir.empty()) {
+        printBatchUsage();
+        return 2;
+    }
+    if (options.manifestPath.empty()) options.manifestPath = (fs::path(outputDir) / "render-manifest.tsv").string();
+
+    Config& config = Config::getInstance();
+    config.load((getConfigDir() / "config.txt").string());
+    if (songlengthsPath.empty()) songlengthsPath = config.getSonglengthsPath();
+    if (!songlengthsPath.empty() && !SongLengthDB::getInstance().load(songlengthsPath)) {
+        std::cerr << "Warning: cannot load Songlengths.md5 from " << songlengthsPath << "\n";
+    }
+    SongLengthDB::getInstance().loadOverlay((getConfigDir() / "songlengths-detected.md5").string());
+
+    DatabaseManager database;
+    if (!database.load()) {
+        std::cerr << "Cannot load the database\n";
+        return 1;
+    }
+    std::vector<BatchRenderJob> jobs;
+    for (const RootFolderEntry& root : database.getRootFolders()) {
+        if (!rootFilter.empty() && root.rootFolder != rootFilter && root.rootPath != rootFilter) continue;
+        BatchRenderer::appendJobs(root, outputDir, format, jobs);
+    }
+    if (jobs.empty()) {
+        std::cerr << "Nothing to render" << (rootFilter.empty() ? " (empty database)" : " (unknown root folder)") << "\n";
+        return 1;
+    }
+
+    BatchRenderer renderer;
+    size_t loudnessUpdates = 0;
+    // Le callback est sérialisé : la base n'est jamais modifiée par deux workers à la fois
+    bool ok = renderer.run(jobs, options, [&database, &loudnessUpdates](const BatchRenderProgress& progress,
+                                                                        const BatchRenderJob& job,
+                                                                        const OfflineRenderResult& result, bool jobOk,
+                                                                        const std::string& error) {
+        size_t done = progress.skipped + progress.completed + progress.failed;
+        std::cout << "[" << done << "/" << progress.total << "] " << job.outputPath;
+        if (jobOk) {
+            std::cout << ": " << std::fixed << std::setprecision(1) << result.audioSeconds << " s in "
+                      << std::setprecision(2) << result.wallSeconds << " s (" << std::setprecision(0)
+                      << result.realtimeFactor << "x), " << std::setprecision(1) << result.loudnessLufs << " LUFS\n";
+            if (database.setLoudness(job.inputPath, job.song - 1, static_cast<float>(result.loudnessLufs))) {
+                loudnessUpdates++;
+            }
+        } else {
+            std::cout << ": FAILED (" << error << ")\n";
+        }
+    });
+
+    // Sonie mesurée pendant le rendu : réutilisée par la normalisation du volume du lecteur
+    if (loudnessUpdates > 0 && !database.save()) {
+        std::cerr << "Warning: cannot save loudness results to the database\n";
+    }
+
+    const BatchRenderProgress& summary = renderer.getProgress();
+    double aggregateFactor = (summary.elapsedSeconds > 0.0) ? summary.audioSeconds / summary.elapsedSeconds : 0.0;
+    std::cout << std::fixed << std::setprecision(1)
+              << "Rendered " << summary.completed << ", failed " << summary.failed << ", skipped " << summary.skipped
+              << " (already in " << options.manifestPath << "): " << summary.audioSeconds / 3600.0 << " h of audio in "
+              << summary.elapsedSeconds << " s, " << std::setprecision(0) << aggregateFactor << "x real time\n";
+    return ok ? 0 : 1;
+}
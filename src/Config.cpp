@@ -71,6 +71,30 @@ bool Config::load(const std::string& filename) {
             try { m_windowWidth = std::stoi(value); } catch (...) {}
         } else if (key == "window_height") {
             try { m_windowHeight = std::stoi(value); } catch (...) {}
+        } else if (key == "audio_sample_rate") {
+            try { setAudioSampleRate(std::stoi(value)); } catch (...) {}
+        } else if (key == "audio_buffer_size") {
+            try { setAudioBufferSize(std::stoi(value)); } catch (...) {}
+        } else if (key == "emulation_rate") {
+            try { setEmulationRate(std::stoi(value)); } catch (...) {}
+        } else if (key == "fast_sampling") {
+            m_fastSampling = (value == "true" || value == "1");
+        } else if (key == "audio_output") {
+            m_audioOutput = value;
+        } else if (key == "audio_output_file") {
+            m_audioOutputFile = value;
+        } else if (key == "snapshot_memory_mb") {
+            try { setSnapshotMemoryMB(std::stoi(value)); } catch (...) {}
+        } else if (key == "silence_skip_seconds") {
+            try { setSilenceSkipSeconds(std::stoi(value)); } catch (...) {}
+        } else if (key == "loudness_normalization") {
+            m_loudnessNormalization = (value == "true" || value == "1");
+        } else if (key == "loudness_target_lufs") {
+            try { setLoudnessTargetLufs(std::stof(value)); } catch (...) {}
+        } else if (key == "oscilloscope_window_ms") {
+            try { setOscilloscopeWindowMs(std::stof(value)); } catch (...) {}
+        } else if (key == "spectrum_visible") {
+            m_spectrumVisible = (value == "true" || value == "1");
         } else if (key == "voice_0_active") {
             m_voiceActive[0] = (value == "true" || value == "1");
         } else if (key == "voice_1_active") {
@@ -116,6 +140,18 @@ bool Config::save(const std::string& filename) {
     file << "window_y: " << m_windowY << "\n";
     file << "window_width: " << m_windowWidth << "\n";
     file << "window_height: " << m_windowHeight << "\n";
+    file << "audio_sample_rate: " << m_audioSampleRate << "\n";
+    file << "audio_buffer_size: " << m_audioBufferSize << "\n";
+    file << "emulation_rate: " << m_emulationRate << "\n";
+    file << "fast_sampling: " << (m_fastSampling ? "true" : "false") << "\n";
+    file << "audio_output: " << m_audioOutput << "\n";
+    file << "audio_output_file: " << m_audioOutputFile << "\n";
+    file << "snapshot_memory_mb: " << m_snapshotMemoryMB << "\n";
+    file << "silence_skip_seconds: " << m_silenceSkipSeconds << "\n";
+    file << "loudness_normalization: " << (m_loudnessNormalization ? "true" : "false") << "\n";
+    file << "loudness_target_lufs: " << m_loudnessTargetLufs << "\n";
+    file << "oscilloscope_window_ms: " << m_oscilloscopeWindowMs << "\n";
+    file << "spectrum_visible: " << (m_spectrumVisible ? "true" : "false") << "\n";
     file << "voice_0_active: " << (m_voiceActive[0] ? "true" : "false") << "\n";
     file << "voice_1_active: " << (m_voiceActive[1] ? "true" : "false") << "\n";
     file << "voice_2_active: " << (m_voiceActive[2] ? "true" : "false") << "\n";
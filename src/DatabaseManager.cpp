@@ -14,14 +14,47 @@
 
 namespace fs = std::filesystem;
 
-DatabaseManager::DatabaseManager() : m_cacheValid(false) {
+namespace {
+    // Estampille (taille, date) de database.json : un JSON remplacé ou édité hors de l'application
+    // ne correspond plus à l'instantané binaire et doit être réimporté
+    bool jsonStamp(const std::string& path, int64_t& size, int64_t& mtime) {
+        std::error_code ec;
+        auto fileSize = fs::file_size(path, ec);
+        if (ec) return false;
+        auto writeTime = fs::last_write_time(path, ec);
+        if (ec) return false;
+        size = static_cast<int64_t>(fileSize);
+        mtime = static_cast<int64_t>(writeTime.time_since_epoch().count());
+        return true;
+    }
+    
+    // Chemin absolu d'une entrée persistée, reconstruit comme dans rebuildCacheAndIndexes
+    std::string absoluteSidPath(const fs::path& rootPath, const SidMetadata& meta) {
+        if (!rootPath.empty() && !meta.filepath.empty() && fs::path(meta.filepath).is_relative()) {
+            return (rootPath / meta.filepath).string();
+        }
+        return meta.filepath;
+    }
+}
+
+DatabaseManager::DatabaseManager() : m_rootFoldersPending(false), m_cacheValid(false), m_useSnapshotIndexes(false) {
     fs::path configDir = getConfigDir();
     m_databasePath = (configDir / "database.json").string();
+    m_snapshotPath = (configDir / "database.bin").string();
 }
 
 bool DatabaseManager::load() {
     auto loadStart = std::chrono::high_resolution_clock::now();
     
+    // Chemin rapide : instantané binaire projeté en mémoire, index utilisés sur place
+    if (loadSnapshot()) {
+        auto loadEnd = std::chrono::high_resolution_clock::now();
+        auto totalTime = std::chrono::duration_cast<std::chrono::milliseconds>(loadEnd - loadStart).count();
+        LOG_INFO("[DB Load] Total load time: {} ms ({} root folders, {} total files, snapshot indexes)",
+                 totalTime, m_snapshot.getRootCount(), m_metadataCache.size());
+        return true;
+    }
+    
     if (!fs::exists(m_databasePath)) {
         LOG_INFO("Database does not exist yet, creating a new database");
         m_rootFolders.clear();
@@ -52,12 +85,12 @@ bool DatabaseManager::load() {
         
         LOG_INFO("[DB Load] File read + JSON parsing (Turbo mode): {} ms ({} bytes)", readParseTime, fileSize);
         
-        // Copie des données
+        // Transfert des données (sans copie)
         auto copyStart = std::chrono::high_resolution_clock::now();
-        m_rootFolders = newStructure;
+        m_rootFolders = std::move(newStructure);
         auto copyEnd = std::chrono::high_resolution_clock::now();
         auto copyTime = std::chrono::duration_cast<std::chrono::milliseconds>(copyEnd - copyStart).count();
-        LOG_INFO("[DB Load] Data copy: {} ms", copyTime);
+        LOG_INFO("[DB Load] Data move: {} ms", copyTime);
         
         // Étape 4: Reconstruction des chemins absolus
         auto pathStart = std::chrono::high_resolution_clock::now();
@@ -81,6 +114,9 @@ bool DatabaseManager::load() {
         // Étape 5: Reconstruire le cache et les index depuis la base de données
         rebuildCacheAndIndexes();
         
+        // Étape 6: Régénérer l'instantané binaire pour que le prochain démarrage l'utilise
+        writeSnapshot(m_rootFolders);
+        
         size_t totalFiles = 0;
         for (const auto& root : m_rootFolders) {
             totalFiles += root.sidList.size();
@@ -101,6 +137,7 @@ bool DatabaseManager::load() {
 bool DatabaseManager::save() {
     try {
         // Préparer la structure hiérarchique avec chemins relatifs
+        ensureRootFolders();
         std::vector<RootFolderEntry> saveStructure = m_rootFolders;
         
         // Convertir les chemins absolus en relatifs pour chaque entrée
@@ -142,6 +179,10 @@ bool DatabaseManager::save() {
         }
         
         file << jsonStr;
+        file.close();
+        
+        // L'instantané porte l'estampille du JSON qui vient d'être écrit
+        writeSnapshot(saveStructure);
         
         size_t totalFiles = 0;
         for (const auto& root : saveStructure) {
@@ -157,9 +198,124 @@ bool DatabaseManager::save() {
     }
 }
 
+bool DatabaseManager::loadSnapshot() {
+    m_useSnapshotIndexes = false;
+    m_rootFoldersPending = false;
+    m_snapshot.close();
+    if (!fs::exists(m_snapshotPath)) {
+        return false;
+    }
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    if (!m_snapshot.open(m_snapshotPath)) {
+        LOG_WARNING("[DB Load] Ignoring binary snapshot: {}", m_snapshot.getLastError());
+        return false;
+    }
+    
+    // Sans database.json (export supprimé), l'instantané fait foi
+    int64_t jsonSize = 0;
+    int64_t jsonMtime = 0;
+    if (jsonStamp(m_databasePath, jsonSize, jsonMtime) &&
+        (jsonSize != m_snapshot.getJsonSize() || jsonMtime != m_snapshot.getJsonMtime())) {
+        LOG_INFO("[DB Load] database.json changed since the binary snapshot was written, importing it");
+        m_snapshot.close();
+        return false;
+    }
+    
+    if (!m_snapshot.materializeCache(m_metadataCache)) {
+        LOG_WARNING("[DB Load] Ignoring corrupted binary snapshot {}", m_snapshotPath);
+        m_snapshot.close();
+        return false;
+    }
+    // La structure persistée n'est décodée qu'à la première modification ou sauvegarde
+    m_rootFolders.clear();
+    m_rootFoldersPending = true;
+    m_filepathIndex.clear();
+    m_hashIndex.clear();
+    m_useSnapshotIndexes = true;
+    m_cacheValid = true;
+    
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    LOG_INFO("[DB Load] Binary snapshot mapped and decoded: {} ms ({} root folders, {} files)",
+             duration, m_snapshot.getRootCount(), m_snapshot.getRecordCount());
+    return true;
+}
+
+void DatabaseManager::writeSnapshot(const std::vector<RootFolderEntry>& structure) const {
+    int64_t jsonSize = 0;
+    int64_t jsonMtime = 0;
+    jsonStamp(m_databasePath, jsonSize, jsonMtime);
+    
+    // Le fichier projeté va être remplacé (refusé tant qu'il est projeté sous Windows)
+    ensureRootFolders();
+    detachSnapshot();
+    m_snapshot.close();
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    std::string error;
+    if (!DatabaseSnapshot::write(m_snapshotPath, structure, jsonSize, jsonMtime, error)) {
+        LOG_WARNING("Failed to write database snapshot: {}", error);
+        return;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    LOG_INFO("Database snapshot written in {} ms: {}",
+             std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count(), m_snapshotPath);
+}
+
+void DatabaseManager::ensureRootFolders() const {
+    if (!m_rootFoldersPending) {
+        return;
+    }
+    m_rootFoldersPending = false;
+    // Références validées à l'ouverture : le décodage ne peut échouer que sur un fichier modifié depuis
+    if (!m_snapshot.materializeRoots(m_rootFolders)) {
+        LOG_ERROR("Failed to decode root folders from database snapshot {}", m_snapshotPath);
+    }
+}
+
+void DatabaseManager::detachSnapshot() const {
+    if (!m_useSnapshotIndexes) {
+        return;
+    }
+    // Mêmes règles que rebuildCacheAndIndexes, sans recopier le cache
+    m_filepathIndex.clear();
+    m_hashIndex.clear();
+    m_filepathIndex.reserve(m_metadataCache.size());
+    m_hashIndex.reserve(m_metadataCache.size());
+    for (size_t index = 0; index < m_metadataCache.size(); ++index) {
+        const SidMetadata& meta = m_metadataCache[index];
+        if (!meta.filepath.empty()) {
+            m_filepathIndex[meta.filepath] = index;
+        }
+        if (meta.metadataHash != 0) {
+            m_hashIndex[meta.metadataHash] = index;
+        }
+    }
+    m_useSnapshotIndexes = false;
+}
+
+int64_t DatabaseManager::findFilepathIndex(const std::string& filepath) const {
+    if (m_useSnapshotIndexes) {
+        return m_snapshot.findPath(filepath);
+    }
+    auto it = m_filepathIndex.find(filepath);
+    return it != m_filepathIndex.end() ? static_cast<int64_t>(it->second) : -1;
+}
+
+int64_t DatabaseManager::findHashIndex(uint32_t metadataHash) const {
+    if (m_useSnapshotIndexes) {
+        return m_snapshot.findHash(metadataHash);
+    }
+    auto it = m_hashIndex.find(metadataHash);
+    return it != m_hashIndex.end() ? static_cast<int64_t>(it->second) : -1;
+}
+
 void DatabaseManager::rebuildCacheAndIndexes() const {
     auto start = std::chrono::high_resolution_clock::now();
     
+    ensureRootFolders();
+    m_useSnapshotIndexes = false;
     m_metadataCache.clear();
     m_filepathIndex.clear();
     m_hashIndex.clear();
@@ -209,13 +365,23 @@ void DatabaseManager::rebuildCacheAndIndexes() const {
 
 bool DatabaseManager::clear() {
     // Vider la base de données en mémoire
+    m_useSnapshotIndexes = false;
+    m_rootFoldersPending = false;
+    m_snapshot.close();
     m_rootFolders.clear();
     m_metadataCache.clear();
     m_filepathIndex.clear();
     m_hashIndex.clear();
     m_cacheValid = false;
     
-    // Supprimer le fichier sur disque
+    // Supprimer les fichiers sur disque (l'instantané d'abord : il serait rechargé sans le JSON)
+    if (fs::exists(m_snapshotPath)) {
+        std::error_code ec;
+        if (!fs::remove(m_snapshotPath, ec)) {
+            LOG_ERROR("Failed to delete database snapshot {}: {}", m_snapshotPath, ec.message());
+            return false;
+        }
+    }
     if (fs::exists(m_databasePath)) {
         try {
             fs::remove(m_databasePath);
@@ -283,15 +449,99 @@ int DatabaseManager::indexPlaylist(PlaylistManager& playlist, std::function<void
 }
 
 bool DatabaseManager::indexFile(const std::string& filepath, const std::string& rootFolder) {
-    if (!fs::exists(filepath)) {
+    return applyIndexing(filepath, rootFolder, nullptr);
+}
+
+bool DatabaseManager::indexMetadata(const std::string& filepath, const std::string& rootFolder, const SidMetadata& metadata) {
+    if (metadata.filepath.empty() || metadata.md5Hash.empty()) {
         return false;
     }
+    return applyIndexing(filepath, rootFolder, &metadata);
+}
+
+std::unordered_map<std::string, IndexingPipeline::FileStamp> DatabaseManager::getFileStamps() const {
+    if (!m_cacheValid) {
+        rebuildCacheAndIndexes();
+    }
+    std::unordered_map<std::string, IndexingPipeline::FileStamp> stamps;
+    stamps.reserve(m_metadataCache.size());
+    for (const auto& meta : m_metadataCache) {
+        stamps[meta.filepath] = {meta.fileSize, meta.lastModified};
+    }
+    return stamps;
+}
+
+size_t DatabaseManager::removeFiles(const std::vector<std::string>& filepaths) {
+    if (filepaths.empty()) {
+        return 0;
+    }
+    if (!m_cacheValid) {
+        rebuildCacheAndIndexes();
+    }
+    std::unordered_set<std::string> toRemove;
+    for (const auto& filepath : filepaths) {
+        if (findFilepathIndex(filepath) >= 0) {
+            toRemove.insert(filepath);
+        }
+    }
+    if (toRemove.empty()) {
+        return 0;
+    }
+    
+    // La base va être modifiée : structure décodée et index en mémoire
+    ensureRootFolders();
+    detachSnapshot();
+    
+    size_t removed = 0;
+    for (auto& rootEntry : m_rootFolders) {
+        fs::path rootPath(rootEntry.rootPath);
+        auto& list = rootEntry.sidList;
+        size_t before = list.size();
+        list.erase(std::remove_if(list.begin(), list.end(), [&](const SidMetadata& meta) {
+            return toRemove.count(absoluteSidPath(rootPath, meta)) > 0;
+        }), list.end());
+        removed += before - list.size();
+    }
+    // Dossiers racines vidés : retirés aussi
+    m_rootFolders.erase(std::remove_if(m_rootFolders.begin(), m_rootFolders.end(),
+        [](const RootFolderEntry& entry) { return entry.sidList.empty(); }), m_rootFolders.end());
+    
+    m_cacheValid = false;
+    rebuildCacheAndIndexes();
+    return removed;
+}
+
+bool DatabaseManager::applyIndexing(const std::string& filepath, const std::string& rootFolder, const SidMetadata* prepared) {
+    // Taille/date : un seul stat (ou celles du pipeline, relevées juste avant sa lecture)
+    int64_t fileSize = 0;
+    int64_t lastModified = 0;
+    if (prepared) {
+        fileSize = prepared->fileSize;
+        lastModified = prepared->lastModified;
+    } else if (!SidMetadata::statFile(filepath, fileSize, lastModified)) {
+        return false;
+    }
+    
+    // Métadonnées et MD5 : fournis par le pipeline, sinon lus ici au premier besoin, en une seule lecture
+    SidMetadata loaded;
+    const SidMetadata* source = prepared;
+    auto extract = [&]() -> const SidMetadata& {
+        if (!source) {
+            loaded = extractMetadata(filepath, lastModified);
+            source = &loaded;
+        }
+        return *source;
+    };
+    auto md5 = [&]() { return extract().md5Hash; };
     
     // OPTIMISATION : Utiliser les index pour des recherches O(1) au lieu de O(n)
     // Maintenir les index à jour pendant l'indexation
     if (!m_cacheValid) {
         rebuildCacheAndIndexes();
     }
+    // La base va être modifiée : structure décodée et index en mémoire
+    ensureRootFolders();
+    detachSnapshot();
     
     // Recherche O(1) par filepath
     auto filepathIt = m_filepathIndex.find(filepath);
@@ -316,7 +566,7 @@ bool DatabaseManager::indexFile(const std::string& filepath, const std::string&
                     
                     if (metaPath.string() == filepath) {
                         // Fichier trouvé, vérifier s'il a changé
-                        if (!meta.isFileChanged()) {
+                        if (!meta.isFileChanged(fileSize, lastModified)) {
                             // Fichier à jour, mettre à jour rootFolder si fourni
                             if (!rootFolder.empty() && rootEntry.rootFolder.empty()) {
                                 rootEntry.rootFolder = rootFolder;
@@ -325,7 +575,7 @@ bool DatabaseManager::indexFile(const std::string& filepath, const std::string&
                         }
                         
                         // Fichier a changé : réindexer et recalculer le MD5
-                        meta = extractMetadata(filepath);
+                        meta = extract();
                         if (meta.filepath.empty()) {
                             return false;
                         }
@@ -347,12 +597,12 @@ bool DatabaseManager::indexFile(const std::string& filepath, const std::string&
                         }
                         
                         // Recalculer le MD5 car le fichier a changé
-                        meta.md5Hash = calculateFileMD5(filepath);
+                        meta.md5Hash = md5();
                         populateSongLengths(meta);
                         meta.rootFolder = ""; // Plus besoin dans chaque entrée
                         
                         // Mettre à jour le cache et les index
-                        m_metadataCache[cacheIndex] = cachedMeta; // Mettre à jour avec nouvelles données
+                        m_metadataCache[cacheIndex] = meta; // Mettre à jour avec nouvelles données
                         m_metadataCache[cacheIndex].filepath = filepath;
                         m_metadataCache[cacheIndex].rootFolder = rootEntry.rootFolder;
                         return true; // Fichier réindexé
@@ -364,7 +614,7 @@ bool DatabaseManager::indexFile(const std::string& filepath, const std::string&
     }
     
     // Extraire les métadonnées pour obtenir le metadataHash
-    SidMetadata metadata = extractMetadata(filepath);
+    SidMetadata metadata = extract();
     if (metadata.filepath.empty() || metadata.metadataHash == 0) {
         return false; // Erreur lors de l'extraction
     }
@@ -427,7 +677,7 @@ bool DatabaseManager::indexFile(const std::string& filepath, const std::string&
         
         if (shouldDuplicate) {
             // Créer une nouvelle entrée pour ce rootFolder différent
-            metadata.md5Hash = calculateFileMD5(filepath);
+            metadata.md5Hash = md5();
             populateSongLengths(metadata);
             // Convertir en chemin relatif
             SidMetadata relMeta = metadata;
@@ -486,8 +736,8 @@ bool DatabaseManager::indexFile(const std::string& filepath, const std::string&
                     }
                     
                     // Vérifier si le fichier a changé
-                    if (existingMeta.isFileChanged()) {
-                        existingMeta = extractMetadata(filepath);
+                    if (existingMeta.isFileChanged(fileSize, lastModified)) {
+                        existingMeta = extract();
                         if (existingMeta.filepath.empty()) {
                             return false;
                         }
@@ -501,10 +751,10 @@ bool DatabaseManager::indexFile(const std::string& filepath, const std::string&
                                 // Garder absolu si relative échoue
                             }
                         }
-                        existingMeta.md5Hash = calculateFileMD5(filepath);
+                        existingMeta.md5Hash = md5();
                         populateSongLengths(existingMeta);
                     } else if (existingMeta.md5Hash.empty()) {
-                        existingMeta.md5Hash = calculateFileMD5(filepath);
+                        existingMeta.md5Hash = md5();
                         populateSongLengths(existingMeta);
                     }
                     
@@ -524,7 +774,7 @@ bool DatabaseManager::indexFile(const std::string& filepath, const std::string&
     }
     
     // Nouveau morceau : ajouter les métadonnées et calculer le MD5
-    metadata.md5Hash = calculateFileMD5(filepath);
+    metadata.md5Hash = md5();
     populateSongLengths(metadata);
     
     // Convertir en chemin relatif
@@ -557,10 +807,10 @@ bool DatabaseManager::isIndexed(const std::string& filepath) const {
     if (!m_cacheValid) {
         rebuildCacheAndIndexes();
     }
-    auto it = m_filepathIndex.find(filepath);
-    if (it != m_filepathIndex.end()) {
+    int64_t index = findFilepathIndex(filepath);
+    if (index >= 0) {
         // Vérifier si le fichier a changé
-        const SidMetadata& metadata = m_metadataCache[it->second];
+        const SidMetadata& metadata = m_metadataCache[index];
         return !metadata.isFileChanged();
     }
     return false;
@@ -570,17 +820,16 @@ bool DatabaseManager::isIndexedByMetadataHash(uint32_t metadataHash) const {
     if (!m_cacheValid) {
         rebuildCacheAndIndexes();
     }
-    auto it = m_hashIndex.find(metadataHash);
-    return it != m_hashIndex.end();
+    return findHashIndex(metadataHash) >= 0;
 }
 
 const SidMetadata* DatabaseManager::getMetadata(const std::string& filepath) const {
     if (!m_cacheValid) {
         rebuildCacheAndIndexes();
     }
-    auto it = m_filepathIndex.find(filepath);
-    if (it != m_filepathIndex.end()) {
-        return &m_metadataCache[it->second];
+    int64_t index = findFilepathIndex(filepath);
+    if (index >= 0) {
+        return &m_metadataCache[index];
     }
     return nullptr;
 }
@@ -589,14 +838,14 @@ const SidMetadata* DatabaseManager::getMetadataByHash(uint32_t metadataHash) con
     if (!m_cacheValid) {
         rebuildCacheAndIndexes();
     }
-    auto it = m_hashIndex.find(metadataHash);
-    if (it == m_hashIndex.end()) {
+    int64_t index = findHashIndex(metadataHash);
+    if (index < 0) {
         return nullptr;
     }
-    return &m_metadataCache[it->second];
+    return &m_metadataCache[index];
 }
 
-std::vector<SidMetadata> DatabaseManager::getAllMetadata() const {
+const std::vector<SidMetadata>& DatabaseManager::getAllMetadata() const {
     if (!m_cacheValid) {
         rebuildCacheAndIndexes();
     }
@@ -610,11 +859,48 @@ size_t DatabaseManager::getCount() const {
     return m_metadataCache.size();
 }
 
+bool DatabaseManager::setLoudness(const std::string& filepath, int subsongIndex, float lufs) {
+    if (subsongIndex < 0) return false;
+    if (!m_cacheValid) {
+        rebuildCacheAndIndexes();
+    }
+    int64_t found = findFilepathIndex(filepath);
+    if (found < 0) return false;
+    
+    auto store = [&](SidMetadata& meta) {
+        size_t size = std::max<size_t>(static_cast<size_t>(std::max(meta.numberOfSongs, 1)), subsongIndex + 1);
+        if (meta.loudness.size() < size) meta.loudness.resize(size, 0.0f);
+        meta.loudness[subsongIndex] = lufs;
+    };
+    const std::string rootFolder = m_metadataCache[found].rootFolder;
+    store(m_metadataCache[found]);
+    ensureRootFolders();
+    
+    // Entrée persistée retrouvée par son chemin : applyIndexing ajoute les nouveaux fichiers
+    // en fin de cache mais dans la sidList de leur racine, les positions ne correspondent plus
+    for (auto& rootEntry : m_rootFolders) {
+        if (rootEntry.rootFolder != rootFolder) continue;
+        fs::path rootPath(rootEntry.rootPath);
+        for (auto& meta : rootEntry.sidList) {
+            if (absoluteSidPath(rootPath, meta) == filepath) {
+                store(meta);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 std::unordered_set<uint32_t> DatabaseManager::getIndexedMetadataHashes() const {
     if (!m_cacheValid) {
         rebuildCacheAndIndexes();
     }
     std::unordered_set<uint32_t> hashes;
+    if (m_useSnapshotIndexes) {
+        std::vector<uint32_t> snapshotHashes = m_snapshot.getMetadataHashes();
+        hashes.insert(snapshotHashes.begin(), snapshotHashes.end());
+        return hashes;
+    }
     for (const auto& pair : m_hashIndex) {
         hashes.insert(pair.first);
     }
@@ -846,32 +1132,26 @@ std::vector<const SidMetadata*> DatabaseManager::search(const std::string& query
     return results;
 }
 
-SidMetadata DatabaseManager::extractMetadata(const std::string& filepath) {
-    try {
-        SidTune tune(filepath.c_str());
-        if (!tune.getStatus()) {
-            return SidMetadata(); // Erreur
-        }
-        
-        SidMetadata metadata = SidMetadata::fromSidTune(filepath, &tune);
-        
-        // Le MD5 sera calculé dans indexFile() si nécessaire
-        // (évite de recalculer si déjà présent dans la base)
-        
-        return metadata;
-    } catch (const std::exception& e) {
-        LOG_ERROR("Error extracting metadata from {}: {}", filepath, e.what());
+SidMetadata DatabaseManager::extractMetadata(const std::string& filepath, int64_t lastModified) {
+    // Une seule lecture : le même tampon sert à SidTune (constructeur mémoire) et au MD5
+    std::vector<uint8_t> data;
+    if (!readFileBytes(filepath, data, IndexingPipeline::MAX_FILE_BYTES)) {
+        LOG_ERROR("Error extracting metadata from {}: cannot read file", filepath);
         return SidMetadata();
     }
+    SidMetadata metadata;
+    if (!SidMetadata::fromFileData(filepath, data.data(), data.size(), metadata)) {
+        return SidMetadata(); // Erreur
+    }
+    metadata.lastModified = lastModified;
+    metadata.md5Hash = calculateDataMD5(data.data(), data.size());
+    return metadata;
 }
 
 void DatabaseManager::populateSongLengths(SidMetadata& metadata) const {
     // Récupérer les songlengths depuis SongLengthDB si disponible
     if (!metadata.md5Hash.empty()) {
-        SongLengthDB& songLengthDB = SongLengthDB::getInstance();
-        if (songLengthDB.isLoaded()) {
-            metadata.songLengths = songLengthDB.getDurations(metadata.md5Hash);
-        }
+        metadata.songLengths = SongLengthDB::getInstance().getDurations(metadata.md5Hash);
     }
 }
 
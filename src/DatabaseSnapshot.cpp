@@ -0,0 +1,633 @@
+#include "DatabaseSnapshot.h"
+#include "DatabaseManager.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+    const char MAGIC[8] = {'I', 'M', 'S', 'I', 'D', 'D', 'B', '\0'};
+    const uint32_t ENDIAN_MARK = 0x01020304;
+    const uint32_t MIN_SLOTS = 8;
+
+    struct StringRef {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct Span {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t endianMark;
+        uint64_t fileSize;
+        int64_t jsonSize;           // Estampille du database.json écrit avec cet instantané
+        int64_t jsonMtime;
+        uint32_t rootCount;
+        uint32_t recordCount;
+        uint32_t infoCount;         // Pool des références infoStrings
+        uint32_t lengthCount;       // Pool des durées (double)
+        uint32_t loudnessCount;     // Pool des sonies (float)
+        uint32_t pathSlots;         // Puissances de 2
+        uint32_t hashSlots;
+        uint32_t reserved;
+        uint64_t stringsSize;
+        uint64_t rootsOffset;
+        uint64_t recordsOffset;
+        uint64_t infoOffset;
+        uint64_t lengthsOffset;
+        uint64_t loudnessOffset;
+        uint64_t pathIndexOffset;
+        uint64_t hashIndexOffset;
+        uint64_t stringsOffset;
+    };
+
+    struct RootRecord {
+        StringRef rootPath;
+        StringRef rootFolder;
+        uint32_t firstRecord;
+        uint32_t recordCount;
+    };
+
+    struct Record {
+        StringRef filepath;         // Tel que persisté (relatif à rootPath)
+        StringRef absolutePath;     // Clé de l'index par chemin, chemin du cache
+        StringRef filename;
+        StringRef title;
+        StringRef author;
+        StringRef released;
+        StringRef sidModel;
+        StringRef md5Hash;
+        Span infoStrings;
+        Span songLengths;
+        Span loudness;
+        int64_t fileSize;
+        int64_t lastModified;
+        int32_t numberOfSongs;
+        int32_t defaultSong;
+        int32_t clockSpeed;
+        uint32_t metadataHash;
+        uint32_t rootIndex;
+        uint16_t hvscNum;
+        uint16_t reserved;
+    };
+
+    struct IndexSlot {
+        uint32_t key;               // Bits hauts du hash du chemin, ou metadataHash
+        uint32_t record;            // Indice + 1 (0 = case vide)
+    };
+
+    static_assert(sizeof(Header) == 144, "Header layout");
+    static_assert(sizeof(Record) == 128, "Record layout");
+
+    uint64_t align8(uint64_t value) {
+        return (value + 7) & ~uint64_t(7);
+    }
+
+    uint32_t slotCount(size_t entries) {
+        uint32_t slots = MIN_SLOTS;
+        while (slots < entries * 2) slots <<= 1;
+        return slots;
+    }
+
+    uint32_t mixHash(uint32_t x) {
+        x ^= x >> 16;
+        x *= 0x45d9f3bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    // Table de chaînes : les champs courts répétés (auteurs, modèles, dates) sont dédupliqués
+    class StringTable {
+    public:
+        StringRef add(const std::string& value, bool intern) {
+            if (value.empty()) return {0, 0};
+            if (intern) {
+                auto it = m_interned.find(value);
+                if (it != m_interned.end()) return it->second;
+            }
+            StringRef ref{static_cast<uint32_t>(m_data.size()), static_cast<uint32_t>(value.size())};
+            m_data += value;
+            if (intern) m_interned.emplace(value, ref);
+            return ref;
+        }
+        const std::string& data() const { return m_data; }
+
+    private:
+        std::string m_data;
+        std::unordered_map<std::string, StringRef> m_interned;
+    };
+}
+
+DatabaseSnapshot::~DatabaseSnapshot() {
+    close();
+}
+
+uint64_t DatabaseSnapshot::hashPath(std::string_view path) {
+    // FNV-1a 64 bits
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : path) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool DatabaseSnapshot::write(const std::string& path, const std::vector<RootFolderEntry>& roots,
+                             int64_t jsonSize, int64_t jsonMtime, std::string& error) {
+    StringTable strings;
+    std::vector<RootRecord> rootRecords;
+    std::vector<Record> records;
+    std::vector<std::string> absolutePaths;
+    std::vector<StringRef> infoPool;
+    std::vector<double> lengthPool;
+    std::vector<float> loudnessPool;
+
+    rootRecords.reserve(roots.size());
+    for (const auto& root : roots) {
+        RootRecord rootRecord{};
+        rootRecord.rootPath = strings.add(root.rootPath, true);
+        rootRecord.rootFolder = strings.add(root.rootFolder, true);
+        rootRecord.firstRecord = static_cast<uint32_t>(records.size());
+        rootRecord.recordCount = static_cast<uint32_t>(root.sidList.size());
+        fs::path rootPath(root.rootPath);
+
+        for (const auto& meta : root.sidList) {
+            // Même reconstruction du chemin absolu que DatabaseManager::rebuildCacheAndIndexes
+            std::string absolute = meta.filepath;
+            if (!rootPath.empty() && !meta.filepath.empty() && fs::path(meta.filepath).is_relative()) {
+                absolute = (rootPath / meta.filepath).string();
+            }
+
+            Record record{};
+            record.filepath = strings.add(meta.filepath, false);
+            record.absolutePath = strings.add(absolute, false);
+            record.filename = strings.add(meta.filename, false);
+            record.title = strings.add(meta.title, true);
+            record.author = strings.add(meta.author, true);
+            record.released = strings.add(meta.released, true);
+            record.sidModel = strings.add(meta.sidModel, true);
+            record.md5Hash = strings.add(meta.md5Hash, false);
+            record.infoStrings = {static_cast<uint32_t>(infoPool.size()), static_cast<uint32_t>(meta.infoStrings.size())};
+            for (const auto& info : meta.infoStrings) infoPool.push_back(strings.add(info, true));
+            record.songLengths = {static_cast<uint32_t>(lengthPool.size()), static_cast<uint32_t>(meta.songLengths.size())};
+            lengthPool.insert(lengthPool.end(), meta.songLengths.begin(), meta.songLengths.end());
+            record.loudness = {static_cast<uint32_t>(loudnessPool.size()), static_cast<uint32_t>(meta.loudness.size())};
+            loudnessPool.insert(loudnessPool.end(), meta.loudness.begin(), meta.loudness.end());
+            record.fileSize = meta.fileSize;
+            record.lastModified = meta.lastModified;
+            record.numberOfSongs = meta.numberOfSongs;
+            record.defaultSong = meta.defaultSong;
+            record.clockSpeed = meta.clockSpeed;
+            record.metadataHash = meta.metadataHash;
+            record.rootIndex = static_cast<uint32_t>(rootRecords.size());
+            record.hvscNum = meta.hvscNum;
+            records.push_back(record);
+            absolutePaths.push_back(std::move(absolute));
+        }
+        rootRecords.push_back(rootRecord);
+    }
+
+    if (strings.data().size() > std::numeric_limits<uint32_t>::max() ||
+        records.size() >= std::numeric_limits<uint32_t>::max()) {
+        error = "Database too large for the snapshot format";
+        return false;
+    }
+
+    // Index prébâtis ; en cas de doublon, la dernière entrée l'emporte (comme les index en mémoire)
+    std::vector<IndexSlot> pathIndex(slotCount(records.size()), IndexSlot{0, 0});
+    std::vector<IndexSlot> hashIndex(slotCount(records.size()), IndexSlot{0, 0});
+    uint32_t pathMask = static_cast<uint32_t>(pathIndex.size() - 1);
+    uint32_t hashMask = static_cast<uint32_t>(hashIndex.size() - 1);
+    for (uint32_t i = 0; i < records.size(); ++i) {
+        const std::string& absolute = absolutePaths[i];
+        if (!absolute.empty()) {
+            uint64_t hash = hashPath(absolute);
+            uint32_t tag = static_cast<uint32_t>(hash >> 32);
+            for (uint32_t slot = static_cast<uint32_t>(hash) & pathMask;; slot = (slot + 1) & pathMask) {
+                IndexSlot& entry = pathIndex[slot];
+                if (entry.record == 0 || (entry.key == tag && absolutePaths[entry.record - 1] == absolute)) {
+                    entry = {tag, i + 1};
+                    break;
+                }
+            }
+        }
+        uint32_t key = records[i].metadataHash;
+        if (key != 0) {
+            for (uint32_t slot = mixHash(key) & hashMask;; slot = (slot + 1) & hashMask) {
+                IndexSlot& entry = hashIndex[slot];
+                if (entry.record == 0 || entry.key == key) {
+                    entry = {key, i + 1};
+                    break;
+                }
+            }
+        }
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.endianMark = ENDIAN_MARK;
+    header.jsonSize = jsonSize;
+    header.jsonMtime = jsonMtime;
+    header.rootCount = static_cast<uint32_t>(rootRecords.size());
+    header.recordCount = static_cast<uint32_t>(records.size());
+    header.infoCount = static_cast<uint32_t>(infoPool.size());
+    header.lengthCount = static_cast<uint32_t>(lengthPool.size());
+    header.loudnessCount = static_cast<uint32_t>(loudnessPool.size());
+    header.pathSlots = static_cast<uint32_t>(pathIndex.size());
+    header.hashSlots = static_cast<uint32_t>(hashIndex.size());
+    header.stringsSize = strings.data().size();
+    uint64_t offset = align8(sizeof(Header));
+    header.rootsOffset = offset;      offset = align8(offset + rootRecords.size() * sizeof(RootRecord));
+    header.recordsOffset = offset;    offset = align8(offset + records.size() * sizeof(Record));
+    header.infoOffset = offset;       offset = align8(offset + infoPool.size() * sizeof(StringRef));
+    header.lengthsOffset = offset;    offset = align8(offset + lengthPool.size() * sizeof(double));
+    header.loudnessOffset = offset;   offset = align8(offset + loudnessPool.size() * sizeof(float));
+    header.pathIndexOffset = offset;  offset = align8(offset + pathIndex.size() * sizeof(IndexSlot));
+    header.hashIndexOffset = offset;  offset = align8(offset + hashIndex.size() * sizeof(IndexSlot));
+    header.stringsOffset = offset;    offset += strings.data().size();
+    header.fileSize = offset;
+
+    std::vector<uint8_t> buffer(offset, 0);
+    auto put = [&buffer](uint64_t at, const void* data, size_t size) {
+        if (size > 0) std::memcpy(buffer.data() + at, data, size);
+    };
+    put(0, &header, sizeof(header));
+    put(header.rootsOffset, rootRecords.data(), rootRecords.size() * sizeof(RootRecord));
+    put(header.recordsOffset, records.data(), records.size() * sizeof(Record));
+    put(header.infoOffset, infoPool.data(), infoPool.size() * sizeof(StringRef));
+    put(header.lengthsOffset, lengthPool.data(), lengthPool.size() * sizeof(double));
+    put(header.loudnessOffset, loudnessPool.data(), loudnessPool.size() * sizeof(float));
+    put(header.pathIndexOffset, pathIndex.data(), pathIndex.size() * sizeof(IndexSlot));
+    put(header.hashIndexOffset, hashIndex.data(), hashIndex.size() * sizeof(IndexSlot));
+    put(header.stringsOffset, strings.data().data(), strings.data().size());
+
+    // Fichier temporaire puis renommage : un instantané est complet ou absent, jamais tronqué
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            error = "Cannot write " + tempPath;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        if (!file) {
+            error = "Write error on " + tempPath;
+            file.close();
+            std::error_code ec;
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        error = "Cannot replace " + path + ": " + ec.message();
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseSnapshot::open(const std::string& path) {
+    close();
+    m_lastError.clear();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        m_lastError = "Cannot open " + path;
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        m_lastError = "Empty snapshot " + path;
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        m_lastError = "Cannot map " + path;
+        return false;
+    }
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        m_lastError = "Cannot open " + path;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        m_lastError = "Empty snapshot " + path;
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view != MAP_FAILED) {
+        m_data = static_cast<const uint8_t*>(view);
+        m_mapped = true;
+    } else {
+        // Système de fichiers sans mmap : lecture classique
+        m_fallback.resize(size);
+        ssize_t done = 0;
+        while (done < static_cast<ssize_t>(size)) {
+            ssize_t n = ::read(fd, m_fallback.data() + done, size - done);
+            if (n <= 0) break;
+            done += n;
+        }
+        if (done != static_cast<ssize_t>(size)) {
+            ::close(fd);
+            m_fallback.clear();
+            m_lastError = "Cannot read " + path;
+            return false;
+        }
+        m_data = m_fallback.data();
+    }
+    ::close(fd);
+    m_size = size;
+#endif
+    if (!validate()) {
+        std::string error = m_lastError;
+        close();
+        m_lastError = error;
+        return false;
+    }
+    return true;
+}
+
+void DatabaseSnapshot::close() {
+    if (!m_data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_mapping));
+    CloseHandle(static_cast<HANDLE>(m_file));
+    m_mapping = nullptr;
+    m_file = nullptr;
+#else
+    if (m_mapped) munmap(const_cast<uint8_t*>(m_data), m_size);
+    m_mapped = false;
+    m_fallback.clear();
+    m_fallback.shrink_to_fit();
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool DatabaseSnapshot::validate() {
+    if (m_size < sizeof(Header)) {
+        m_lastError = "Truncated snapshot";
+        return false;
+    }
+    const Header& header = *section<Header>(0);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        m_lastError = "Not a database snapshot";
+        return false;
+    }
+    if (header.endianMark != ENDIAN_MARK) {
+        m_lastError = "Snapshot written on a machine with another byte order";
+        return false;
+    }
+    if (header.version != VERSION) {
+        m_lastError = "Unsupported snapshot version " + std::to_string(header.version);
+        return false;
+    }
+    if (header.fileSize != m_size) {
+        m_lastError = "Snapshot size mismatch";
+        return false;
+    }
+    auto fits = [this](uint64_t offset, uint64_t count, uint64_t elementSize) {
+        return offset % 8 == 0 && offset <= m_size && count * elementSize <= m_size - offset;
+    };
+    auto powerOfTwo = [](uint32_t n) { return n != 0 && (n & (n - 1)) == 0; };
+    if (!fits(header.rootsOffset, header.rootCount, sizeof(RootRecord)) ||
+        !fits(header.recordsOffset, header.recordCount, sizeof(Record)) ||
+        !fits(header.infoOffset, header.infoCount, sizeof(StringRef)) ||
+        !fits(header.lengthsOffset, header.lengthCount, sizeof(double)) ||
+        !fits(header.loudnessOffset, header.loudnessCount, sizeof(float)) ||
+        !fits(header.pathIndexOffset, header.pathSlots, sizeof(IndexSlot)) ||
+        !fits(header.hashIndexOffset, header.hashSlots, sizeof(IndexSlot)) ||
+        !fits(header.stringsOffset, header.stringsSize, 1) ||
+        !powerOfTwo(header.pathSlots) || !powerOfTwo(header.hashSlots)) {
+        m_lastError = "Corrupted snapshot sections";
+        return false;
+    }
+
+    // Dossiers contigus et références de chaque enregistrement dans les bornes :
+    // le décodage (éventuellement différé) ne peut plus échouer ensuite
+    const RootRecord* rootRecords = section<RootRecord>(header.rootsOffset);
+    const Record* records = section<Record>(header.recordsOffset);
+    auto refFits = [&header](const StringRef& ref) {
+        return static_cast<uint64_t>(ref.offset) + ref.length <= header.stringsSize;
+    };
+    auto spanFits = [](const Span& span, uint32_t poolCount) {
+        return static_cast<uint64_t>(span.first) + span.count <= poolCount;
+    };
+    uint64_t next = 0;
+    for (uint32_t r = 0; r < header.rootCount; ++r) {
+        const RootRecord& root = rootRecords[r];
+        if (root.firstRecord != next || !refFits(root.rootPath) || !refFits(root.rootFolder)) {
+            m_lastError = "Corrupted snapshot root folders";
+            return false;
+        }
+        next += root.recordCount;
+    }
+    if (next != header.recordCount) {
+        m_lastError = "Corrupted snapshot root folders";
+        return false;
+    }
+    const StringRef* infoPool = section<StringRef>(header.infoOffset);
+    for (uint32_t i = 0; i < header.infoCount; ++i) {
+        if (!refFits(infoPool[i])) {
+            m_lastError = "Corrupted snapshot strings";
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header.recordCount; ++i) {
+        const Record& record = records[i];
+        if (!refFits(record.filepath) || !refFits(record.absolutePath) || !refFits(record.filename) ||
+            !refFits(record.title) || !refFits(record.author) || !refFits(record.released) ||
+            !refFits(record.sidModel) || !refFits(record.md5Hash) || record.rootIndex >= header.rootCount ||
+            !spanFits(record.infoStrings, header.infoCount) || !spanFits(record.songLengths, header.lengthCount) ||
+            !spanFits(record.loudness, header.loudnessCount)) {
+            m_lastError = "Corrupted snapshot record " + std::to_string(i);
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t DatabaseSnapshot::getRootCount() const {
+    return m_data ? section<Header>(0)->rootCount : 0;
+}
+
+uint32_t DatabaseSnapshot::getRecordCount() const {
+    return m_data ? section<Header>(0)->recordCount : 0;
+}
+
+int64_t DatabaseSnapshot::getJsonSize() const {
+    return m_data ? section<Header>(0)->jsonSize : 0;
+}
+
+int64_t DatabaseSnapshot::getJsonMtime() const {
+    return m_data ? section<Header>(0)->jsonMtime : 0;
+}
+
+std::string_view DatabaseSnapshot::stringAt(uint32_t offset, uint32_t length) const {
+    const Header& header = *section<Header>(0);
+    if (static_cast<uint64_t>(offset) + length > header.stringsSize) return {};
+    return std::string_view(section<char>(header.stringsOffset) + offset, length);
+}
+
+bool DatabaseSnapshot::readString(uint32_t offset, uint32_t length, std::string& out) const {
+    const Header& header = *section<Header>(0);
+    if (static_cast<uint64_t>(offset) + length > header.stringsSize) return false;
+    out.assign(section<char>(header.stringsOffset) + offset, length);
+    return true;
+}
+
+bool DatabaseSnapshot::decodeRecord(uint32_t index, bool absolutePath, SidMetadata& meta) const {
+    const Header& header = *section<Header>(0);
+    const Record& record = section<Record>(header.recordsOffset)[index];
+    const StringRef* infoPool = section<StringRef>(header.infoOffset);
+    const double* lengthPool = section<double>(header.lengthsOffset);
+    const float* loudnessPool = section<float>(header.loudnessOffset);
+    auto str = [this](const StringRef& ref, std::string& out) { return readString(ref.offset, ref.length, out); };
+
+    bool ok = str(absolutePath ? record.absolutePath : record.filepath, meta.filepath) &&
+              str(record.filename, meta.filename) && str(record.title, meta.title) &&
+              str(record.author, meta.author) && str(record.released, meta.released) &&
+              str(record.sidModel, meta.sidModel) && str(record.md5Hash, meta.md5Hash);
+    meta.infoStrings.resize(record.infoStrings.count);
+    for (uint32_t k = 0; ok && k < record.infoStrings.count; ++k) {
+        ok = str(infoPool[record.infoStrings.first + k], meta.infoStrings[k]);
+    }
+    // Bornes des pools vérifiées par validate()
+    meta.songLengths.assign(lengthPool + record.songLengths.first,
+                            lengthPool + record.songLengths.first + record.songLengths.count);
+    meta.loudness.assign(loudnessPool + record.loudness.first,
+                         loudnessPool + record.loudness.first + record.loudness.count);
+    meta.fileSize = record.fileSize;
+    meta.lastModified = record.lastModified;
+    meta.numberOfSongs = record.numberOfSongs;
+    meta.defaultSong = record.defaultSong;
+    meta.clockSpeed = record.clockSpeed;
+    meta.metadataHash = record.metadataHash;
+    meta.hvscNum = record.hvscNum;
+    return ok;
+}
+
+bool DatabaseSnapshot::materializeCache(std::vector<SidMetadata>& cache) const {
+    cache.clear();
+    if (!m_data) return false;
+    const Header& header = *section<Header>(0);
+    const RootRecord* rootRecords = section<RootRecord>(header.rootsOffset);
+    const Record* records = section<Record>(header.recordsOffset);
+
+    // Noms des dossiers racines décodés une fois, puis partagés par leurs enregistrements
+    std::vector<std::string> rootFolders(header.rootCount);
+    for (uint32_t r = 0; r < header.rootCount; ++r) {
+        if (!readString(rootRecords[r].rootFolder.offset, rootRecords[r].rootFolder.length, rootFolders[r])) return false;
+    }
+    cache.resize(header.recordCount);
+    for (uint32_t i = 0; i < header.recordCount; ++i) {
+        if (!decodeRecord(i, true, cache[i])) {
+            cache.clear();
+            return false;
+        }
+        cache[i].rootFolder = rootFolders[records[i].rootIndex];
+    }
+    return true;
+}
+
+bool DatabaseSnapshot::materializeRoots(std::vector<RootFolderEntry>& roots) const {
+    roots.clear();
+    if (!m_data) return false;
+    const Header& header = *section<Header>(0);
+    const RootRecord* rootRecords = section<RootRecord>(header.rootsOffset);
+
+    // Enregistrements contigus, dans l'ordre des dossiers racines (= ordre du cache, vérifié par validate())
+    roots.resize(header.rootCount);
+    for (uint32_t r = 0; r < header.rootCount; ++r) {
+        const RootRecord& rootRecord = rootRecords[r];
+        RootFolderEntry& root = roots[r];
+        bool ok = readString(rootRecord.rootPath.offset, rootRecord.rootPath.length, root.rootPath) &&
+                  readString(rootRecord.rootFolder.offset, rootRecord.rootFolder.length, root.rootFolder);
+        root.sidList.resize(rootRecord.recordCount);
+        for (uint32_t i = 0; ok && i < rootRecord.recordCount; ++i) {
+            ok = decodeRecord(rootRecord.firstRecord + i, false, root.sidList[i]);
+        }
+        if (!ok) {
+            roots.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+int64_t DatabaseSnapshot::findPath(std::string_view absolutePath) const {
+    if (!m_data || absolutePath.empty()) return -1;
+    const Header& header = *section<Header>(0);
+    const IndexSlot* slots = section<IndexSlot>(header.pathIndexOffset);
+    const Record* records = section<Record>(header.recordsOffset);
+    uint64_t hash = hashPath(absolutePath);
+    uint32_t tag = static_cast<uint32_t>(hash >> 32);
+    uint32_t mask = header.pathSlots - 1;
+    uint32_t slot = static_cast<uint32_t>(hash) & mask;
+    for (uint32_t probe = 0; probe < header.pathSlots; ++probe, slot = (slot + 1) & mask) {
+        const IndexSlot& entry = slots[slot];
+        if (entry.record == 0) return -1;
+        if (entry.key != tag || entry.record > header.recordCount) continue;
+        const StringRef& ref = records[entry.record - 1].absolutePath;
+        if (stringAt(ref.offset, ref.length) == absolutePath) return entry.record - 1;
+    }
+    return -1;
+}
+
+int64_t DatabaseSnapshot::findHash(uint32_t metadataHash) const {
+    if (!m_data || metadataHash == 0) return -1;
+    const Header& header = *section<Header>(0);
+    const IndexSlot* slots = section<IndexSlot>(header.hashIndexOffset);
+    uint32_t mask = header.hashSlots - 1;
+    uint32_t slot = mixHash(metadataHash) & mask;
+    for (uint32_t probe = 0; probe < header.hashSlots; ++probe, slot = (slot + 1) & mask) {
+        const IndexSlot& entry = slots[slot];
+        if (entry.record == 0) return -1;
+        if (entry.key == metadataHash) return entry.record <= header.recordCount ? entry.record - 1 : -1;
+    }
+    return -1;
+}
+
+std::vector<uint32_t> DatabaseSnapshot::getMetadataHashes() const {
+    std::vector<uint32_t> hashes;
+    if (!m_data) return hashes;
+    const Header& header = *section<Header>(0);
+    const IndexSlot* slots = section<IndexSlot>(header.hashIndexOffset);
+    for (uint32_t slot = 0; slot < header.hashSlots; ++slot) {
+        if (slots[slot].record != 0) hashes.push_back(slots[slot].key);
+    }
+    return hashes;
+}
@@ -0,0 +1,81 @@
+#include "EngineSnapshotPool.h"
+#include <algorithm>
+
+EngineSnapshotPool::EngineSnapshotPool()
+    : m_memoryBudget(0), m_useCounter(0), m_hits(0), m_misses(0)
+{
+}
+
+void EngineSnapshotPool::setMemoryBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_memoryBudget = bytes;
+    evictToCapacity(getCapacity());
+}
+
+size_t EngineSnapshotPool::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_snapshots.size();
+}
+
+bool EngineSnapshotPool::hasFreeSlot() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_snapshots.size() < getCapacity();
+}
+
+bool EngineSnapshotPool::contains(int song, int64_t samplePos) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const EngineSnapshot& snapshot : m_snapshots) {
+        if (snapshot.song == song && snapshot.samplePos == samplePos) return true;
+    }
+    return false;
+}
+
+bool EngineSnapshotPool::take(int song, int64_t minPos, int64_t maxPos, EngineSnapshot& out) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto best = m_snapshots.end();
+    for (auto it = m_snapshots.begin(); it != m_snapshots.end(); ++it) {
+        if (it->song != song || it->samplePos < minPos || it->samplePos > maxPos) continue;
+        if (best == m_snapshots.end() || it->samplePos > best->samplePos) best = it;
+    }
+    if (best == m_snapshots.end()) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    out = std::move(*best);
+    m_snapshots.erase(best);
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool EngineSnapshotPool::park(EngineSnapshot&& snapshot) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t capacity = getCapacity();
+    if (capacity == 0 || !snapshot.engine) return false;
+    // Une seule entrée par position : la nouvelle remplace l'ancienne
+    m_snapshots.erase(std::remove_if(m_snapshots.begin(), m_snapshots.end(), [&](const EngineSnapshot& s) {
+        return s.song == snapshot.song && s.samplePos == snapshot.samplePos;
+    }), m_snapshots.end());
+    evictToCapacity(capacity - 1);
+    snapshot.lastUse = ++m_useCounter;
+    m_snapshots.push_back(std::move(snapshot));
+    return true;
+}
+
+void EngineSnapshotPool::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_snapshots.clear();
+}
+
+float EngineSnapshotPool::getHitRate() const {
+    uint64_t hits = getHits();
+    uint64_t total = hits + getMisses();
+    return total > 0 ? static_cast<float>(hits) / total : 0.0f;
+}
+
+void EngineSnapshotPool::evictToCapacity(size_t capacity) {
+    while (m_snapshots.size() > capacity) {
+        auto oldest = std::min_element(m_snapshots.begin(), m_snapshots.end(),
+            [](const EngineSnapshot& a, const EngineSnapshot& b) { return a.lastUse < b.lastUse; });
+        m_snapshots.erase(oldest);
+    }
+}
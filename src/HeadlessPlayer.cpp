@@ -0,0 +1,157 @@
+#include "HeadlessPlayer.h"
+#include "SidPlayer.h"
+#include "AudioSink.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    const double DEFAULT_SECONDS = 10.0;
+    const double PRELOAD_LEAD_S = 3.0;  // Préchargement du suivant avant la bascule (comme l'UI)
+
+    struct HeadlessOptions {
+        std::vector<std::string> files;
+        AudioSinkType sink = AudioSinkType::Null;
+        std::string outputPath;
+        double seconds = DEFAULT_SECONDS;
+        int sampleRate = 44100;
+        int bufferSize = 256;
+        int emulationRate = 0;
+        bool fastSampling = false;
+        bool analysis = false;         // Moteurs d'analyse / taps actifs (oscilloscopes "visibles")
+        std::string timingReport;
+        bool failOnUnderrun = false;
+    };
+
+    void printPlayUsage() {
+        std::cerr << "Usage: imSidPlayer --play <tune.sid> [more.sid ...] [options]\n"
+                  << "  --sink null|file      Output (default: null, clocked by a high-resolution timer)\n"
+                  << "  -o, --output PATH     File written by the file sink (.wav, .flac or .raw)\n"
+                  << "  --seconds S           Playback time per tune (default: " << DEFAULT_SECONDS << ")\n"
+                  << "  --rate HZ             Output sample rate (default: 44100)\n"
+                  << "  --buffer N            Output buffer in frames (default: 256)\n"
+                  << "  --emulation-rate HZ   Fixed emulation rate, resampled to the output (default: output rate)\n"
+                  << "  --fast-sampling       reSIDfp interpolation instead of resampling\n"
+                  << "  --analysis            Keep the per-voice analysis running (as with visible scopes)\n"
+                  << "  --timing-report PATH  Append the timing report to PATH\n"
+                  << "  --fail-on-underrun    Exit with status 3 if any callback underran\n";
+    }
+
+    // Attendre jusqu'à l'échéance (temps mur : la sortie est cadencée en temps réel)
+    void waitUntil(std::chrono::steady_clock::time_point deadline) {
+        while (std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+}
+
+bool isHeadlessPlayCommand(int argc, char* argv[]) {
+    return argc > 1 && std::strcmp(argv[1], "--play") == 0;
+}
+
+int runHeadlessPlayCommand(int argc, char* argv[]) {
+    HeadlessOptions options;
+    try {
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = (i + 1 < argc);
+            if (arg == "--sink" && hasValue) {
+                if (!AudioSink::typeFromName(argv[++i], options.sink) || options.sink == AudioSinkType::Sdl) {
+                    printPlayUsage();
+                    return 2;
+                }
+            }
+            else if ((arg == "-o" || arg == "--output") && hasValue) options.outputPath = argv[++i];
+            else if (arg == "--seconds" && hasValue) options.seconds = std::max(1.0, std::stod(argv[++i]));
+            else if (arg == "--rate" && hasValue) options.sampleRate = std::stoi(argv[++i]);
+            else if (arg == "--buffer" && hasValue) options.bufferSize = std::stoi(argv[++i]);
+            else if (arg == "--emulation-rate" && hasValue) options.emulationRate = std::stoi(argv[++i]);
+            else if (arg == "--fast-sampling") options.fastSampling = true;
+            else if (arg == "--analysis") options.analysis = true;
+            else if (arg == "--timing-report" && hasValue) options.timingReport = argv[++i];
+            else if (arg == "--fail-on-underrun") options.failOnUnderrun = true;
+            else if (!arg.empty() && arg[0] != '-') options.files.push_back(arg);
+            else { printPlayUsage(); return 2; }
+        }
+    } catch (...) {
+        printPlayUsage();
+        return 2;
+    }
+    if (options.files.empty() || (options.sink == AudioSinkType::File && options.outputPath.empty())) {
+        printPlayUsage();
+        return 2;
+    }
+
+    SidPlayer player;
+    player.setAudioSink(options.sink, options.outputPath);
+    player.setAudioSettings(options.sampleRate, options.bufferSize);
+    player.setEmulationSettings(options.emulationRate, options.fastSampling);
+    player.setAnalysisVisible(options.analysis);
+
+    int failures = 0;
+    int gapless = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < options.files.size(); ++i) {
+        const std::string& file = options.files[i];
+        // Bascule sans blanc si le préchargement est prêt, sinon chargement classique
+        bool viaPreload = (i > 0) && player.playPreloadedFile(file);
+        bool started = viaPreload;
+        if (viaPreload) {
+            gapless++;
+        } else if (player.loadFile(file)) {
+            player.play();
+            started = true;
+        }
+        if (!started) {
+            std::string error = player.getAudioSinkError();
+            std::cerr << file << ": cannot play" << (error.empty() ? "" : " (" + error + ")") << "\n";
+            failures++;
+            continue;
+        }
+        auto tuneStart = std::chrono::steady_clock::now();
+        std::cout << file << ": playing " << options.seconds << " s" << (viaPreload ? " (gapless)" : "") << "\n";
+        auto tuneEnd = tuneStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(options.seconds));
+        if (i + 1 < options.files.size()) {
+            waitUntil(tuneEnd - std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(std::min(PRELOAD_LEAD_S, options.seconds / 2))));
+            player.preloadNextFile(options.files[i + 1]);
+        }
+        waitUntil(tuneEnd);
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    player.closeAudioOutput(); // Finalise le fichier de la sortie file
+
+    const AudioTimingStats& timing = player.getTimingStats();
+    std::cout << "\nOutput: " << player.getAudioSinkName() << ", " << player.getSampleRate() << " Hz, "
+              << player.getDeviceBufferSize() << " frames; emulation " << player.getEmulationRate() << " Hz"
+              << (player.isResampling() ? " (resampled)" : "") << "\n";
+    std::cout << "Tunes: " << (options.files.size() - failures) << " played, " << gapless << " gapless transitions, "
+              << failures << " failed, " << wallSeconds << " s\n";
+    std::cout << "Underruns: " << timing.getUnderruns() << ", late callbacks: " << timing.getLateCallbacks()
+              << ", block overruns: " << timing.getOverruns() << "\n";
+    for (int stage = 0; stage < AudioTimingStats::STAGE_COUNT; ++stage) {
+        AudioTimingStats::Summary summary = timing.getSummary(stage);
+        if (summary.count == 0) continue;
+        std::cout << "  " << AudioTimingStats::stageName(stage) << ": mean " << summary.meanUs << " us, p99 <= "
+                  << summary.p99Us << " us, max " << summary.maxUs << " us (" << summary.count << ")\n";
+    }
+    // Débit d'émulation pur : durée audio d'un bloc rapportée à son temps de calcul moyen
+    AudioTimingStats::Summary block = timing.getSummary(AudioTimingStats::STAGE_BLOCK);
+    if (block.count > 0 && block.meanUs > 0.0) {
+        std::cout << "Emulation throughput: " << (timing.getBlockBudgetNs() / 1000.0) / block.meanUs << "x real time\n";
+    }
+    if (!options.timingReport.empty() && !player.dumpTimingStats(options.timingReport)) {
+        std::cerr << "Cannot write timing report to " << options.timingReport << "\n";
+    }
+    std::string sinkError = player.getAudioSinkError();
+    if (!sinkError.empty()) std::cerr << "Output error: " << sinkError << "\n";
+
+    if (failures > 0 || !sinkError.empty()) return 1;
+    if (options.failOnUnderrun && timing.getUnderruns() > 0) return 3;
+    return 0;
+}
@@ -0,0 +1,213 @@
+#include "IndexingPipeline.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+IndexingPipeline::IndexingPipeline(int workers, size_t queueCapacity)
+    : m_queueCapacity(queueCapacity > 0 ? queueCapacity : DEFAULT_QUEUE_CAPACITY) {
+    if (workers <= 0) {
+        workers = std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    m_workerCount = std::min(workers, MAX_WORKERS);
+}
+
+size_t IndexingPipeline::run(const std::vector<Job>& jobs, const CommitFn& commit, const ProgressFn& progress) {
+    for (auto& stage : m_stages) {
+        stage.items = 0;
+        stage.bytes = 0;
+        stage.busyNs = 0;
+    }
+    m_skipped = 0;
+    m_missing = 0;
+    m_failed = 0;
+    m_committed = 0;
+    m_wallNs = 0;
+
+    auto runStart = std::chrono::steady_clock::now();
+    BoundedQueue<Job> jobQueue(m_queueCapacity);
+    BoundedQueue<Result> resultQueue(m_queueCapacity);
+    {
+        std::lock_guard<std::mutex> lock(m_queuesMutex);
+        m_jobs = &jobQueue;
+        m_results = &resultQueue;
+        if (m_cancelled) {
+            jobQueue.abort();
+            resultQueue.abort();
+        }
+    }
+
+    m_activeWorkers = m_workerCount;
+    std::thread walker(&IndexingPipeline::walk, this, std::cref(jobs));
+    std::vector<std::thread> workers;
+    workers.reserve(m_workerCount);
+    for (int i = 0; i < m_workerCount; ++i) {
+        workers.emplace_back(&IndexingPipeline::work, this);
+    }
+
+    // Validation : seul ce thread touche à la base
+    size_t changed = 0;
+    const size_t total = jobs.size();
+    auto lastProgress = std::chrono::steady_clock::now();
+    std::string lastPath;
+    for (;;) {
+        Result result;
+        auto status = resultQueue.popFor(result, std::chrono::milliseconds(100));
+        if (status == BoundedQueue<Result>::PopStatus::Closed) break;
+        if (status == BoundedQueue<Result>::PopStatus::Item && !m_cancelled) {
+            auto start = std::chrono::steady_clock::now();
+            if (commit(result)) changed++;
+            m_committed++;
+            count(STAGE_COMMIT, start);
+            lastPath = result.job.filepath;
+        }
+        // Rythme limité : le callback met à jour l'UI
+        auto now = std::chrono::steady_clock::now();
+        if (progress && now - lastProgress >= std::chrono::milliseconds(50)) {
+            lastProgress = now;
+            progress(lastPath, static_cast<size_t>(m_skipped + m_missing + m_failed + m_committed), total);
+        }
+    }
+
+    walker.join();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_queuesMutex);
+        m_jobs = nullptr;
+        m_results = nullptr;
+    }
+    m_wallNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - runStart).count());
+    if (progress && !m_cancelled) {
+        progress(lastPath, static_cast<size_t>(m_skipped + m_missing + m_failed + m_committed), total);
+    }
+    return changed;
+}
+
+void IndexingPipeline::walk(const std::vector<Job>& jobs) {
+    for (const auto& job : jobs) {
+        if (m_cancelled) break;
+        auto start = std::chrono::steady_clock::now();
+        // Un seul stat : existence, taille et date
+        Job next = job;
+        if (!SidMetadata::statFile(job.filepath, next.stamp.fileSize, next.stamp.lastModified)) {
+            m_missing++;
+            count(STAGE_WALK, start);
+            continue;
+        }
+        auto known = m_known.find(job.filepath);
+        if (known != m_known.end() && known->second.fileSize == next.stamp.fileSize &&
+            known->second.lastModified == next.stamp.lastModified) {
+            m_skipped++;
+            count(STAGE_WALK, start);
+            continue;
+        }
+        count(STAGE_WALK, start);
+        if (!m_jobs->push(std::move(next))) break; // Annulé
+    }
+    m_jobs->close();
+}
+
+void IndexingPipeline::work() {
+    lowerCurrentThreadPriority();
+    std::vector<uint8_t> buffer;
+    Job job;
+    while (m_jobs->pop(job)) {
+        if (m_cancelled) break;
+
+        // Lecture unique du fichier, réutilisée par l'analyse et le MD5
+        auto start = std::chrono::steady_clock::now();
+        bool ok = readFileBytes(job.filepath, buffer, MAX_FILE_BYTES);
+        count(STAGE_READ, start, ok ? buffer.size() : 0);
+        if (!ok) {
+            m_failed++;
+            continue;
+        }
+
+        Result result;
+        result.job = job;
+        start = std::chrono::steady_clock::now();
+        ok = m_extract ? m_extract(job.filepath, buffer.data(), buffer.size(), result.metadata)
+                       : SidMetadata::fromFileData(job.filepath, buffer.data(), buffer.size(), result.metadata);
+        count(STAGE_PARSE, start, buffer.size());
+        if (!ok) {
+            m_failed++;
+            continue;
+        }
+        result.metadata.fileSize = static_cast<int64_t>(buffer.size());
+        result.metadata.lastModified = job.stamp.lastModified;
+
+        start = std::chrono::steady_clock::now();
+        result.metadata.md5Hash = calculateDataMD5(buffer.data(), buffer.size());
+        count(STAGE_HASH, start, buffer.size());
+
+        if (!m_results->push(std::move(result))) break; // Annulé
+    }
+    // Le dernier worker ferme la file des résultats : la validation sait alors que tout est arrivé
+    if (--m_activeWorkers == 0) {
+        m_results->close();
+    }
+}
+
+void IndexingPipeline::count(Stage stage, std::chrono::steady_clock::time_point start, uint64_t bytes) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    m_stages[stage].items.fetch_add(1, std::memory_order_relaxed);
+    m_stages[stage].bytes.fetch_add(bytes, std::memory_order_relaxed);
+    m_stages[stage].busyNs.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+}
+
+void IndexingPipeline::cancel() {
+    m_cancelled = true;
+    std::lock_guard<std::mutex> lock(m_queuesMutex);
+    if (m_jobs) m_jobs->abort();
+    if (m_results) m_results->abort();
+}
+
+IndexingPipeline::Stats IndexingPipeline::getStats() const {
+    Stats stats;
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+        stats.stages[i].items = m_stages[i].items.load();
+        stats.stages[i].bytes = m_stages[i].bytes.load();
+        stats.stages[i].busyNs = m_stages[i].busyNs.load();
+    }
+    stats.skipped = m_skipped.load();
+    stats.missing = m_missing.load();
+    stats.failed = m_failed.load();
+    stats.committed = m_committed.load();
+    stats.workers = m_workerCount;
+    stats.wallSeconds = m_wallNs.load() / 1e9;
+    stats.cancelled = m_cancelled.load();
+    return stats;
+}
+
+const char* IndexingPipeline::stageName(int stage) {
+    switch (stage) {
+        case STAGE_WALK: return "walk";
+        case STAGE_READ: return "read";
+        case STAGE_PARSE: return "parse";
+        case STAGE_HASH: return "hash";
+        case STAGE_COMMIT: return "commit";
+        default: return "?";
+    }
+}
+
+std::string IndexingPipeline::formatStats(const Stats& stats) {
+    char line[160];
+    std::snprintf(line, sizeof(line), "%llu committed, %llu unchanged, %llu missing, %llu failed in %.2f s (%d workers%s)",
+                  static_cast<unsigned long long>(stats.committed), static_cast<unsigned long long>(stats.skipped),
+                  static_cast<unsigned long long>(stats.missing), static_cast<unsigned long long>(stats.failed),
+                  stats.wallSeconds, stats.workers, stats.cancelled ? ", cancelled" : "");
+    std::string text = line;
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+        const StageStats& stage = stats.stages[i];
+        if (stage.items == 0) continue;
+        double busy = stage.busyNs / 1e9;
+        std::snprintf(line, sizeof(line), "\n  %-6s %8llu items, %8.1f MB, busy %.2f s, %.0f items/s, %.1f MB/s",
+                      stageName(i), static_cast<unsigned long long>(stage.items), stage.bytes / 1e6, busy,
+                      busy > 0.0 ? stage.items / busy : 0.0, busy > 0.0 ? stage.bytes / 1e6 / busy : 0.0);
+        text += line;
+    }
+    return text;
+}
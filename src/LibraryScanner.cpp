@@ -0,0 +1,344 @@
+#include "LibraryScanner.h"
+#include "Utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+#include <sys/stat.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+    const char MAGIC[8] = {'I', 'M', 'S', 'I', 'D', 'J', 'N', 'L'};
+    const uint32_t ENDIAN_MARK = 0x01020304;
+    const size_t MAX_JOURNAL_BYTES = 512u * 1024 * 1024;
+
+    struct EntryStat {
+        bool isDirectory = false;
+        bool isRegular = false;
+        uint64_t inode = 0;         // 0 sous Windows (non fourni par _wstat64)
+        int64_t size = 0;
+        int64_t mtimeNs = 0;
+    };
+
+    // Un seul stat (suit les liens symboliques, comme le parcours de PlaylistManager)
+    bool statEntry(const std::string& path, EntryStat& out) {
+#ifdef _WIN32
+        struct _stat64 st;
+        if (_wstat64(fs::path(path).c_str(), &st) != 0) return false;
+        out.isDirectory = (st.st_mode & _S_IFDIR) != 0;
+        out.isRegular = (st.st_mode & _S_IFREG) != 0;
+        out.inode = 0;
+        out.mtimeNs = static_cast<int64_t>(st.st_mtime) * 1000000000LL;
+#else
+        struct stat st;
+        if (::stat(path.c_str(), &st) != 0) return false;
+        out.isDirectory = S_ISDIR(st.st_mode);
+        out.isRegular = S_ISREG(st.st_mode);
+        out.inode = static_cast<uint64_t>(st.st_ino);
+#ifdef __APPLE__
+        out.mtimeNs = static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000LL + st.st_mtimespec.tv_nsec;
+#else
+        out.mtimeNs = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+#endif
+        out.size = static_cast<int64_t>(st.st_size);
+        return true;
+    }
+
+    bool isSidFile(const std::string& name) {
+        if (name.size() < 4) return false;
+        std::string ext = name.substr(name.size() - 4);
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        return ext == ".sid";
+    }
+
+    // Équivalent de (fs::path(dir) / name).string() sans construire de fs::path (appelé pour chaque fichier)
+    std::string childPath(const std::string& dir, const std::string& name) {
+        std::string path;
+        path.reserve(dir.size() + 1 + name.size());
+        path = dir;
+        if (!path.empty() && path.back() != '/' && path.back() != static_cast<char>(fs::path::preferred_separator)) {
+            path += static_cast<char>(fs::path::preferred_separator);
+        }
+        path += name;
+        return path;
+    }
+
+    class Writer {
+    public:
+        template <typename T> void put(const T& value) {
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            m_data.insert(m_data.end(), bytes, bytes + sizeof(T));
+        }
+        void putString(const std::string& value) {
+            put(static_cast<uint32_t>(value.size()));
+            m_data.insert(m_data.end(), value.begin(), value.end());
+        }
+        const std::vector<char>& data() const { return m_data; }
+    private:
+        std::vector<char> m_data;
+    };
+
+    // Lecture bornée : toute lecture hors du tampon invalide le journal
+    class Reader {
+    public:
+        Reader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+        template <typename T> bool get(T& value) {
+            if (m_size - m_pos < sizeof(T)) return false;
+            std::memcpy(&value, m_data + m_pos, sizeof(T));
+            m_pos += sizeof(T);
+            return true;
+        }
+        bool getString(std::string& value) {
+            uint32_t length = 0;
+            if (!get(length) || m_size - m_pos < length) return false;
+            value.assign(reinterpret_cast<const char*>(m_data + m_pos), length);
+            m_pos += length;
+            return true;
+        }
+        bool atEnd() const { return m_pos == m_size; }
+    private:
+        const uint8_t* m_data;
+        size_t m_size;
+        size_t m_pos = 0;
+    };
+}
+
+bool LibraryScanner::load(const std::string& path) {
+    m_dirs.clear();
+    m_lastError.clear();
+    std::vector<uint8_t> data;
+    if (!readFileBytes(path, data, MAX_JOURNAL_BYTES)) {
+        m_lastError = "Cannot read " + path;
+        return false;
+    }
+
+    Reader reader(data.data(), data.size());
+    char magic[8];
+    uint32_t version = 0;
+    uint32_t endianMark = 0;
+    uint64_t dirCount = 0;
+    if (!reader.get(magic) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        m_lastError = "Not a scan journal";
+        return false;
+    }
+    if (!reader.get(version) || version != VERSION) {
+        m_lastError = "Unsupported scan journal version " + std::to_string(version);
+        return false;
+    }
+    if (!reader.get(endianMark) || endianMark != ENDIAN_MARK || !reader.get(dirCount)) {
+        m_lastError = "Scan journal written on a machine with another byte order";
+        return false;
+    }
+
+    DirMap dirs;
+    dirs.reserve(static_cast<size_t>(std::min<uint64_t>(dirCount, data.size())));
+    for (uint64_t i = 0; i < dirCount; ++i) {
+        std::string dirPath;
+        DirEntry entry;
+        uint32_t subdirCount = 0;
+        uint32_t fileCount = 0;
+        if (!reader.getString(dirPath) || !reader.get(entry.mtimeNs) || !reader.get(subdirCount) || !reader.get(fileCount)) {
+            m_lastError = "Truncated scan journal";
+            return false;
+        }
+        entry.subdirs.resize(subdirCount);
+        for (auto& name : entry.subdirs) {
+            if (!reader.getString(name)) {
+                m_lastError = "Truncated scan journal";
+                return false;
+            }
+        }
+        entry.files.resize(fileCount);
+        for (auto& file : entry.files) {
+            if (!reader.getString(file.name) || !reader.get(file.inode) || !reader.get(file.size) || !reader.get(file.mtimeNs)) {
+                m_lastError = "Truncated scan journal";
+                return false;
+            }
+        }
+        dirs[dirPath] = std::move(entry);
+    }
+    if (!reader.atEnd()) {
+        m_lastError = "Scan journal size mismatch";
+        return false;
+    }
+    m_dirs = std::move(dirs);
+    return true;
+}
+
+bool LibraryScanner::save(const std::string& path) const {
+    Writer writer;
+    const uint32_t version = VERSION;
+    writer.put(MAGIC);
+    writer.put(version);
+    writer.put(ENDIAN_MARK);
+    writer.put(static_cast<uint64_t>(m_dirs.size()));
+    for (const auto& [dirPath, entry] : m_dirs) {
+        writer.putString(dirPath);
+        writer.put(entry.mtimeNs);
+        writer.put(static_cast<uint32_t>(entry.subdirs.size()));
+        writer.put(static_cast<uint32_t>(entry.files.size()));
+        for (const auto& name : entry.subdirs) {
+            writer.putString(name);
+        }
+        for (const auto& file : entry.files) {
+            writer.putString(file.name);
+            writer.put(file.inode);
+            writer.put(file.size);
+            writer.put(file.mtimeNs);
+        }
+    }
+
+    // Fichier temporaire puis renommage : un journal est complet ou absent, jamais tronqué
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file.write(writer.data().data(), static_cast<std::streamsize>(writer.data().size()));
+        if (!file) {
+            file.close();
+            std::error_code ec;
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+LibraryScanner::Changes LibraryScanner::scan(const std::vector<Root>& roots, const KnownFiles& known,
+                                             const std::atomic<bool>* stop) {
+    auto start = std::chrono::steady_clock::now();
+    Changes changes;
+    DirMap visited;
+    visited.reserve(m_dirs.size());
+
+    for (const auto& root : roots) {
+        std::vector<std::string> pending{root.rootPath};
+        while (!pending.empty()) {
+            if (stop && stop->load()) {
+                changes.cancelled = true;
+                changes.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                return changes;
+            }
+            std::string dir = std::move(pending.back());
+            pending.pop_back();
+            if (visited.count(dir)) continue; // Racines imbriquées
+
+            auto previous = m_dirs.find(dir);
+            const DirEntry* old = (previous != m_dirs.end()) ? &previous->second : nullptr;
+            EntryStat dirStat;
+            if (!statEntry(dir, dirStat) || !dirStat.isDirectory) {
+                if (old) collectRemoved(dir, changes);
+                continue;
+            }
+            changes.directories++;
+
+            // Liste du dossier : reprise du journal si sa date n'a pas bougé, sinon relue
+            DirEntry entry;
+            entry.mtimeNs = dirStat.mtimeNs;
+            std::vector<std::string> fileNames;
+            if (old && old->mtimeNs == dirStat.mtimeNs) {
+                entry.subdirs = old->subdirs;
+                fileNames.reserve(old->files.size());
+                for (const auto& file : old->files) {
+                    fileNames.push_back(file.name);
+                }
+            } else {
+                changes.directoriesListed++;
+                std::error_code ec;
+                for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+                    std::error_code typeEc;
+                    std::string name = it->path().filename().string();
+                    if (it->is_directory(typeEc)) {
+                        entry.subdirs.push_back(name);
+                    } else if (it->is_regular_file(typeEc) && isSidFile(name)) {
+                        fileNames.push_back(name);
+                    }
+                }
+            }
+
+            // Fichiers : un stat chacun, comparé au journal (inode, taille, date)
+            std::unordered_map<std::string, const FileEntry*> oldFiles;
+            if (old) {
+                oldFiles.reserve(old->files.size());
+                for (const auto& file : old->files) {
+                    oldFiles[file.name] = &file;
+                }
+            }
+            entry.files.reserve(fileNames.size());
+            for (const auto& name : fileNames) {
+                std::string filepath = childPath(dir, name);
+                EntryStat fileStat;
+                if (!statEntry(filepath, fileStat) || !fileStat.isRegular) {
+                    continue; // Disparu : rendu comme supprimé ci-dessous s'il était connu
+                }
+                entry.files.push_back({name, fileStat.inode, fileStat.size, fileStat.mtimeNs});
+
+                auto oldFile = oldFiles.find(name);
+                if (oldFile == oldFiles.end()) {
+                    changes.added++;
+                    changes.changed.push_back({filepath, root.rootFolder, {}});
+                    continue;
+                }
+                const FileEntry& before = *oldFile->second;
+                oldFiles.erase(oldFile);
+                if (before.inode != fileStat.inode || before.size != fileStat.size || before.mtimeNs != fileStat.mtimeNs) {
+                    changes.modified++;
+                    changes.changed.push_back({filepath, root.rootFolder, {}});
+                } else if (!known.count(filepath)) {
+                    // Inchangé sur disque mais absent de la base (base vidée, indexation interrompue...)
+                    changes.added++;
+                    changes.changed.push_back({filepath, root.rootFolder, {}});
+                } else {
+                    changes.unchanged++;
+                }
+            }
+            for (const auto& [name, file] : oldFiles) {
+                changes.removed.push_back(childPath(dir, name));
+            }
+
+            // Sous-dossiers disparus : tout leur sous-arbre du journal est supprimé
+            if (old) {
+                std::unordered_set<std::string> current(entry.subdirs.begin(), entry.subdirs.end());
+                for (const auto& name : old->subdirs) {
+                    if (!current.count(name)) collectRemoved(childPath(dir, name), changes);
+                }
+            }
+            for (const auto& name : entry.subdirs) {
+                pending.push_back(childPath(dir, name));
+            }
+            visited[dir] = std::move(entry);
+        }
+    }
+
+    m_dirs = std::move(visited);
+    changes.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return changes;
+}
+
+void LibraryScanner::collectRemoved(const std::string& dir, Changes& changes) const {
+    std::vector<std::string> pending{dir};
+    while (!pending.empty()) {
+        std::string current = std::move(pending.back());
+        pending.pop_back();
+        auto it = m_dirs.find(current);
+        if (it == m_dirs.end()) continue;
+        for (const auto& file : it->second.files) {
+            changes.removed.push_back(childPath(current, file.name));
+        }
+        for (const auto& name : it->second.subdirs) {
+            pending.push_back(childPath(current, name));
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#include "LoudnessAnalyzer.h"
+#include "OfflineRenderer.h"
+#include "SongLengthDB.h"
+#include "Logger.h"
+#include "Utils.h"
+#include <algorithm>
+
+LoudnessAnalyzer& LoudnessAnalyzer::getInstance() {
+    static LoudnessAnalyzer instance;
+    return instance;
+}
+
+LoudnessAnalyzer::~LoudnessAnalyzer() {
+    shutdown();
+}
+
+void LoudnessAnalyzer::request(const std::string& filepath, const std::string& md5Hash, int numberOfSongs) {
+    if (filepath.empty()) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stopping) return;
+    if (!m_known.insert(filepath).second) return;
+    m_queue.push_back(Job{filepath, md5Hash, std::max(1, numberOfSongs)});
+    if (!m_running) {
+        m_running = true;
+        m_worker = std::thread(&LoudnessAnalyzer::workerLoop, this);
+    }
+    m_condition.notify_one();
+}
+
+std::vector<LoudnessAnalyzer::Result> LoudnessAnalyzer::takeResults() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Result> results;
+    results.swap(m_results);
+    return results;
+}
+
+void LoudnessAnalyzer::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_running = false;
+        m_queue.clear();
+    }
+    m_condition.notify_all();
+    if (m_worker.joinable()) m_worker.join();
+}
+
+size_t LoudnessAnalyzer::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size() + m_activeJobs;
+}
+
+void LoudnessAnalyzer::workerLoop() {
+    lowerCurrentThreadPriority();
+    OfflineRenderer renderer; // Moteur réutilisé d'un tune à l'autre
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return !m_running || !m_queue.empty(); });
+            if (!m_running) return;
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_activeJobs++;
+        }
+
+        std::vector<double> durations = SongLengthDB::getInstance().getDurations(job.md5Hash);
+        Result result;
+        result.filepath = job.filepath;
+        for (int song = 1; song <= job.numberOfSongs && !m_stopping; ++song) {
+            OfflineRenderOptions options;
+            options.inputPath = job.filepath;
+            options.song = song;
+            options.sampleRate = ANALYSIS_SAMPLE_RATE;
+            options.cancel = &m_stopping;
+            double duration = (song - 1 < static_cast<int>(durations.size())) ? durations[song - 1] : 0.0;
+            options.durationSeconds = std::min(duration > 0.0 ? duration : DEFAULT_ANALYSIS_S, MAX_ANALYSIS_S);
+            OfflineRenderResult rendered;
+            if (!renderer.render(options, rendered)) {
+                if (!m_stopping) LOG_WARNING("Loudness analysis failed for {} #{}: {}", job.filepath, song, renderer.getLastError());
+                break;
+            }
+            result.loudness.push_back(static_cast<float>(rendered.loudnessLufs));
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_activeJobs--;
+        if (!m_stopping && static_cast<int>(result.loudness.size()) == job.numberOfSongs) {
+            m_results.push_back(std::move(result));
+            m_analyzedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,127 @@
+#include "LoudnessMeter.h"
+#include "AudioKernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace imsid {
+namespace audio {
+
+namespace {
+    const double PI = 3.14159265358979323846;
+    const double ABSOLUTE_GATE_LUFS = -70.0;
+    const double RELATIVE_GATE_LU = -10.0;
+    const int SEGMENTS_PER_BLOCK = 4;  // 400 ms
+
+    double toLufs(double meanSquare) {
+        return -0.691 + 10.0 * std::log10(meanSquare);
+    }
+
+    double fromLufs(double lufs) {
+        return std::pow(10.0, (lufs + 0.691) / 10.0);
+    }
+}
+
+LoudnessMeter::LoudnessMeter(int sampleRate)
+    : m_segmentLength(std::max(1, sampleRate / 10)), m_segmentFill(0), m_segmentSum(0.0) {
+    // Étage 1 : shelf haute fréquence (+4 dB au-dessus de ~1.7 kHz), paramètres analogiques de BS.1770
+    double f0 = 1681.974450955533;
+    double gainDb = 3.999843853973347;
+    double q = 0.7071752369554196;
+    double k = std::tan(PI * f0 / sampleRate);
+    double vh = std::pow(10.0, gainDb / 20.0);
+    double vb = std::pow(vh, 0.4996667741545416);
+    double a0 = 1.0 + k / q + k * k;
+    m_shelf.b0 = (vh + vb * k / q + k * k) / a0;
+    m_shelf.b1 = 2.0 * (k * k - vh) / a0;
+    m_shelf.b2 = (vh - vb * k / q + k * k) / a0;
+    m_shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+    m_shelf.a2 = (1.0 - k / q + k * k) / a0;
+
+    // Étage 2 : passe-haut RLB (~38 Hz)
+    f0 = 38.13547087602444;
+    q = 0.5003270373238773;
+    k = std::tan(PI * f0 / sampleRate);
+    a0 = 1.0 + k / q + k * k;
+    m_highPass.b0 = 1.0;
+    m_highPass.b1 = -2.0;
+    m_highPass.b2 = 1.0;
+    m_highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+    m_highPass.a2 = (1.0 - k / q + k * k) / a0;
+}
+
+void LoudnessMeter::reset() {
+    m_shelf.z1 = m_shelf.z2 = 0.0;
+    m_highPass.z1 = m_highPass.z2 = 0.0;
+    m_segmentFill = 0;
+    m_segmentSum = 0.0;
+    m_segments.clear();
+}
+
+void LoudnessMeter::process(const int16_t* samples, int count) {
+    while (count > 0) {
+        // Tranche bornée par le buffer et par la fin du segment courant
+        int n = std::min({count, CHUNK, m_segmentLength - m_segmentFill});
+        int16ToFloat(samples, m_input, n);
+
+        Biquad s = m_shelf;
+        Biquad h = m_highPass;
+        for (int i = 0; i < n; ++i) {
+            double x = m_input[i];
+            double y = s.b0 * x + s.z1;
+            s.z1 = s.b1 * x - s.a1 * y + s.z2;
+            s.z2 = s.b2 * x - s.a2 * y;
+            double w = h.b0 * y + h.z1;
+            h.z1 = h.b1 * y - h.a1 * w + h.z2;
+            h.z2 = h.b2 * y - h.a2 * w;
+            m_filtered[i] = static_cast<float>(w);
+        }
+        m_shelf = s;
+        m_highPass = h;
+
+        float sum = 0.0f;
+        for (int i = 0; i < n; ++i) sum += m_filtered[i] * m_filtered[i];
+        m_segmentSum += sum;
+        m_segmentFill += n;
+        if (m_segmentFill == m_segmentLength) {
+            m_segments.push_back(m_segmentSum / m_segmentLength);
+            m_segmentFill = 0;
+            m_segmentSum = 0.0;
+        }
+        samples += n;
+        count -= n;
+    }
+}
+
+double LoudnessMeter::getIntegratedLufs() const {
+    // Blocs de 400 ms glissant par pas de 100 ms (un segment partiel en fin de signal est ignoré)
+    std::vector<double> blocks;
+    if (m_segments.size() >= SEGMENTS_PER_BLOCK) {
+        blocks.reserve(m_segments.size() - SEGMENTS_PER_BLOCK + 1);
+        for (size_t i = SEGMENTS_PER_BLOCK - 1; i < m_segments.size(); ++i) {
+            double energy = 0.0;
+            for (int j = 0; j < SEGMENTS_PER_BLOCK; ++j) energy += m_segments[i - j];
+            blocks.push_back(energy / SEGMENTS_PER_BLOCK);
+        }
+    }
+
+    auto gatedMean = [&blocks](double threshold, double& mean) {
+        double sum = 0.0;
+        size_t n = 0;
+        for (double block : blocks) {
+            if (block > threshold) { sum += block; n++; }
+        }
+        if (n == 0) return false;
+        mean = sum / n;
+        return true;
+    };
+
+    double absoluteMean = 0.0;
+    if (!gatedMean(fromLufs(ABSOLUTE_GATE_LUFS), absoluteMean)) return SILENCE_LUFS;
+    double relativeThreshold = fromLufs(toLufs(absoluteMean) + RELATIVE_GATE_LU);
+    double mean = absoluteMean;
+    gatedMean(relativeThreshold, mean);
+    return std::max(SILENCE_LUFS, toLufs(mean));
+}
+
+} // namespace audio
+} // namespace imsid
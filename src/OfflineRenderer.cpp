@@ -0,0 +1,185 @@
+#include "OfflineRenderer.h"
+#include "AudioFileWriter.h"
+#include "LoudnessMeter.h"
+#include "Config.h"
+#include "SongLengthDB.h"
+#include "Utils.h"
+#include <sidplayfp/SidConfig.h>
+#include <sidplayfp/SidInfo.h>
+#include <sidplayfp/SidTuneInfo.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+OfflineRenderer::OfflineRenderer() {
+    m_engine = std::make_unique<sidplayfp>();
+    m_builder = std::make_unique<ReSIDfpBuilder>("ReSIDfp-Offline");
+    m_builder->create(m_engine->info().maxsids());
+    m_builder->filter(true);
+}
+
+bool OfflineRenderer::render(const OfflineRenderOptions& options, OfflineRenderResult& result) {
+    result = OfflineRenderResult();
+    m_lastError.clear();
+
+    AudioFileFormat format = AudioFileFormat::Wav;
+    if (!options.outputPath.empty() && !AudioFileWriter::formatFromPath(options.outputPath, format)) {
+        m_lastError = "Unsupported output format (expected .wav, .flac or .raw): " + options.outputPath;
+        return false;
+    }
+    SidTune tune(options.inputPath.c_str());
+    if (!tune.getStatus()) {
+        m_lastError = "Cannot load " + options.inputPath + ": " + tune.statusString();
+        return false;
+    }
+    const SidTuneInfo* tuneInfo = tune.getInfo();
+    int songs = static_cast<int>(tuneInfo->songs());
+    int song = (options.song > 0) ? options.song : static_cast<int>(tuneInfo->startSong());
+    if (song < 1 || song > songs) {
+        m_lastError = "Subsong " + std::to_string(song) + " out of range (1-" + std::to_string(songs) + ")";
+        return false;
+    }
+    tune.selectSong(song);
+
+    // Même configuration que le master de SidPlayer (modèle SID du tune forcé)
+    SidConfig cfg;
+    cfg.frequency = options.sampleRate;
+    cfg.playback = SidConfig::MONO;
+    cfg.samplingMethod = SidConfig::RESAMPLE_INTERPOLATE;
+    cfg.defaultSidModel = (tuneInfo->sidModel(0) == SidTuneInfo::SIDMODEL_8580) ? SidConfig::MOS8580 : SidConfig::MOS6581;
+    cfg.forceSidModel = true;
+    cfg.sidEmulation = m_builder.get();
+    if (!m_engine->config(cfg) || !m_engine->load(&tune)) {
+        m_lastError = std::string("Emulation setup failed: ") + m_engine->error();
+        m_engine->load(nullptr);
+        return false;
+    }
+
+    double duration = options.durationSeconds;
+    if (duration <= 0.0) {
+        duration = DEFAULT_DURATION_S;
+        double known = SongLengthDB::getInstance().getDuration(calculateFileMD5(options.inputPath),
+                                                               static_cast<size_t>(song - 1));
+        if (known > 0.0) {
+            duration = known;
+            result.durationFromDatabase = true;
+        }
+    }
+
+    std::unique_ptr<AudioFileWriter> writer;
+    if (!options.outputPath.empty()) {
+        writer = AudioFileWriter::create(format);
+        if (!writer->open(options.outputPath, options.sampleRate, 1)) {
+            m_lastError = "Cannot write " + options.outputPath;
+            m_engine->load(nullptr);
+            return false;
+        }
+    }
+    std::unique_ptr<imsid::audio::LoudnessMeter> meter;
+    if (options.measureLoudness) meter = std::make_unique<imsid::audio::LoudnessMeter>(options.sampleRate);
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t totalSamples = static_cast<uint64_t>(std::llround(duration * options.sampleRate));
+    std::vector<short> buffer(RENDER_CHUNK_SAMPLES);
+    bool ok = true;
+    while (result.samples < totalSamples) {
+        if (options.cancel && options.cancel->load(std::memory_order_relaxed)) {
+            m_lastError = "Cancelled";
+            ok = false;
+            break;
+        }
+        uint_least32_t count = static_cast<uint_least32_t>(std::min<uint64_t>(RENDER_CHUNK_SAMPLES, totalSamples - result.samples));
+        uint_least32_t produced = m_engine->play(buffer.data(), count);
+        if (produced == 0) {
+            m_lastError = std::string("Emulation stopped: ") + m_engine->error();
+            ok = false;
+            break;
+        }
+        if (writer && !writer->write(buffer.data(), produced)) {
+            m_lastError = "Write error on " + options.outputPath;
+            ok = false;
+            break;
+        }
+        if (meter) meter->process(buffer.data(), static_cast<int>(produced));
+        result.samples += produced;
+    }
+    if (writer && !writer->close() && ok) {
+        m_lastError = "Cannot finalize " + options.outputPath;
+        ok = false;
+    }
+    // Le tune est local : le détacher du moteur avant sa destruction
+    m_engine->load(nullptr);
+
+    result.song = song;
+    if (meter) result.loudnessLufs = meter->getIntegratedLufs();
+    result.audioSeconds = static_cast<double>(result.samples) / options.sampleRate;
+    result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.realtimeFactor = (result.wallSeconds > 0.0) ? result.audioSeconds / result.wallSeconds : 0.0;
+    return ok;
+}
+
+namespace {
+    void printRenderUsage() {
+        std::cerr << "Usage: imSidPlayer --render <tune.sid> -o <output.wav|output.flac|output.raw> [options]\n"
+                  << "  --song N            Subsong to render (1-based, default: tune start song)\n"
+                  << "  --seconds S         Duration (default: Songlengths.md5, else "
+                  << OfflineRenderer::DEFAULT_DURATION_S << " s)\n"
+                  << "  --rate HZ           Output sample rate (default: 44100)\n"
+                  << "  --songlengths PATH  Songlengths.md5 to use (default: the one set in config.txt)\n";
+    }
+}
+
+bool isOfflineRenderCommand(int argc, char* argv[]) {
+    return argc > 1 && std::strcmp(argv[1], "--render") == 0;
+}
+
+int runOfflineRenderCommand(int argc, char* argv[]) {
+    OfflineRenderOptions options;
+    std::string songlengthsPath;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = (i + 1 < argc);
+            if (arg == "--render" && hasValue) options.inputPath = argv[++i];
+            else if ((arg == "-o" || arg == "--output") && hasValue) options.outputPath = argv[++i];
+            else if (arg == "--song" && hasValue) options.song = std::stoi(argv[++i]);
+            else if (arg == "--seconds" && hasValue) options.durationSeconds = std::stod(argv[++i]);
+            else if (arg == "--rate" && hasValue) options.sampleRate = std::clamp(std::stoi(argv[++i]), 8000, 192000);
+            else if (arg == "--songlengths" && hasValue) songlengthsPath = argv[++i];
+            else { printRenderUsage(); return 2; }
+        }
+    } catch (...) {
+        printRenderUsage();
+        return 2;
+    }
+    if (options.inputPath.empty() || options.outputPath.empty()) {
+        printRenderUsage();
+        return 2;
+    }
+
+    // Songlengths.md5 : celui passé en argument, sinon celui configuré dans l'application
+    if (songlengthsPath.empty() && options.durationSeconds <= 0.0) {
+        Config& config = Config::getInstance();
+        config.load((getConfigDir() / "config.txt").string());
+        songlengthsPath = config.getSonglengthsPath();
+    }
+    if (!songlengthsPath.empty() && !SongLengthDB::getInstance().load(songlengthsPath)) {
+        std::cerr << "Warning: cannot load Songlengths.md5 from " << songlengthsPath << "\n";
+    }
+    SongLengthDB::getInstance().loadOverlay((getConfigDir() / "songlengths-detected.md5").string());
+
+    OfflineRenderer renderer;
+    OfflineRenderResult result;
+    if (!renderer.render(options, result)) {
+        std::cerr << "Render failed: " << renderer.getLastError() << "\n";
+        return 1;
+    }
+    std::cout << options.outputPath << ": subsong " << result.song << ", "
+              << result.audioSeconds << " s" << (result.durationFromDatabase ? " (Songlengths.md5)" : "")
+              << " rendered in " << result.wallSeconds << " s, " << result.realtimeFactor << "x real time, "
+              << "loudness " << result.loudnessLufs << " LUFS\n";
+    return 0;
+}
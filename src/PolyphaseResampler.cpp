@@ -0,0 +1,145 @@
+#include "PolyphaseResampler.h"
+#include "AudioKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace imsid {
+namespace audio {
+
+namespace {
+    const double PI = 3.14159265358979323846;
+    const double KAISER_BETA = 8.0;   // ~80 dB de réjection
+    const double ROLLOFF = 0.9;       // Coupure à 90 % de la fréquence de Nyquist la plus basse
+
+    // Fonction de Bessel modifiée I0 (série entière)
+    double besselI0(double x) {
+        double sum = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 50; ++k) {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+            if (term < sum * 1e-12) break;
+        }
+        return sum;
+    }
+}
+
+PolyphaseResampler::PolyphaseResampler()
+    : m_inputRate(0), m_outputRate(0), m_channels(1), m_passthrough(true),
+      m_up(1), m_down(1), m_phases(1), m_taps(0), m_fill(0), m_index(0), m_phase(0) {
+}
+
+void PolyphaseResampler::configure(int inputRate, int outputRate, int channels) {
+    m_inputRate = std::max(1, inputRate);
+    m_outputRate = std::max(1, outputRate);
+    m_channels = std::clamp(channels, 1, static_cast<int>(MAX_CHANNELS));
+    m_passthrough = (m_inputRate == m_outputRate);
+    int divisor = std::gcd(m_inputRate, m_outputRate);
+    m_up = m_outputRate / divisor;
+    m_down = m_inputRate / divisor;
+    m_phases = std::min(m_up, static_cast<int>(MAX_PHASES));
+    if (m_passthrough) {
+        m_taps = 0;
+        m_coefficients.clear();
+        for (std::vector<float>& history : m_history) history.clear();
+        return;
+    }
+    // Sous-échantillonnage : la bande de transition rétrécit avec la coupure, le filtre s'allonge
+    double ratio = std::min(1.0, static_cast<double>(m_outputRate) / m_inputRate);
+    m_taps = std::min(static_cast<int>(MAX_TAPS), BASE_TAPS * static_cast<int>(std::ceil(1.0 / ratio)));
+    buildFilter();
+    for (int c = 0; c < MAX_CHANNELS; ++c) {
+        m_history[c].assign(c < m_channels ? m_taps + BLOCK : 0, 0.0f);
+    }
+    reset();
+}
+
+void PolyphaseResampler::buildFilter() {
+    // Phase p : sortie à p/m_phases de trame après le centre de la fenêtre (tap m_taps/2 - 1)
+    double cutoff = ROLLOFF * std::min(1.0, static_cast<double>(m_outputRate) / m_inputRate);
+    double half = m_taps / 2.0;
+    double norm = besselI0(KAISER_BETA);
+    m_coefficients.assign(static_cast<size_t>(m_phases) * m_taps, 0.0f);
+    for (int p = 0; p < m_phases; ++p) {
+        double fraction = static_cast<double>(p) / m_phases;
+        float* phase = &m_coefficients[static_cast<size_t>(p) * m_taps];
+        double sum = 0.0;
+        for (int j = 0; j < m_taps; ++j) {
+            double d = j - (half - 1.0) - fraction;
+            double x = d / half;
+            double window = (std::abs(x) < 1.0) ? besselI0(KAISER_BETA * std::sqrt(1.0 - x * x)) / norm : 0.0;
+            double arg = PI * cutoff * d;
+            double sinc = (std::abs(arg) < 1e-12) ? 1.0 : std::sin(arg) / arg;
+            phase[j] = static_cast<float>(cutoff * sinc * window);
+            sum += phase[j];
+        }
+        // Gain unitaire en continu pour chaque phase (pas de modulation d'amplitude)
+        for (int j = 0; j < m_taps; ++j) phase[j] = static_cast<float>(phase[j] / sum);
+    }
+}
+
+void PolyphaseResampler::reset() {
+    // Historique amorcé de silence : la première sortie est centrée sur la première entrée
+    for (std::vector<float>& history : m_history) std::fill(history.begin(), history.end(), 0.0f);
+    m_fill = m_taps / 2;
+    m_index = 0;
+    m_phase = 0;
+}
+
+int PolyphaseResampler::maxOutputFrames(int inputFrames) const {
+    if (m_passthrough) return inputFrames;
+    return static_cast<int>((static_cast<int64_t>(inputFrames) + m_taps) * m_up / m_down) + 1;
+}
+
+int PolyphaseResampler::process(const int16_t* in, int inputFrames, int16_t* out) {
+    if (m_passthrough) {
+        std::memcpy(out, in, static_cast<size_t>(inputFrames) * m_channels * sizeof(int16_t));
+        return inputFrames;
+    }
+    int produced = 0;
+    while (inputFrames > 0) {
+        // Désentrelacer une passe d'entrée à la suite de l'historique
+        int n = std::min(inputFrames, static_cast<int>(BLOCK));
+        for (int c = 0; c < m_channels; ++c) {
+            float* history = m_history[c].data() + m_fill;
+            for (int i = 0; i < n; ++i) history[i] = in[i * m_channels + c] * (1.0f / 32768.0f);
+        }
+        m_fill += n;
+        in += n * m_channels;
+        inputFrames -= n;
+
+        while (m_index + m_taps <= m_fill) {
+            int phase = (m_phases == m_up) ? m_phase : static_cast<int>(static_cast<int64_t>(m_phase) * m_phases / m_up);
+            const float* coefficients = &m_coefficients[static_cast<size_t>(phase) * m_taps];
+            for (int c = 0; c < m_channels; ++c) {
+                float value = dotProduct(coefficients, m_history[c].data() + m_index, m_taps) * 32768.0f;
+                value = std::clamp(value, -32768.0f, 32767.0f);
+                out[produced * m_channels + c] = static_cast<int16_t>(value + (value >= 0.0f ? 0.5f : -0.5f));
+            }
+            produced++;
+            m_phase += m_down;
+            m_index += m_phase / m_up;
+            m_phase %= m_up;
+        }
+
+        // Ne garder que la fenêtre encore utile (moins de m_taps trames)
+        if (m_index >= m_fill) {
+            m_index -= m_fill;
+            m_fill = 0;
+        } else {
+            int keep = m_fill - m_index;
+            for (int c = 0; c < m_channels; ++c) {
+                float* history = m_history[c].data();
+                std::memmove(history, history + m_index, keep * sizeof(float));
+            }
+            m_fill = keep;
+            m_index = 0;
+        }
+    }
+    return produced;
+}
+
+} // namespace audio
+} // namespace imsid
@@ -0,0 +1,94 @@
+#include "RealFft.h"
+#include <cmath>
+
+namespace imsid {
+namespace audio {
+
+RealFft::RealFft(int size)
+    : m_size(size), m_half(size / 2),
+      m_bitReverse(size / 2), m_stageCos(size / 2), m_stageSin(size / 2),
+      m_splitCos(size / 2 + 1), m_splitSin(size / 2 + 1),
+      m_re(size / 2), m_im(size / 2), m_specRe(size / 2 + 1), m_specIm(size / 2 + 1)
+{
+    const double pi = 3.14159265358979323846;
+    int bits = 0;
+    while ((1 << bits) < m_half) ++bits;
+    for (int i = 0; i < m_half; ++i) {
+        int reversed = 0;
+        for (int b = 0; b < bits; ++b) {
+            if (i & (1 << b)) reversed |= 1 << (bits - 1 - b);
+        }
+        m_bitReverse[i] = reversed;
+    }
+    // Étage de longueur 2h : twiddles exp(-2*pi*i*j/2h), j = 0..h-1, rangés à partir de h-1
+    for (int h = 1; h < m_half; h <<= 1) {
+        for (int j = 0; j < h; ++j) {
+            double angle = pi * j / h;
+            m_stageCos[h - 1 + j] = static_cast<float>(std::cos(angle));
+            m_stageSin[h - 1 + j] = static_cast<float>(std::sin(angle));
+        }
+    }
+    for (int k = 0; k <= m_half; ++k) {
+        double angle = 2.0 * pi * k / m_size;
+        m_splitCos[k] = static_cast<float>(std::cos(angle));
+        m_splitSin[k] = static_cast<float>(std::sin(angle));
+    }
+}
+
+void RealFft::complexFft() {
+    float* re = m_re.data();
+    float* im = m_im.data();
+    for (int h = 1; h < m_half; h <<= 1) {
+        const float* wc = m_stageCos.data() + h - 1;
+        const float* ws = m_stageSin.data() + h - 1;
+        for (int i = 0; i < m_half; i += 2 * h) {
+            float* ar = re + i;
+            float* ai = im + i;
+            float* br = re + i + h;
+            float* bi = im + i + h;
+            // Papillons à pas unitaire : v = b * conj-angle twiddle, a' = a + v, b' = a - v
+            for (int j = 0; j < h; ++j) {
+                float vr = br[j] * wc[j] + bi[j] * ws[j];
+                float vi = bi[j] * wc[j] - br[j] * ws[j];
+                br[j] = ar[j] - vr;
+                bi[j] = ai[j] - vi;
+                ar[j] += vr;
+                ai[j] += vi;
+            }
+        }
+    }
+}
+
+void RealFft::forward(const float* input, float* outRe, float* outIm) {
+    // z[n] = x[2n] + i*x[2n+1], dans l'ordre bit-reversed
+    for (int n = 0; n < m_half; ++n) {
+        int r = m_bitReverse[n];
+        m_re[r] = input[2 * n];
+        m_im[r] = input[2 * n + 1];
+    }
+    complexFft();
+    // Séparation : X[k] = (Z[k] + conj(Z[M-k]))/2 - i/2 * W^k * (Z[k] - conj(Z[M-k])), M = N/2
+    for (int k = 0; k <= m_half; ++k) {
+        int a = (k == m_half) ? 0 : k;
+        int b = (k == 0) ? 0 : m_half - k;
+        float zr = m_re[a], zi = m_im[a];
+        float cr = m_re[b], ci = -m_im[b];
+        float er = 0.5f * (zr + cr), ei = 0.5f * (zi + ci);
+        float dr = 0.5f * (zr - cr), di = 0.5f * (zi - ci);
+        // o = -i * d ; X = e + W^k * o, W^k = cos - i*sin
+        float orr = di, oi = -dr;
+        float wc = m_splitCos[k], ws = m_splitSin[k];
+        outRe[k] = er + orr * wc + oi * ws;
+        outIm[k] = ei + oi * wc - orr * ws;
+    }
+}
+
+void RealFft::powerSpectrum(const float* input, float* power) {
+    forward(input, m_specRe.data(), m_specIm.data());
+    for (int k = 0; k <= m_half; ++k) {
+        power[k] = m_specRe[k] * m_specRe[k] + m_specIm[k] * m_specIm[k];
+    }
+}
+
+} // namespace audio
+} // namespace imsid
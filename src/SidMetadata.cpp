@@ -7,33 +7,18 @@
 #include <cstring>
 #include <algorithm>
 #include <chrono>
+#include <sys/stat.h>
 
-SidMetadata SidMetadata::fromSidTune(const std::string& filepath, SidTune* tune) {
-    SidMetadata metadata;
-    metadata.filepath = filepath;
-    
-    fs::path path(filepath);
-    metadata.filename = path.filename().string();
-    
-    // Informations sur le fichier
-    try {
-        if (fs::exists(path)) {
-            metadata.fileSize = fs::file_size(path);
-            auto ftime = fs::last_write_time(path);
-            metadata.lastModified = std::chrono::duration_cast<std::chrono::seconds>(
-                ftime.time_since_epoch()).count();
-        }
-    } catch (...) {
-        // Ignorer les erreurs
-    }
-    
+namespace {
+// Informations du tune seules (sans accès au fichier)
+void fillFromTune(SidMetadata& metadata, SidTune* tune) {
     if (!tune) {
-        return metadata;
+        return;
     }
     
     const SidTuneInfo* info = tune->getInfo();
     if (!info) {
-        return metadata;
+        return;
     }
     
     // Informations de base
@@ -89,44 +74,85 @@ SidMetadata SidMetadata::fromSidTune(const std::string& filepath, SidTune* tune)
     
     // Générer le hash basé sur les métadonnées (title+author+released+sidModel+clockSpeed)
     // SANS le path pour la compatibilité avec les ratings existants
-    metadata.metadataHash = generateMetadataHash(
+    metadata.metadataHash = SidMetadata::generateMetadataHash(
         metadata.title, 
         metadata.author, 
         metadata.released, 
         metadata.sidModel, 
         metadata.clockSpeed
     );
+}
+}
+
+SidMetadata SidMetadata::fromSidTune(const std::string& filepath, SidTune* tune) {
+    SidMetadata metadata;
+    metadata.filepath = filepath;
+    metadata.filename = fs::path(filepath).filename().string();
+    
+    // Informations sur le fichier
+    statFile(filepath, metadata.fileSize, metadata.lastModified);
     
+    fillFromTune(metadata, tune);
     return metadata;
 }
 
+bool SidMetadata::fromFileData(const std::string& filepath, const uint8_t* data, size_t size, SidMetadata& metadata) {
+    if (!data || size == 0 || size > UINT32_MAX) {
+        return false;
+    }
+    SidTune tune(data, static_cast<uint_least32_t>(size));
+    if (!tune.getStatus()) {
+        return false;
+    }
+    metadata = SidMetadata();
+    metadata.filepath = filepath;
+    metadata.filename = fs::path(filepath).filename().string();
+    metadata.fileSize = static_cast<int64_t>(size);
+    fillFromTune(metadata, &tune);
+    return true;
+}
+
+bool SidMetadata::statFile(const std::string& filepath, int64_t& fileSize, int64_t& lastModified) {
+    if (filepath.empty()) {
+        return false;
+    }
+    // Un seul stat pour la taille et la date (fs::file_size + fs::last_write_time en font deux)
+    std::chrono::system_clock::time_point modified;
+#ifdef _WIN32
+    struct _stat64 st;
+    if (_wstat64(fs::path(filepath).c_str(), &st) != 0 || !(st.st_mode & _S_IFREG)) {
+        return false;
+    }
+    modified = std::chrono::system_clock::from_time_t(static_cast<time_t>(st.st_mtime));
+#else
+    struct stat st;
+    if (::stat(filepath.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+        return false;
+    }
+#ifdef __APPLE__
+    const struct timespec& mtime = st.st_mtimespec;
+#else
+    const struct timespec& mtime = st.st_mtim;
+#endif
+    modified = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+        std::chrono::seconds(mtime.tv_sec) + std::chrono::nanoseconds(mtime.tv_nsec)));
+#endif
+    fileSize = static_cast<int64_t>(st.st_size);
+    // Même valeur que duration_cast<seconds>(fs::last_write_time(path).time_since_epoch()),
+    // l'unité historique de lastModified dans database.json
+    lastModified = std::chrono::duration_cast<std::chrono::seconds>(
+        fs::file_time_type::clock::from_sys(modified).time_since_epoch()).count();
+    return true;
+}
+
 bool SidMetadata::isFileChanged() const {
-    if (filepath.empty() || !fs::exists(filepath)) {
+    int64_t currentSize = 0;
+    int64_t currentModified = 0;
+    if (!statFile(filepath, currentSize, currentModified)) {
         return true; // Fichier n'existe plus ou chemin invalide
     }
-    
-    try {
-        auto ftime = fs::last_write_time(filepath);
-        auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
-            ftime - fs::file_time_type::clock::now() + std::chrono::system_clock::now());
-        int64_t currentModified = std::chrono::duration_cast<std::chrono::seconds>(
-            sctp.time_since_epoch()).count();
-        
-        if (currentModified != lastModified) {
-            return true; // Fichier modifié
-        }
-        
-        int64_t currentSize = fs::file_size(filepath);
-        if (currentSize != fileSize) {
-            return true; // Taille différente
-        }
-        
-        // Note: On ne vérifie plus le hash du fichier, seulement taille et date
-    } catch (...) {
-        return true; // Erreur = considérer comme changé
-    }
-    
-    return false;
+    // Note: On ne vérifie plus le hash du fichier, seulement taille et date
+    return isFileChanged(currentSize, currentModified);
 }
 
 uint32_t SidMetadata::generateMetadataHash(const std::string& title, const std::string& author, 
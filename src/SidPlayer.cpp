@@ -1,57 +1,144 @@
 #include "SidPlayer.h"
 #include "Utils.h"
+#include "AudioKernels.h"
+#include "SidCompat.h"
 #include <sidplayfp/SidInfo.h>
 #include <sidplayfp/SidTuneInfo.h>
+#include <sidplayfp/sidversion.h>
 #include <cstring>
 #include <cstdlib>
 #include <algorithm>
+#include <cmath>
 #include <thread>
 #include <chrono>
 
+namespace {
+    const double PAL_CLOCK_HZ = 985248.0;
+    const double NTSC_CLOCK_HZ = 1022727.0;
+
+    // Sortie stéréo entrelacée depuis un signal mono (canaux identiques)
+    void upmixToStereo(const int16_t* mono, int16_t* stereo, int frames) {
+        for (int i = 0; i < frames; ++i) {
+            stereo[i * 2] = mono[i];
+            stereo[i * 2 + 1] = mono[i];
+        }
+    }
+
+    // Moyenne des deux canaux (entrée master du spectre)
+    void downmixToMono(const int16_t* stereo, int16_t* mono, int frames) {
+        for (int i = 0; i < frames; ++i) {
+            mono[i] = static_cast<int16_t>((stereo[i * 2] + stereo[i * 2 + 1]) >> 1);
+        }
+    }
+}
+
 SidPlayer::SidPlayer() 
-    : m_playing(false), m_paused(false), m_audioDevice(0), m_writeIndex(0), m_currentSong(0),
-      m_voice0Muted(false), m_voice1Muted(false), m_voice2Muted(false),
+    : m_playing(false), m_paused(false), m_sinkType(AudioSinkType::Sdl), m_writeIndex(0), m_scopeSequence(0), m_scopeSamplesSincePublish(0), m_scopeWindowMs(20.0f), m_currentSong(0),
+      m_voiceMuted{},
       m_audioCallbackActive(false), m_stopping(false), m_fadeInCounter(FADE_IN_DURATION),
-      m_currentSidModel(SidConfig::MOS6581), m_useMasterEngine(false), m_loopEnabled(false)
+      m_currentSidModel(SidConfig::MOS6581), m_useMasterEngine(false), m_loopEnabled(false),
+      m_renderThreadRunning(false), m_ringBuffer(DEFAULT_BUFFER_SIZE * 8), m_lastCallbackNs(0),
+      m_captureMode(HAS_SID_STATUS ? VoiceCaptureMode::SingleEngine : VoiceCaptureMode::MultiEngine),
+      m_sidClockHz(PAL_CLOCK_HZ), m_analysisVisible(true), m_analysisResyncing(false),
+      m_masterSamplePos(0), m_analysisSamplePos(0),
+      m_silenceTimeoutS(0.0f), m_tuneEnded(false), m_silenceExpectedPos(-1), m_silentSamples(0),
+      m_heardSound(false), m_endReported(false),
+      m_normalizationGainDb(0.0f), m_normalizationGain(1.0f), m_appliedGain(1.0f),
+      m_sampleRate(DEFAULT_SAMPLE_RATE), m_bufferSize(DEFAULT_BUFFER_SIZE),
+      m_emulationRate(0), m_fastSampling(false), m_emulationFreq(DEFAULT_SAMPLE_RATE),
+      m_nextFreq(0), m_nextSidModel(SidConfig::MOS6581), m_nextSidChips(1), m_nextChannels(1), m_preloading(false), m_crossfadeRemaining(0),
+      m_configuredSidModel(SidConfig::MOS6581), m_configuredFreq(0), m_configuredChannels(1),
+      m_sidChips(1), m_masterChannels(1), m_renderAheadSamples(0), m_renderSleepMs(1),
+      m_seeking(false), m_seekCancel(false), m_seekProgress(0.0f),
+      m_maxSids(1), m_snapshotGeneration(0), m_masterAtStart(false)
 {
-    for (int i = 0; i < OSCILLOSCOPE_SIZE; ++i) {
-        m_voice0Samples[i] = 0.0f; m_voice1Samples[i] = 0.0f; m_voice2Samples[i] = 0.0f;
-    }
-    if (SDL_Init(SDL_INIT_AUDIO) < 0) { return; }
+    configureRenderPath(m_bufferSize, m_sampleRate);
+    for (std::vector<int16_t>& history : m_scopeHistory) history.assign(OSCILLOSCOPE_HISTORY, 0);
+    m_voiceAudioBuffers.assign(static_cast<size_t>(MAX_VOICES) * MAX_AUDIO_BUFFER_SIZE, 0);
     m_engineVoice0 = std::make_unique<sidplayfp>();
     m_engineVoice1 = std::make_unique<sidplayfp>();
     m_engineVoice2 = std::make_unique<sidplayfp>();
     m_engineMaster = std::make_unique<sidplayfp>();
+    m_engineNext = std::make_unique<sidplayfp>();
     m_builderVoice0 = std::make_unique<ReSIDfpBuilder>("ReSIDfp-Voice0");
     m_builderVoice1 = std::make_unique<ReSIDfpBuilder>("ReSIDfp-Voice1");
     m_builderVoice2 = std::make_unique<ReSIDfpBuilder>("ReSIDfp-Voice2");
     m_builderMaster = std::make_unique<ReSIDfpBuilder>("ReSIDfp-Master");
+    m_builderNext = std::make_unique<ReSIDfpBuilder>("ReSIDfp-Next");
     unsigned int maxSids = m_engineVoice0->info().maxsids();
+    m_maxSids = maxSids;
     m_builderVoice0->create(maxSids); m_builderVoice1->create(maxSids); m_builderVoice2->create(maxSids); m_builderMaster->create(maxSids);
+    m_builderNext->create(maxSids);
     m_builderVoice0->filter(true); m_builderVoice1->filter(true); m_builderVoice2->filter(true); m_builderMaster->filter(true);
+    m_builderNext->filter(true);
     SidConfig cfg;
-    cfg.frequency = SAMPLE_RATE; cfg.playback = SidConfig::MONO; cfg.samplingMethod = SidConfig::RESAMPLE_INTERPOLATE;
+    cfg.frequency = m_sampleRate; cfg.playback = SidConfig::MONO; cfg.samplingMethod = SidConfig::RESAMPLE_INTERPOLATE;
     cfg.sidEmulation = m_builderVoice0.get(); m_engineVoice0->config(cfg);
     cfg.sidEmulation = m_builderVoice1.get(); m_engineVoice1->config(cfg);
     cfg.sidEmulation = m_builderVoice2.get(); m_engineVoice2->config(cfg);
     cfg.sidEmulation = m_builderMaster.get(); m_engineMaster->config(cfg);
+    cfg.sidEmulation = m_builderNext.get(); m_engineNext->config(cfg);
+    
+    // Démarrer le thread de rendu (il reste en attente tant que rien n'est joué)
+    m_renderThreadRunning = true;
+    m_renderThread = std::thread(&SidPlayer::renderThreadLoop, this);
+    m_snapshots.setMemoryBudget(DEFAULT_SNAPSHOT_BUDGET_MB * 1024 * 1024);
+    m_snapshotThread = std::thread(&SidPlayer::snapshotThreadLoop, this);
 }
 
 SidPlayer::~SidPlayer() {
+    cancelSeek();
     stop();
+    if (m_preloadThread.joinable()) m_preloadThread.join();
+    m_renderThreadRunning = false;
+    if (m_renderThread.joinable()) m_renderThread.join();
+    if (m_snapshotThread.joinable()) m_snapshotThread.join();
+    m_snapshots.clear();
     int maxWait = 100, waited = 0;
     while (m_audioCallbackActive.load() && waited < maxWait) {
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
         waited++;
     }
-    if (m_audioDevice > 0) { SDL_CloseAudioDevice(m_audioDevice); m_audioDevice = 0; }
-    SDL_Quit();
+    m_sink.reset();
+}
+
+bool SidPlayer::openAudioDevice() {
+    if (audioOpen()) return true;
+    if (!m_sink) m_sink = AudioSink::create(m_sinkType, m_sinkOutputPath);
+    AudioSinkFormat desired;
+    desired.sampleRate = m_sampleRate; desired.channels = OUTPUT_CHANNELS; desired.bufferFrames = m_bufferSize;
+    // La sortie peut imposer une autre taille de buffer (jamais le nombre de canaux) : le rendu par blocs s'y adapte
+    // En cas d'échec, la raison reste disponible via getAudioSinkError()
+    AudioSinkFormat obtained;
+    if (!m_sink->open(desired, obtained, audioCallbackWrapper, this)) return false;
+    m_sinkFormat = obtained;
+    configureRenderPath(obtained.bufferFrames, obtained.sampleRate);
+    return true;
+}
+
+void SidPlayer::closeAudioDevice() {
+    stop();
+    if (m_sink) m_sink->close();
+}
+
+void SidPlayer::setAudioSink(AudioSinkType type, const std::string& outputPath) {
+    if (type == m_sinkType && outputPath == m_sinkOutputPath && m_sink) return;
+    closeAudioDevice();
+    m_sink.reset();
+    m_sinkType = type;
+    m_sinkOutputPath = outputPath;
+    reopenAudioDevice();
 }
 
 bool SidPlayer::loadFile(const std::string& filepath) {
+    // Le périphérique reste ouvert d'un morceau à l'autre (en pause entre deux) : seule l'émulation est réinitialisée
     stop();
-    drainAudioBuffer();
-    if (m_audioDevice > 0) { SDL_CloseAudioDevice(m_audioDevice); m_audioDevice = 0; }
+    if (!openAudioDevice()) return false;
+    std::lock_guard<std::mutex> lock(m_engineMutex);
+    // Les snapshots référencent l'ancien SidTune : les détruire avant lui
+    m_snapshots.clear();
+    ++m_snapshotGeneration;
+    m_masterAtStart = false;
     m_tune = std::make_unique<SidTune>(filepath.c_str());
     if (!m_tune->getStatus()) { m_tune.reset(); return false; }
     const SidTuneInfo* tuneInfo = m_tune->getInfo();
@@ -62,24 +149,69 @@ bool SidPlayer::loadFile(const std::string& filepath) {
     m_currentSong = defaultSong - 1;  // Convertir en 0-based
     SidConfig::sid_model_t sidModel = (tuneInfo && tuneInfo->sidModel(0) == SidTuneInfo::SIDMODEL_8580) ? SidConfig::MOS8580 : SidConfig::MOS6581;
     m_currentSidModel = sidModel;
-    m_engineVoice0->load(m_tune.get()); m_engineVoice1->load(m_tune.get()); m_engineVoice2->load(m_tune.get()); m_engineMaster->load(m_tune.get());
-    m_engineVoice0->mute(0, 1, false); m_engineVoice0->mute(0, 2, false);
-    m_engineVoice1->mute(0, 0, false); m_engineVoice1->mute(0, 2, false);
-    m_engineVoice2->mute(0, 0, false); m_engineVoice2->mute(0, 1, false);
-    SDL_AudioSpec desired, obtained;
-    SDL_zero(desired);
-    desired.freq = SAMPLE_RATE; desired.format = AUDIO_S16SYS; desired.channels = 1; desired.samples = BUFFER_SIZE;
-    desired.callback = audioCallbackWrapper; desired.userdata = this;
-    m_audioDevice = SDL_OpenAudioDevice(nullptr, 0, &desired, &obtained, 0);
-    if (m_audioDevice == 0) { m_tune.reset(); return false; }
-    m_audioSpec = obtained;
-    SidConfig cfg;
-    cfg.frequency = obtained.freq; cfg.defaultSidModel = sidModel; cfg.forceSidModel = true;
-    cfg.sidEmulation = m_builderVoice0.get(); m_engineVoice0->config(cfg);
-    cfg.sidEmulation = m_builderVoice1.get(); m_engineVoice1->config(cfg);
-    cfg.sidEmulation = m_builderVoice2.get(); m_engineVoice2->config(cfg);
-    cfg.sidEmulation = m_builderMaster.get(); m_engineMaster->config(cfg);
+    m_sidClockHz = (tuneInfo->clockSpeed() == SidTuneInfo::CLOCK_NTSC) ? NTSC_CLOCK_HZ : PAL_CLOCK_HZ;
+    m_sidChips = sidChipCount(tuneInfo, m_maxSids);
+    m_masterChannels = (m_sidChips > 1) ? 2 : 1;
+    m_engineMaster->load(m_tune.get());
+    if (usesAnalysisEngines()) {
+        m_engineVoice0->load(m_tune.get()); m_engineVoice1->load(m_tune.get()); m_engineVoice2->load(m_tune.get());
+        applyAnalysisEngineMuting();
+    }
+    // load() reconfigure déjà la machine pour le tune (horloge PAL/NTSC comprise) :
+    // config() complet uniquement si le modèle SID forcé, la fréquence ou le format de sortie changent
+    // Les moteurs d'analyse restent mono : ils ne servent qu'aux tunes à une seule puce
+    if (sidModel != m_configuredSidModel || m_emulationFreq != m_configuredFreq || m_masterChannels != m_configuredChannels) {
+        SidConfig cfg = engineConfig(m_emulationFreq, sidModel, 1);
+        cfg.sidEmulation = m_builderVoice0.get(); m_engineVoice0->config(cfg);
+        cfg.sidEmulation = m_builderVoice1.get(); m_engineVoice1->config(cfg);
+        cfg.sidEmulation = m_builderVoice2.get(); m_engineVoice2->config(cfg);
+        cfg = engineConfig(m_emulationFreq, sidModel, m_masterChannels);
+        cfg.sidEmulation = m_builderMaster.get(); m_engineMaster->config(cfg);
+        m_configuredSidModel = sidModel;
+        m_configuredFreq = m_emulationFreq;
+        m_configuredChannels = m_masterChannels;
+    }
+    applyVoiceMuting(); // Après config() : les puces ont pu être recréées
     m_currentFile = filepath;
+    updateTuneInfo(tuneInfo);
+    // Le périphérique a pu changer de fréquence : un préchargement éventuel sera refait
+    m_preloadRequested.clear();
+    return true;
+}
+
+SidConfig SidPlayer::engineConfig(int freq, SidConfig::sid_model_t sidModel, int channels) const {
+    SidConfig cfg;
+    cfg.frequency = freq; cfg.defaultSidModel = sidModel; cfg.forceSidModel = true;
+    cfg.playback = (channels == 2) ? SidConfig::STEREO : SidConfig::MONO;
+    cfg.samplingMethod = m_fastSampling ? SidConfig::INTERPOLATE : SidConfig::RESAMPLE_INTERPOLATE;
+    return cfg;
+}
+
+int SidPlayer::sidChipCount(const SidTuneInfo* tuneInfo, unsigned int maxSids) {
+    int chips = tuneInfo ? static_cast<int>(tuneInfo->sidChips()) : 1;
+    return std::clamp(chips, 1, std::min(static_cast<int>(MAX_SID_CHIPS), static_cast<int>(std::max(1u, maxSids))));
+}
+
+void SidPlayer::applyVoiceMuting() {
+    int voiceCount = getVoiceCount();
+    for (int voice = 0; voice < voiceCount; ++voice) {
+        m_engineMaster->mute(voice / 3, voice % 3, m_voiceMuted[voice]);
+    }
+}
+
+void SidPlayer::applyAnalysisEngineMuting() {
+    // Chaque moteur d'analyse isole une voix de la puce 0 ; le mute utilisateur est appliqué au mixage
+    sidplayfp* engines[3] = { m_engineVoice0.get(), m_engineVoice1.get(), m_engineVoice2.get() };
+    for (int e = 0; e < 3; ++e) {
+        for (int voice = 0; voice < 3; ++voice) engines[e]->mute(0, voice, voice != e);
+    }
+}
+
+bool SidPlayer::usesAnalysisEngines() const {
+    return m_captureMode == VoiceCaptureMode::MultiEngine && m_sidChips.load(std::memory_order_relaxed) == 1;
+}
+
+void SidPlayer::updateTuneInfo(const SidTuneInfo* tuneInfo) {
     m_tuneInfo = "No info available";
     if (tuneInfo && tuneInfo->numberOfInfoStrings() > 0) {
         std::string tempInfo;
@@ -93,43 +225,65 @@ bool SidPlayer::loadFile(const std::string& filepath) {
         }
         if (!tempInfo.empty()) m_tuneInfo = tempInfo;
     }
-    return true;
 }
 
 void SidPlayer::play() {
-    if (!m_tune || m_audioDevice == 0) return;
+    if (!m_tune || !audioOpen()) return;
     if (m_paused) {
-        SDL_PauseAudioDevice(m_audioDevice, 0);
+        m_sink->pause(false);
         m_paused = false;
     } else {
-        if (m_playing) { SDL_PauseAudioDevice(m_audioDevice, 1); drainAudioBuffer(); }
-        m_engineVoice0->load(m_tune.get()); m_engineVoice1->load(m_tune.get());
-        m_engineVoice2->load(m_tune.get()); m_engineMaster->load(m_tune.get());
-        m_engineVoice0->stop(); m_engineVoice1->stop(); m_engineVoice2->stop(); m_engineMaster->stop();
+        cancelSeek();
+        if (m_playing) m_sink->pause(true); // Ne retourne qu'une fois le callback terminé
+        std::lock_guard<std::mutex> lock(m_engineMutex);
+        m_ringBuffer.reset();
+        m_resampler.reset();
         int16_t dummy[512];
-        m_engineVoice0->play(dummy, 512); m_engineVoice1->play(dummy, 512);
-        m_engineVoice2->play(dummy, 512); m_engineMaster->play(dummy, 512);
-        m_engineVoice0->mute(0, 0, false); m_engineVoice0->mute(0, 1, true); m_engineVoice0->mute(0, 2, true);
-        m_engineVoice1->mute(0, 0, true); m_engineVoice1->mute(0, 1, false); m_engineVoice1->mute(0, 2, true);
-        m_engineVoice2->mute(0, 0, true); m_engineVoice2->mute(0, 1, true); m_engineVoice2->mute(0, 2, false);
-        for (int i = 0; i < OSCILLOSCOPE_SIZE; ++i) { m_voice0Samples[i] = 0.0f; m_voice1Samples[i] = 0.0f; m_voice2Samples[i] = 0.0f; }
+        restartMaster();
+        if (usesAnalysisEngines()) {
+            m_engineVoice0->load(m_tune.get()); m_engineVoice1->load(m_tune.get()); m_engineVoice2->load(m_tune.get());
+            m_engineVoice0->stop(); m_engineVoice1->stop(); m_engineVoice2->stop();
+            m_engineVoice0->play(dummy, 512); m_engineVoice1->play(dummy, 512); m_engineVoice2->play(dummy, 512);
+            applyAnalysisEngineMuting();
+        }
+        for (VoiceTap& tap : m_voiceTaps) tap.reset();
+        m_masterSamplePos = 0;
+        m_analysisSamplePos = 0;
+        m_analysisResyncing = false;
+        for (std::vector<int16_t>& history : m_scopeHistory) std::fill(history.begin(), history.end(), 0);
         m_writeIndex = 0;
+        m_scopeSamplesSincePublish = 0;
+        publishOscilloscopeFrame();
         m_fadeInCounter = 0;
-        SDL_PauseAudioDevice(m_audioDevice, 0);
+        m_sink->pause(false);
     }
     m_playing = true;
 }
 
 void SidPlayer::pause() {
-    if (m_playing && !m_paused) { SDL_PauseAudioDevice(m_audioDevice, 1); m_paused = true; }
+    if (m_playing && !m_paused) {
+        m_sink->pause(true); m_paused = true;
+        // Abandonner un fondu enchaîné en cours : libère l'emplacement pour le préchargement
+        std::lock_guard<std::mutex> lock(m_engineMutex);
+        m_crossfadeRemaining = 0;
+    }
 }
 
 void SidPlayer::stop() {
-    if (m_audioDevice == 0) return;
+    if (!audioOpen()) return;
     m_stopping = true; m_playing = false; m_paused = false;
-    if (m_engineVoice0) { m_engineVoice0->stop(); m_engineVoice1->stop(); m_engineVoice2->stop(); m_engineMaster->stop(); }
-    SDL_PauseAudioDevice(m_audioDevice, 1);
-    drainAudioBuffer();
+    cancelSeek();
+    m_sink->pause(true);
+    {
+        // Le callback est suspendu et le thread de rendu ne produit plus : on peut vider le ring buffer
+        std::lock_guard<std::mutex> lock(m_engineMutex);
+        if (m_engineVoice0) { m_engineVoice0->stop(); m_engineVoice1->stop(); m_engineVoice2->stop(); m_engineMaster->stop(); }
+        m_masterAtStart = false; // sidplayfp réinitialisera le master au prochain play()
+        m_ringBuffer.reset();
+        m_resampler.reset();
+        m_crossfadeRemaining = 0;
+        m_tuneEnded = false; // Un événement de fin non consommé ne doit pas survivre au morceau
+    }
     m_stopping = false;
 }
 
@@ -156,59 +310,332 @@ void SidPlayer::prevSong() {
 }
 
 void SidPlayer::setVoiceMute(int voice, bool muted) {
-    if (voice < 0 || voice > 2) return;
-    if (voice == 0) m_voice0Muted = muted; else if (voice == 1) m_voice1Muted = muted; else if (voice == 2) m_voice2Muted = muted;
-    if (m_tune) {
-        m_engineMaster->mute(0, 0, m_voice0Muted); m_engineMaster->mute(0, 1, m_voice1Muted); m_engineMaster->mute(0, 2, m_voice2Muted);
-        if (voice == 0) { m_engineVoice0->mute(0, 0, m_voice0Muted); m_engineVoice0->mute(0, 1, true); m_engineVoice0->mute(0, 2, true); }
-        else if (voice == 1) { m_engineVoice1->mute(0, 0, true); m_engineVoice1->mute(0, 1, m_voice1Muted); m_engineVoice1->mute(0, 2, true); }
-        else if (voice == 2) { m_engineVoice2->mute(0, 0, true); m_engineVoice2->mute(0, 1, true); m_engineVoice2->mute(0, 2, m_voice2Muted); }
-    }
+    if (voice < 0 || voice >= MAX_VOICES) return;
+    std::lock_guard<std::mutex> lock(m_engineMutex);
+    m_voiceMuted[voice] = muted;
+    // Moteurs d'analyse : isolation inchangée, les voix mutées sont mises à zéro au mixage
+    if (m_tune) applyVoiceMuting();
 }
 
 bool SidPlayer::isVoiceMuted(int voice) const {
-    if (voice == 0) return m_voice0Muted; if (voice == 1) return m_voice1Muted; if (voice == 2) return m_voice2Muted; return false;
+    return (voice >= 0 && voice < MAX_VOICES) ? m_voiceMuted[voice] : false;
 }
 
-void SidPlayer::audioCallback(void* userdata, Uint8* stream, int len) {
+void SidPlayer::audioCallback(int16_t* out, int frames) {
     m_audioCallbackActive = true;
-    if (m_stopping || !m_playing || m_paused) { SDL_memset(stream, 0, len); m_audioCallbackActive = false; return; }
-    int16_t* mixBuffer = reinterpret_cast<int16_t*>(stream);
-    int samples = len / sizeof(int16_t);
-    int activeVoices = !m_voice0Muted + !m_voice1Muted + !m_voice2Muted;
-    m_engineVoice0->play(m_voice0AudioBuffer, samples); m_engineVoice1->play(m_voice1AudioBuffer, samples); m_engineVoice2->play(m_voice2AudioBuffer, samples);
-    if (m_voice0Muted) SDL_memset(m_voice0AudioBuffer, 0, samples * sizeof(int16_t));
-    if (m_voice1Muted) SDL_memset(m_voice1AudioBuffer, 0, samples * sizeof(int16_t));
-    if (m_voice2Muted) SDL_memset(m_voice2AudioBuffer, 0, samples * sizeof(int16_t));
-    if (m_fadeInCounter < FADE_IN_DURATION) {
-        for (int i = 0; i < samples && m_fadeInCounter < FADE_IN_DURATION; ++i, m_fadeInCounter++) {
-            float gain = static_cast<float>(m_fadeInCounter) / FADE_IN_DURATION;
-            m_voice0AudioBuffer[i] = static_cast<int16_t>(m_voice0AudioBuffer[i] * gain);
-            m_voice1AudioBuffer[i] = static_cast<int16_t>(m_voice1AudioBuffer[i] * gain);
-            m_voice2AudioBuffer[i] = static_cast<int16_t>(m_voice2AudioBuffer[i] * gain);
-            m_masterAudioBuffer[i] = static_cast<int16_t>(m_masterAudioBuffer[i] * gain);
+    size_t samples = static_cast<size_t>(frames) * OUTPUT_CHANNELS;
+    if (m_stopping || !m_playing || m_paused || m_seeking) {
+        SDL_memset(out, 0, samples * sizeof(int16_t));
+        m_lastCallbackNs = 0; // Pas d'intervalle mesuré à la reprise
+        m_audioCallbackActive = false;
+        return;
+    }
+    int64_t start = AudioTimingStats::nowNs();
+    // Temps réel : aucune émulation ici, juste une copie depuis le ring buffer
+    size_t got = m_ringBuffer.read(out, samples);
+    if (got < samples) {
+        SDL_memset(out + got, 0, (samples - got) * sizeof(int16_t));
+        m_timing.countUnderrun();
+    }
+    m_timing.recordCallback(AudioTimingStats::nowNs() - start, m_lastCallbackNs ? start - m_lastCallbackNs : 0);
+    m_lastCallbackNs = start;
+    m_audioCallbackActive = false;
+}
+
+void SidPlayer::renderThreadLoop() {
+    while (m_renderThreadRunning) {
+        const size_t aheadSamples = static_cast<size_t>(m_renderAheadSamples.load(std::memory_order_relaxed)) * OUTPUT_CHANNELS;
+        if (m_stopping || !m_playing || m_paused || m_seeking || m_ringBuffer.available() >= aheadSamples) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(m_renderSleepMs.load(std::memory_order_relaxed)));
+            continue;
+        }
+        // Remplir jusqu'à l'avance visée (plusieurs blocs par réveil : tolère un sleep peu précis)
+        std::lock_guard<std::mutex> lock(m_engineMutex);
+        while (m_renderThreadRunning && !m_stopping && m_playing && !m_paused && !m_seeking && m_tune &&
+               m_ringBuffer.freeSpace() >= static_cast<size_t>(m_renderOutputChunk) * OUTPUT_CHANNELS &&
+               m_ringBuffer.available() < static_cast<size_t>(m_renderAheadSamples.load(std::memory_order_relaxed)) * OUTPUT_CHANNELS) {
+            int64_t blockStart = AudioTimingStats::nowNs();
+            renderBlock(m_renderAudioBuffer, m_renderChunkSize);
+            if (m_resampler.isPassthrough()) {
+                m_ringBuffer.write(m_renderAudioBuffer, m_renderChunkSize * OUTPUT_CHANNELS);
+            } else {
+                int64_t resampleStart = AudioTimingStats::nowNs();
+                int frames = m_resampler.process(m_renderAudioBuffer, m_renderChunkSize, m_resampledAudioBuffer.data());
+                m_ringBuffer.write(m_resampledAudioBuffer.data(), frames * OUTPUT_CHANNELS);
+                m_timing.record(AudioTimingStats::STAGE_RESAMPLE, AudioTimingStats::nowNs() - resampleStart);
+            }
+            m_timing.record(AudioTimingStats::STAGE_BLOCK, AudioTimingStats::nowNs() - blockStart);
+        }
+        // Temps libre après le remplissage : resynchroniser les moteurs d'analyse redevenus visibles
+        if (m_playing && !m_stopping && !m_seeking && m_tune && usesAnalysisEngines() &&
+            m_analysisVisible && m_analysisSamplePos < m_masterSamplePos) {
+            resyncAnalysisEngines();
+        }
+    }
+}
+
+void SidPlayer::renderBlock(int16_t* mixBuffer, int samples) {
+    bool visible = m_analysisVisible.load(std::memory_order_relaxed);
+    bool analysisInSync = (m_analysisSamplePos == m_masterSamplePos);
+    int voiceCount = getVoiceCount();
+    if (usesAnalysisEngines() && visible && analysisInSync) {
+        renderBlockMultiEngine(mixBuffer, samples);
+        m_analysisSamplePos += samples;
+    } else {
+        // Une seule émulation : l'audio vient du master (mutes appliqués dans le moteur)
+        // Mode MultiEngine masqué ou en cours de resynchronisation : les moteurs d'analyse sont suspendus
+        // Tune multi-SID : taps par registres quel que soit le mode (les moteurs d'analyse n'isolent que la puce 0)
+        renderBlockMasterOnly(mixBuffer, samples);
+        if (visible && (m_captureMode == VoiceCaptureMode::SingleEngine || voiceCount > 3)) {
+            int64_t tapsStart = AudioTimingStats::nowNs();
+            renderVoiceTaps(samples);
+            m_timing.record(AudioTimingStats::STAGE_VOICES, AudioTimingStats::nowNs() - tapsStart);
+        } else {
+            for (int v = 0; v < voiceCount; ++v) SDL_memset(voiceBuffer(v), 0, samples * sizeof(int16_t));
+        }
+    }
+    applyCrossfade(mixBuffer, samples);
+    int64_t postStart = AudioTimingStats::nowNs();
+    updateSilenceDetector(mixBuffer, samples); // Sur le niveau d'origine, indépendamment de la normalisation
+    float targetGain = m_normalizationGain.load(std::memory_order_relaxed);
+    if (targetGain != 1.0f || m_appliedGain != 1.0f) {
+        int count = samples * OUTPUT_CHANNELS;
+        imsid::audio::applyGainRamp(mixBuffer, count, m_appliedGain, (targetGain - m_appliedGain) / count);
+        m_appliedGain = targetGain;
+    }
+    m_masterAtStart = false;
+    m_masterSamplePos += samples;
+    m_silenceExpectedPos = m_masterSamplePos;
+    if (visible) {
+        captureOscilloscope(samples);
+        // Spectre : voix de la puce 0, master ramené en mono
+        downmixToMono(mixBuffer, m_monoAudioBuffer, samples);
+        m_spectrum.push(voiceBuffer(0), voiceBuffer(1), voiceBuffer(2), m_monoAudioBuffer, samples);
+    }
+    m_timing.record(AudioTimingStats::STAGE_POST, AudioTimingStats::nowNs() - postStart);
+}
+
+void SidPlayer::renderBlockMasterOnly(int16_t* mixBuffer, int samples) {
+    int channels = m_masterChannels.load(std::memory_order_relaxed);
+    int64_t start = AudioTimingStats::nowNs();
+    m_engineMaster->play(m_masterAudioBuffer, samples * channels);
+    m_timing.record(AudioTimingStats::STAGE_MASTER, AudioTimingStats::nowNs() - start);
+    int16_t* fadeBuffers[] = { m_masterAudioBuffer };
+    applyFadeIn(fadeBuffers, 1, samples, channels);
+    if (channels == OUTPUT_CHANNELS) {
+        SDL_memcpy(mixBuffer, m_masterAudioBuffer, samples * OUTPUT_CHANNELS * sizeof(int16_t));
+    } else {
+        upmixToStereo(m_masterAudioBuffer, mixBuffer, samples);
+    }
+}
+
+void SidPlayer::renderVoiceTaps(int samples) {
+    // Voix des oscilloscopes reconstruites depuis les registres de chaque puce du master (après son play())
+    double cyclesPerSample = m_sidClockHz / m_emulationFreq;
+    int chips = m_sidChips.load(std::memory_order_relaxed);
+    for (int chip = 0; chip < chips; ++chip) {
+        uint8_t regs[32] = {};
+#if HAS_SID_STATUS
+        m_engineMaster->getSidStatus(chip, regs);
+#endif
+        for (int v = 0; v < 3; ++v) {
+            int voice = chip * 3 + v;
+            int16_t* out = voiceBuffer(voice);
+            m_voiceTaps[voice].render(regs, v, out, samples, cyclesPerSample, m_emulationFreq);
+            if (m_voiceMuted[voice]) SDL_memset(out, 0, samples * sizeof(int16_t));
         }
     }
+}
+
+void SidPlayer::resyncAnalysisEngines() {
+    // Rattraper le master en avance rapide, par tranches de temps bornées pour ne jamais affamer l'audio
+    auto sliceStart = std::chrono::steady_clock::now();
+    const int64_t fastChunk = static_cast<int64_t>(m_renderChunkSize) * FAST_FORWARD_PERCENT / 100;
+    while (m_analysisSamplePos < m_masterSamplePos) {
+        int64_t behind = m_masterSamplePos - m_analysisSamplePos;
+        if (behind >= fastChunk) {
+            // En avance rapide, chaque échantillon produit couvre FAST_FORWARD_PERCENT/100 échantillons de temps
+            m_engineVoice0->fastForward(FAST_FORWARD_PERCENT);
+            m_engineVoice1->fastForward(FAST_FORWARD_PERCENT);
+            m_engineVoice2->fastForward(FAST_FORWARD_PERCENT);
+            m_engineVoice0->play(voiceBuffer(0), m_renderChunkSize);
+            m_engineVoice1->play(voiceBuffer(1), m_renderChunkSize);
+            m_engineVoice2->play(voiceBuffer(2), m_renderChunkSize);
+            m_analysisSamplePos += fastChunk;
+        } else {
+            // Fin du rattrapage à vitesse normale pour retomber exactement sur la position du master
+            m_engineVoice0->fastForward(100); m_engineVoice1->fastForward(100); m_engineVoice2->fastForward(100);
+            int chunk = static_cast<int>(std::min<int64_t>(behind, MAX_AUDIO_BUFFER_SIZE));
+            m_engineVoice0->play(voiceBuffer(0), chunk);
+            m_engineVoice1->play(voiceBuffer(1), chunk);
+            m_engineVoice2->play(voiceBuffer(2), chunk);
+            m_analysisSamplePos += chunk;
+        }
+        if (std::chrono::steady_clock::now() - sliceStart >= std::chrono::milliseconds(RESYNC_SLICE_MS)) break;
+    }
+    m_engineVoice0->fastForward(100); m_engineVoice1->fastForward(100); m_engineVoice2->fastForward(100);
+    m_analysisResyncing = (m_analysisSamplePos < m_masterSamplePos);
+}
+
+void SidPlayer::renderBlockMultiEngine(int16_t* mixBuffer, int samples) {
+    // Tune mono uniquement (usesAnalysisEngines) : mixage en mono, dupliqué sur les deux canaux
+    int16_t* voices[3] = { voiceBuffer(0), voiceBuffer(1), voiceBuffer(2) };
+    int activeVoices = !m_voiceMuted[0] + !m_voiceMuted[1] + !m_voiceMuted[2];
+    int64_t start = AudioTimingStats::nowNs();
+    m_engineVoice0->play(voices[0], samples); m_engineVoice1->play(voices[1], samples); m_engineVoice2->play(voices[2], samples);
+    int64_t voicesEnd = AudioTimingStats::nowNs();
+    m_timing.record(AudioTimingStats::STAGE_VOICES, voicesEnd - start);
+    for (int v = 0; v < 3; ++v) {
+        if (m_voiceMuted[v]) SDL_memset(voices[v], 0, samples * sizeof(int16_t));
+    }
+    // Le master est joué avant le fade-in pour que la rampe s'applique au bloc courant
+    int64_t masterStart = AudioTimingStats::nowNs();
+    m_engineMaster->play(m_masterAudioBuffer, samples);
+    m_timing.record(AudioTimingStats::STAGE_MASTER, AudioTimingStats::nowNs() - masterStart);
+    int16_t* fadeBuffers[] = { voices[0], voices[1], voices[2], m_masterAudioBuffer };
+    applyFadeIn(fadeBuffers, 4, samples);
     if (m_useMasterEngine) {
-        m_engineMaster->play(m_masterAudioBuffer, samples);
-        SDL_memcpy(mixBuffer, m_masterAudioBuffer, samples * sizeof(int16_t));
+        SDL_memcpy(m_monoAudioBuffer, m_masterAudioBuffer, samples * sizeof(int16_t));
+    } else if (activeVoices > 0) {
+        imsid::audio::mixSaturate3(voices[0], voices[1], voices[2], m_monoAudioBuffer, samples);
     } else {
-        m_engineMaster->play(m_masterAudioBuffer, samples);
-        if (activeVoices > 0) {
-            for (int i = 0; i < samples; ++i) {
-                int32_t sum = static_cast<int32_t>(m_voice0AudioBuffer[i]) + static_cast<int32_t>(m_voice1AudioBuffer[i]) + static_cast<int32_t>(m_voice2AudioBuffer[i]);
-                mixBuffer[i] = static_cast<int16_t>(std::clamp(sum, -32768, 32767));
-            }
-        } else { SDL_memset(mixBuffer, 0, samples * sizeof(int16_t)); }
+        SDL_memset(m_monoAudioBuffer, 0, samples * sizeof(int16_t));
     }
-    int samplesToCapture = std::min(samples, 256);
-    for (int i = 0; i < samplesToCapture; ++i) {
-        m_voice0Samples[m_writeIndex] = m_voice0AudioBuffer[i] / 32768.0f;
-        m_voice1Samples[m_writeIndex] = m_voice1AudioBuffer[i] / 32768.0f;
-        m_voice2Samples[m_writeIndex] = m_voice2AudioBuffer[i] / 32768.0f;
-        m_writeIndex = (m_writeIndex + 1) % OSCILLOSCOPE_SIZE;
+    upmixToStereo(m_monoAudioBuffer, mixBuffer, samples);
+}
+
+void SidPlayer::applyFadeIn(int16_t* const* buffers, int numBuffers, int samples, int channels) {
+    if (m_fadeInCounter >= FADE_IN_DURATION) return;
+    // Rampe linéaire gain = compteur / FADE_IN_DURATION, limitée à la fin du fondu
+    // Buffers entrelacés : le pas est réparti sur les échantillons de chaque trame
+    int rampLength = std::min(samples, FADE_IN_DURATION - m_fadeInCounter);
+    float gainStart = static_cast<float>(m_fadeInCounter) / FADE_IN_DURATION;
+    float gainStep = 1.0f / (FADE_IN_DURATION * channels);
+    for (int b = 0; b < numBuffers; ++b) {
+        imsid::audio::applyGainRamp(buffers[b], rampLength * channels, gainStart, gainStep);
     }
-    m_audioCallbackActive = false;
+    m_fadeInCounter += rampLength;
+}
+
+void SidPlayer::applyCrossfade(int16_t* mixBuffer, int samples) {
+    int remaining = m_crossfadeRemaining.load(std::memory_order_relaxed);
+    if (remaining <= 0) return;
+    // Fin de l'ancien morceau (moteur de réserve) en rampe descendante, symétrique du fade-in du nouveau
+    // L'ancien master garde son format (m_nextChannels) : un tune mono alimente les deux canaux
+    int n = std::min(samples, remaining);
+    int channels = m_nextChannels;
+    int64_t start = AudioTimingStats::nowNs();
+    m_engineNext->play(m_crossfadeAudioBuffer, n * channels);
+    m_timing.record(AudioTimingStats::STAGE_CROSSFADE, AudioTimingStats::nowNs() - start);
+    float gainStart = static_cast<float>(remaining) / FADE_IN_DURATION;
+    float gainStep = -1.0f / (FADE_IN_DURATION * channels);
+    imsid::audio::applyGainRamp(m_crossfadeAudioBuffer, n * channels, gainStart, gainStep);
+    for (int i = 0; i < n * OUTPUT_CHANNELS; ++i) {
+        int sum = mixBuffer[i] + m_crossfadeAudioBuffer[(channels == OUTPUT_CHANNELS) ? i : i / OUTPUT_CHANNELS];
+        mixBuffer[i] = static_cast<int16_t>(std::clamp(sum, -32768, 32767));
+    }
+    m_crossfadeRemaining.store(remaining - n, std::memory_order_release);
+}
+
+void SidPlayer::setNormalizationGain(float gainDb) {
+    if (gainDb == m_normalizationGainDb.load(std::memory_order_relaxed)) return;
+    m_normalizationGainDb.store(gainDb, std::memory_order_relaxed);
+    m_normalizationGain.store(std::pow(10.0f, gainDb / 20.0f), std::memory_order_relaxed);
+}
+
+void SidPlayer::updateSilenceDetector(const int16_t* mixBuffer, int samples) {
+    if (m_masterSamplePos != m_silenceExpectedPos) {
+        // Nouveau morceau, nouveau subsong ou seek : repartir de zéro
+        m_silentSamples = 0;
+        m_heardSound = false;
+        m_endReported = false;
+    }
+    float timeoutS = m_silenceTimeoutS.load(std::memory_order_relaxed);
+    // Voix mutées par l'utilisateur : le silence ne dit rien de la fin du morceau
+    int voiceCount = getVoiceCount();
+    bool anyMuted = std::any_of(m_voiceMuted, m_voiceMuted + voiceCount, [](bool muted) { return muted; });
+    if (timeoutS <= 0.0f || anyMuted) {
+        m_silentSamples = 0;
+        return;
+    }
+    auto [low, high] = std::minmax_element(mixBuffer, mixBuffer + samples * OUTPUT_CHANNELS);
+    if (*high - *low >= SILENCE_PEAK_TO_PEAK) {
+        m_heardSound = true;
+        m_silentSamples = 0;
+        m_endReported = false;
+        return;
+    }
+    m_silentSamples += samples;
+    // Morceau muet dès le départ (player défaillant, digi non émulé) : délai doublé avant d'abandonner
+    int64_t limit = static_cast<int64_t>(timeoutS * m_emulationFreq) * (m_heardSound ? 1 : 2);
+    if (!m_endReported && m_silentSamples >= limit) {
+        m_endReported = true;
+        m_tuneEnded.store(true, std::memory_order_release);
+    }
+}
+
+void SidPlayer::captureOscilloscope(int samples) {
+    // Copie circulaire en deux morceaux au plus (fin puis début de l'historique)
+    int samplesToCapture = std::min(samples, OSCILLOSCOPE_HISTORY);
+    int skip = samples - samplesToCapture;
+    int firstPart = std::min(samplesToCapture, OSCILLOSCOPE_HISTORY - m_writeIndex);
+    int secondPart = samplesToCapture - firstPart;
+    int voiceCount = getVoiceCount();
+    for (int v = 0; v < voiceCount; ++v) {
+        const int16_t* voice = voiceBuffer(v) + skip;
+        std::memcpy(m_scopeHistory[v].data() + m_writeIndex, voice, firstPart * sizeof(int16_t));
+        std::memcpy(m_scopeHistory[v].data(), voice + firstPart, secondPart * sizeof(int16_t));
+    }
+    m_writeIndex = (m_writeIndex + samplesToCapture) & (OSCILLOSCOPE_HISTORY - 1);
+    // L'UI n'affiche qu'une trame par frame : inutile de décimer à chaque bloc
+    m_scopeSamplesSincePublish += samples;
+    if (m_scopeSamplesSincePublish >= m_emulationFreq / OSCILLOSCOPE_PUBLISH_HZ) {
+        m_scopeSamplesSincePublish = 0;
+        publishOscilloscopeFrame();
+    }
+}
+
+void SidPlayer::publishOscilloscopeFrame() {
+    const int mask = OSCILLOSCOPE_HISTORY - 1;
+    int freq = m_emulationFreq;
+    int window = static_cast<int>(m_scopeWindowMs.load(std::memory_order_relaxed) * freq / 1000.0f);
+    window = std::clamp(window, static_cast<int>(OSCILLOSCOPE_POINTS), OSCILLOSCOPE_HISTORY / 2);
+    
+    OscilloscopeFrame& frame = m_scopeFrames.writeBuffer();
+    frame.voiceCount = getVoiceCount();
+    for (int v = 0; v < frame.voiceCount; ++v) {
+        const int16_t* history = m_scopeHistory[v].data();
+        // Indice logique 0 = échantillon le plus ancien (m_writeIndex), HISTORY-1 = le plus récent
+        // Front montant le plus récent laissant une fenêtre complète après lui (recherche sur une fenêtre),
+        // sinon fenêtre la plus récente
+        int latest = OSCILLOSCOPE_HISTORY - window;
+        int start = latest;
+        for (int i = latest; i > latest - window; --i) {
+            if (history[(m_writeIndex + i - 1) & mask] < 0 && history[(m_writeIndex + i) & mask] >= 0) { start = i; break; }
+        }
+        // Décimation min/max : chaque colonne couvre window / OSCILLOSCOPE_POINTS échantillons
+        int base = m_writeIndex + start;
+        for (int c = 0; c < OSCILLOSCOPE_POINTS; ++c) {
+            int from = static_cast<int>(static_cast<int64_t>(c) * window / OSCILLOSCOPE_POINTS);
+            int to = static_cast<int>(static_cast<int64_t>(c + 1) * window / OSCILLOSCOPE_POINTS);
+            int16_t lo = history[(base + from) & mask];
+            int16_t hi = lo;
+            for (int i = from + 1; i < to; ++i) {
+                int16_t sample = history[(base + i) & mask];
+                lo = std::min(lo, sample);
+                hi = std::max(hi, sample);
+            }
+            frame.minValues[v][c] = lo / 32768.0f;
+            frame.maxValues[v][c] = hi / 32768.0f;
+        }
+    }
+    frame.windowMs = window * 1000.0f / freq;
+    frame.sequence = ++m_scopeSequence;
+    m_scopeFrames.publish();
+}
+
+void SidPlayer::setOscilloscopeWindowMs(float ms) {
+    m_scopeWindowMs.store(std::clamp(ms, 5.0f, 100.0f), std::memory_order_relaxed);
 }
 
 std::string SidPlayer::getSidModel() const {
@@ -219,21 +646,442 @@ void SidPlayer::setUseMasterEngine(bool useMaster) {
     m_useMasterEngine = useMaster;
 }
 
-void SidPlayer::audioCallbackWrapper(void* userdata, Uint8* stream, int len) {
-    static_cast<SidPlayer*>(userdata)->audioCallback(userdata, stream, len);
+void SidPlayer::setAnalysisVisible(bool visible) {
+    m_analysisVisible.store(visible, std::memory_order_relaxed);
+    if (visible && usesAnalysisEngines()) {
+        // Le thread de rendu rattrapera le retard dès qu'il aura du temps libre
+        m_analysisResyncing = (m_analysisSamplePos.load(std::memory_order_relaxed) < m_masterSamplePos.load(std::memory_order_relaxed));
+    }
 }
 
-void SidPlayer::drainAudioBuffer() {
-    if (m_audioDevice == 0) return;
-    int bufferTimeMs = (BUFFER_SIZE * 1000) / SAMPLE_RATE;
-    std::this_thread::sleep_for(std::chrono::milliseconds(bufferTimeMs * 3));
+bool SidPlayer::isSingleEngineCaptureSupported() {
+    return HAS_SID_STATUS != 0;
 }
 
-float SidPlayer::getPlaybackTime() const {
-    if (m_engineMaster) {
-        return m_engineMaster->time();
+void SidPlayer::setVoiceCaptureMode(VoiceCaptureMode mode) {
+    if (mode == m_captureMode) return;
+    if (mode == VoiceCaptureMode::SingleEngine && !isSingleEngineCaptureSupported()) return;
+    bool wasPlaying = m_playing && !m_paused;
+    if (wasPlaying) stop();
+    {
+        std::lock_guard<std::mutex> lock(m_engineMutex);
+        m_captureMode = mode;
+    }
+    // Les moteurs d'analyse ne tournaient pas (ou plus) : repartir du début du subsong pour les aligner
+    if (m_tune) selectSong(m_currentSong + 1);
+    if (wasPlaying) play();
+}
+
+void SidPlayer::audioCallbackWrapper(void* userdata, int16_t* out, int frames) {
+    static_cast<SidPlayer*>(userdata)->audioCallback(out, frames);
+}
+
+void SidPlayer::configureRenderPath(int deviceSamples, int deviceFreq) {
+    // Émulation à la fréquence fixe demandée, ou directement à celle du périphérique
+    m_emulationFreq = (m_emulationRate > 0) ? m_emulationRate : deviceFreq;
+    m_resampler.configure(m_emulationFreq, deviceFreq, OUTPUT_CHANNELS);
+    // Un bloc émulé couvre au plus la durée d'un buffer périphérique
+    int emulatedPerBuffer = static_cast<int>(static_cast<int64_t>(deviceSamples) * m_emulationFreq / deviceFreq);
+    m_renderChunkSize = std::clamp(emulatedPerBuffer, 1, static_cast<int>(MAX_AUDIO_BUFFER_SIZE));
+    m_renderOutputChunk = m_resampler.maxOutputFrames(m_renderChunkSize);
+    m_resampledAudioBuffer.assign(static_cast<size_t>(m_renderOutputChunk) * OUTPUT_CHANNELS, 0);
+    const int aheadSamples = std::max(m_renderOutputChunk * 4, deviceSamples * 2);
+    m_renderAheadSamples.store(aheadSamples, std::memory_order_relaxed);
+    // Le callback peut demander un buffer complet d'un coup : capacité = avance + un buffer + un bloc
+    m_ringBuffer.resize((aheadSamples + deviceSamples + m_renderOutputChunk) * OUTPUT_CHANNELS);
+    // Réveils espacés d'un quart de buffer périphérique (1ms minimum) : moins de réveils en mode économie
+    m_renderSleepMs.store(std::max(1, (deviceSamples * 1000) / (deviceFreq * 4)), std::memory_order_relaxed);
+    m_spectrum.setSampleRate(m_emulationFreq);
+    m_timing.setBudgets(static_cast<int64_t>(deviceSamples) * 1000000000LL / deviceFreq,
+                        static_cast<int64_t>(m_renderChunkSize) * 1000000000LL / m_emulationFreq);
+}
+
+void SidPlayer::setAudioSettings(int sampleRate, int bufferSize) {
+    sampleRate = std::clamp(sampleRate, 8000, 192000);
+    bufferSize = std::clamp(bufferSize, 64, 8192);
+    int pow2 = 64;
+    while (pow2 < bufferSize) pow2 <<= 1;
+    bufferSize = pow2;
+    if (sampleRate == m_sampleRate && bufferSize == m_bufferSize) return;
+    m_sampleRate = sampleRate;
+    m_bufferSize = bufferSize;
+    reopenAudioDevice();
+}
+
+void SidPlayer::setEmulationSettings(int emulationRate, bool fastSampling) {
+    emulationRate = (emulationRate > 0) ? std::clamp(emulationRate, 8000, 192000) : 0;
+    if (emulationRate == m_emulationRate && fastSampling == m_fastSampling) return;
+    // Un moteur préchargé avec l'ancienne configuration ne doit pas servir à la bascule
+    if (m_preloadThread.joinable()) m_preloadThread.join();
+    {
+        std::lock_guard<std::mutex> lock(m_nextMutex);
+        m_nextFile.clear();
     }
-    return 0.0f;
+    m_emulationRate = emulationRate;
+    m_fastSampling = fastSampling;
+    m_configuredFreq = 0; // Méthode d'échantillonnage changée : config() complet au rechargement
+    if (!audioOpen()) configureRenderPath(m_bufferSize, m_sampleRate);
+    reopenAudioDevice();
+}
+
+void SidPlayer::reopenAudioDevice() {
+    // Rouvrir le périphérique avec les nouveaux paramètres en conservant le subsong et l'état de lecture
+    bool wasPlaying = m_playing && !m_paused;
+    closeAudioDevice();
+    if (!m_tune || m_currentFile.empty()) return;
+    int song = m_currentSong + 1;
+    std::string file = m_currentFile;
+    if (loadFile(file)) {
+        selectSong(song);
+        if (wasPlaying) play();
+    }
+}
+
+void SidPlayer::preloadNextFile(const std::string& filepath) {
+    if (filepath.empty() || filepath == m_currentFile || !audioOpen()) return;
+    if (filepath == m_preloadRequested) return;
+    m_preloadRequested = filepath;
+    if (m_preloadThread.joinable()) m_preloadThread.join();
+    // Levé avant le lancement : la bascule ne touche plus à l'emplacement tant que le thread y travaille
+    m_preloading.store(true, std::memory_order_release);
+    m_preloadThread = std::thread(&SidPlayer::preloadThreadFunc, this, filepath, m_emulationFreq);
+}
+
+void SidPlayer::preloadThreadFunc(std::string filepath, int freq) {
+    struct PreloadDone {
+        std::atomic<bool>& flag;
+        ~PreloadDone() { flag.store(false, std::memory_order_release); }
+    } done{m_preloading};
+    {
+        std::lock_guard<std::mutex> lock(m_nextMutex);
+        m_nextFile.clear();
+    }
+    // Juste après une bascule, l'emplacement contient encore l'ancien master (fondu enchaîné)
+    while (m_crossfadeRemaining.load(std::memory_order_acquire) > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // Analyse, config() et préchauffage hors verrou : seul ce thread utilise m_engineNext pendant ce temps
+    auto tune = std::make_unique<SidTune>(filepath.c_str());
+    if (!tune->getStatus()) return;
+    const SidTuneInfo* tuneInfo = tune->getInfo();
+    if (!tuneInfo) return;
+    tune->selectSong(tuneInfo->startSong());
+    SidConfig::sid_model_t sidModel = (tuneInfo->sidModel(0) == SidTuneInfo::SIDMODEL_8580) ? SidConfig::MOS8580 : SidConfig::MOS6581;
+    int sidChips = sidChipCount(tuneInfo, m_maxSids);
+    int channels = (sidChips > 1) ? 2 : 1;
+    SidConfig cfg = engineConfig(freq, sidModel, channels);
+    cfg.sidEmulation = m_builderNext.get();
+    if (!m_engineNext->config(cfg)) return;
+    if (!m_engineNext->load(tune.get())) return;
+    // Même préchauffage que play() : la bascule n'aura plus rien à émuler hors du flux
+    int16_t dummy[512];
+    m_engineNext->play(dummy, 512);
+    std::lock_guard<std::mutex> lock(m_nextMutex);
+    m_nextTune = std::move(tune);
+    m_nextFreq = freq;
+    m_nextSidModel = sidModel;
+    m_nextSidChips = sidChips;
+    m_nextChannels = channels;
+    m_nextFile = filepath;
+}
+
+bool SidPlayer::isNextFilePreloaded(const std::string& filepath) const {
+    if (m_preloading.load(std::memory_order_acquire)) return false;
+    std::unique_lock<std::mutex> lock(m_nextMutex, std::try_to_lock);
+    return lock.owns_lock() && m_nextTune && m_nextFile == filepath && audioOpen() && m_nextFreq == m_emulationFreq;
+}
+
+bool SidPlayer::playPreloadedFile(const std::string& filepath) {
+    // Bascule à chaud uniquement en cours de lecture (sinon loadFile() + play() fait l'affaire)
+    cancelSeek();
+    if (!m_tune || !audioOpen() || !m_playing || m_paused) return false;
+    // Préchargement en cours : ne pas attendre sur le thread UI, loadFile() prend le relais
+    if (m_preloading.load(std::memory_order_acquire)) return false;
+    std::unique_lock<std::mutex> nextLock(m_nextMutex, std::try_to_lock);
+    if (!nextLock.owns_lock() || !m_nextTune || m_nextFile != filepath || m_nextFreq != m_emulationFreq) return false;
+    
+    // Le thread de rendu est entre deux blocs : le ring buffer garde la fin de l'ancien morceau
+    std::lock_guard<std::mutex> lock(m_engineMutex);
+    std::swap(m_engineMaster, m_engineNext);
+    std::swap(m_builderMaster, m_builderNext);
+    std::swap(m_tune, m_nextTune);
+    // m_nextChannels décrit désormais l'ancien master, joué en fondu depuis m_engineNext
+    int channels = m_nextChannels;
+    m_nextChannels = m_masterChannels.load();
+    m_masterChannels = channels;
+    m_configuredChannels = channels;
+    m_sidChips = m_nextSidChips;
+    m_nextFile.clear();
+    m_tuneEnded = false;
+    m_snapshots.clear();
+    ++m_snapshotGeneration;
+    m_preloadRequested.clear();
+    
+    const SidTuneInfo* tuneInfo = m_tune->getInfo();
+    m_currentSong = tuneInfo->startSong() - 1;
+    m_sidClockHz = (tuneInfo->clockSpeed() == SidTuneInfo::CLOCK_NTSC) ? NTSC_CLOCK_HZ : PAL_CLOCK_HZ;
+    applyVoiceMuting();
+    // Le nouveau master est déjà configuré ; les moteurs d'analyse suivent s'il change de modèle
+    if (m_nextSidModel != m_configuredSidModel) {
+        SidConfig cfg = engineConfig(m_emulationFreq, m_nextSidModel, 1);
+        cfg.sidEmulation = m_builderVoice0.get(); m_engineVoice0->config(cfg);
+        cfg.sidEmulation = m_builderVoice1.get(); m_engineVoice1->config(cfg);
+        cfg.sidEmulation = m_builderVoice2.get(); m_engineVoice2->config(cfg);
+        m_configuredSidModel = m_nextSidModel;
+    }
+    if (usesAnalysisEngines()) {
+        int16_t dummy[512];
+        m_engineVoice0->load(m_tune.get()); m_engineVoice1->load(m_tune.get()); m_engineVoice2->load(m_tune.get());
+        m_engineVoice0->play(dummy, 512); m_engineVoice1->play(dummy, 512); m_engineVoice2->play(dummy, 512);
+        applyAnalysisEngineMuting();
+    }
+    m_currentSidModel = m_nextSidModel;
+    m_currentFile = filepath;
+    updateTuneInfo(tuneInfo);
+    
+    for (VoiceTap& tap : m_voiceTaps) tap.reset();
+    m_masterSamplePos = 0;
+    m_analysisSamplePos = 0;
+    m_analysisResyncing = false;
+    // Fondu enchaîné : fade-in du nouveau morceau, fade-out de l'ancien (resté dans m_engineNext)
+    m_fadeInCounter = 0;
+    m_crossfadeRemaining = FADE_IN_DURATION;
+    return true;
+}
+
+bool SidPlayer::seek(float seconds) {
+    cancelSeek();
+    if (!m_tune || !audioOpen() || !m_playing) return false;
+    int64_t targetSamples = static_cast<int64_t>(std::max(0.0f, seconds) * m_emulationFreq);
+    m_seekProgress = 0.0f;
+    m_seeking = true;
+    // Plus de lecture ni de production pendant l'avance : l'audio en avance dans le ring buffer est obsolète
+    m_sink->pause(true);
+    {
+        std::lock_guard<std::mutex> lock(m_engineMutex);
+        m_ringBuffer.reset();
+        m_resampler.reset();
+    }
+    m_seekThread = std::thread(&SidPlayer::seekThreadFunc, this, targetSamples);
+    return true;
+}
+
+void SidPlayer::cancelSeek() {
+    if (!m_seekThread.joinable()) return;
+    m_seekCancel = true;
+    m_seekThread.join();
+    m_seekCancel = false;
+}
+
+void SidPlayer::seekThreadFunc(int64_t targetSamples) {
+    int64_t startPos = m_masterSamplePos.load();
+    bool fromSnapshot = false;
+    {
+        // Partir du snapshot le plus proche avant la cible s'il est plus près que le master
+        std::lock_guard<std::mutex> lock(m_engineMutex);
+        int64_t minPos = (targetSamples >= startPos) ? startPos + 1 : 0;
+        EngineSnapshot snapshot;
+        if (m_snapshots.take(m_currentSong, minPos, targetSamples, snapshot)) {
+            // Le master quitté est garé à sa position : revenir en arrière vers lui sera immédiat
+            startPos = swapMasterWithSnapshot(snapshot);
+            fromSnapshot = true;
+        }
+    }
+    if (!fromSnapshot && targetSamples < startPos) {
+        // Retour en arrière : repartir du début du subsong (pas d'état restaurable dans libsidplayfp)
+        std::lock_guard<std::mutex> lock(m_engineMutex);
+        m_engineMaster->load(m_tune.get());
+        applyVoiceMuting();
+        if (usesAnalysisEngines()) {
+            m_engineVoice0->load(m_tune.get()); m_engineVoice1->load(m_tune.get()); m_engineVoice2->load(m_tune.get());
+            applyAnalysisEngineMuting();
+        }
+        for (VoiceTap& tap : m_voiceTaps) tap.reset();
+        m_masterSamplePos = 0;
+        m_analysisSamplePos = 0;
+        startPos = 0;
+    }
+    
+    // Avance rapide du master seul, par tranches : le verrou est relâché entre deux tranches (mutes, UI)
+    // Les moteurs d'analyse restent en arrière et rattrapent ensuite via resyncAnalysisEngines()
+    const int64_t fastChunk = static_cast<int64_t>(MAX_AUDIO_BUFFER_SIZE) * FAST_FORWARD_PERCENT / 100;
+    while (!m_seekCancel) {
+        std::lock_guard<std::mutex> lock(m_engineMutex);
+        auto sliceStart = std::chrono::steady_clock::now();
+        int64_t pos = m_masterSamplePos;
+        int channels = m_masterChannels;
+        while (pos < targetSamples &&
+               std::chrono::steady_clock::now() - sliceStart < std::chrono::milliseconds(SEEK_SLICE_MS)) {
+            int64_t remaining = targetSamples - pos;
+            if (remaining >= fastChunk) {
+                m_engineMaster->fastForward(FAST_FORWARD_PERCENT);
+                m_engineMaster->play(m_masterAudioBuffer, MAX_AUDIO_BUFFER_SIZE * channels);
+                pos += fastChunk;
+            } else {
+                // Dernier morceau à vitesse normale pour tomber exactement sur la cible
+                m_engineMaster->fastForward(100);
+                int chunk = static_cast<int>(std::min<int64_t>(remaining, MAX_AUDIO_BUFFER_SIZE));
+                m_engineMaster->play(m_masterAudioBuffer, chunk * channels);
+                pos += chunk;
+            }
+        }
+        m_engineMaster->fastForward(100);
+        m_masterSamplePos = pos;
+        int64_t total = targetSamples - startPos;
+        m_seekProgress = (total > 0) ? static_cast<float>(pos - startPos) / total : 1.0f;
+        if (pos >= targetSamples) {
+            // Reprise en temps réel avec un fade-in (pas de clic à la jonction)
+            m_analysisResyncing = (usesAnalysisEngines() && m_analysisSamplePos < pos);
+            m_fadeInCounter = 0;
+            break;
+        }
+    }
+    m_seeking = false;
+    if (m_playing && !m_paused) m_sink->pause(false);
+}
+
+void SidPlayer::restartMaster() {
+    if (m_masterAtStart) return;
+    EngineSnapshot snapshot;
+    if (m_snapshots.take(m_currentSong, 0, 0, snapshot)) {
+        // Le master courant a pu être arrêté (stop()) : il n'est pas réutilisable comme snapshot
+        std::swap(m_engineMaster, snapshot.engine);
+        std::swap(m_builderMaster, snapshot.builder);
+        applyVoiceMuting();
+    } else {
+        int16_t dummy[512];
+        m_engineMaster->load(m_tune.get());
+        m_engineMaster->stop();
+        m_engineMaster->play(dummy, 512);
+        applyVoiceMuting();
+    }
+    m_masterSamplePos = 0;
+    m_masterAtStart = true;
+}
+
+int64_t SidPlayer::swapMasterWithSnapshot(EngineSnapshot& snapshot) {
+    int64_t masterPos = m_masterSamplePos;
+    std::swap(m_engineMaster, snapshot.engine);
+    std::swap(m_builderMaster, snapshot.builder);
+    std::swap(masterPos, snapshot.samplePos);
+    snapshot.song = m_currentSong;
+    m_snapshots.park(std::move(snapshot));
+    applyVoiceMuting();
+    m_masterSamplePos = masterPos;
+    m_masterAtStart = false;
+    for (VoiceTap& tap : m_voiceTaps) tap.reset();
+    if (usesAnalysisEngines() && m_analysisSamplePos > masterPos) {
+        // Moteurs d'analyse en avance sur le nouveau master : les relancer, la resynchronisation les ramènera
+        m_engineVoice0->load(m_tune.get()); m_engineVoice1->load(m_tune.get()); m_engineVoice2->load(m_tune.get());
+        applyAnalysisEngineMuting();
+        m_analysisSamplePos = 0;
+    }
+    return masterPos;
+}
+
+bool SidPlayer::createSnapshotEngine(EngineSnapshot& snapshot, int freq, SidConfig::sid_model_t sidModel, int channels) {
+    snapshot.engine = std::make_unique<sidplayfp>();
+    snapshot.builder = std::make_unique<ReSIDfpBuilder>("ReSIDfp-Snapshot");
+    snapshot.builder->create(m_maxSids);
+    snapshot.builder->filter(true);
+    SidConfig cfg = engineConfig(freq, sidModel, channels);
+    cfg.sidEmulation = snapshot.builder.get();
+    return snapshot.engine->config(cfg);
+}
+
+void SidPlayer::snapshotThreadLoop() {
+    int16_t buffer[MAX_AUDIO_BUFFER_SIZE * OUTPUT_CHANNELS];
+    while (m_renderThreadRunning) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(SNAPSHOT_POLL_MS));
+        if (!m_playing || m_paused || m_seeking || m_snapshots.getCapacity() == 0) continue;
+        
+        // Choisir la capture : d'abord le point post-init du subsong (selectSong, redémarrage),
+        // puis un point toutes les SNAPSHOT_INTERVAL_S déjà jouées, tant qu'il reste de la place
+        uint64_t generation;
+        int song;
+        int freq;
+        int channels;
+        int64_t target = -1;
+        SidConfig::sid_model_t sidModel;
+        {
+            std::lock_guard<std::mutex> lock(m_engineMutex);
+            if (!m_tune || !audioOpen()) continue;
+            generation = m_snapshotGeneration;
+            song = m_currentSong;
+            freq = m_emulationFreq;
+            channels = m_masterChannels;
+            sidModel = m_currentSidModel;
+            if (!m_snapshots.contains(song, 0)) {
+                target = 0;
+            } else if (m_snapshots.hasFreeSlot()) {
+                const int64_t interval = static_cast<int64_t>(SNAPSHOT_INTERVAL_S) * freq;
+                for (int64_t pos = interval; pos <= m_masterSamplePos; pos += interval) {
+                    if (!m_snapshots.contains(song, pos)) { target = pos; break; }
+                }
+            }
+        }
+        if (target < 0) continue;
+        
+        EngineSnapshot snapshot;
+        if (!createSnapshotEngine(snapshot, freq, sidModel, channels)) continue;
+        {
+            std::lock_guard<std::mutex> lock(m_engineMutex);
+            if (generation != m_snapshotGeneration || song != m_currentSong) continue;
+            snapshot.engine->load(m_tune.get());
+        }
+        // Même préchauffage que play(), puis avance rapide hors verrou (moteur privé à ce thread)
+        // par tranches entrecoupées de pauses : la capture reste une tâche de fond
+        snapshot.engine->play(buffer, 512);
+        const int64_t fastChunk = static_cast<int64_t>(MAX_AUDIO_BUFFER_SIZE) * FAST_FORWARD_PERCENT / 100;
+        int64_t pos = 0;
+        bool aborted = false;
+        while (pos < target) {
+            auto sliceStart = std::chrono::steady_clock::now();
+            while (pos < target && std::chrono::steady_clock::now() - sliceStart < std::chrono::milliseconds(SNAPSHOT_SLICE_MS)) {
+                int64_t remaining = target - pos;
+                if (remaining >= fastChunk) {
+                    snapshot.engine->fastForward(FAST_FORWARD_PERCENT);
+                    snapshot.engine->play(buffer, MAX_AUDIO_BUFFER_SIZE * channels);
+                    pos += fastChunk;
+                } else {
+                    snapshot.engine->fastForward(100);
+                    int chunk = static_cast<int>(std::min<int64_t>(remaining, MAX_AUDIO_BUFFER_SIZE));
+                    snapshot.engine->play(buffer, chunk * channels);
+                    pos += chunk;
+                }
+            }
+            if (!m_renderThreadRunning || generation != m_snapshotGeneration) { aborted = true; break; }
+            std::this_thread::sleep_for(std::chrono::milliseconds(SNAPSHOT_SLICE_MS));
+        }
+        snapshot.engine->fastForward(100);
+        if (aborted) continue;
+        std::lock_guard<std::mutex> lock(m_engineMutex);
+        if (generation != m_snapshotGeneration) continue;
+        snapshot.song = song;
+        snapshot.samplePos = target;
+        m_snapshots.park(std::move(snapshot));
+    }
+}
+
+void SidPlayer::setSnapshotMemoryBudget(int megabytes) {
+    m_snapshots.setMemoryBudget(static_cast<size_t>(std::max(0, megabytes)) * 1024 * 1024);
+}
+
+bool SidPlayer::dumpTimingStats(const std::string& path) const {
+    const char* mode = usesAnalysisEngines() ? "multi-engine" : "single engine";
+    std::string context = "Tune: " + (m_currentFile.empty() ? std::string("(none)") : m_currentFile) +
+        " #" + std::to_string(m_currentSong + 1) + ", " + std::to_string(m_sidChips.load()) + " SID\n" +
+        "Device: " + std::to_string(getSampleRate()) + " Hz, " + std::to_string(getDeviceBufferSize()) + " samples; " +
+        "emulation: " + std::to_string(m_emulationFreq) + " Hz (" + (m_fastSampling ? "interpolate" : "resample") + "), " +
+        mode + ", block " + std::to_string(m_renderChunkSize) + " samples";
+    return m_timing.appendReport(path, context);
+}
+
+float SidPlayer::getPlaybackTime() const {
+    // Position du master tenue par le thread de rendu : m_engineMaster peut être échangé
+    // (seek, bascule) et l'ancien moteur détruit par le pool pendant que l'UI lit
+    if (m_emulationFreq <= 0) return 0.0f;
+    return static_cast<float>(static_cast<double>(m_masterSamplePos.load(std::memory_order_relaxed)) / m_emulationFreq);
 }
 
 int SidPlayer::getTotalSongs() const {
@@ -259,6 +1107,7 @@ bool SidPlayer::selectSong(int songNum) {
     
     int totalSongs = info->songs();
     if (songNum < 1 || songNum > totalSongs) return false;
+    cancelSeek();
     
     // Arrêter la lecture si en cours
     bool wasPlaying = m_playing && !m_paused;
@@ -267,19 +1116,24 @@ bool SidPlayer::selectSong(int songNum) {
     }
     
     // Sélectionner le nouveau subsong
+    std::unique_lock<std::mutex> lock(m_engineMutex);
     m_tune->selectSong(songNum);
     m_currentSong = songNum - 1;  // Convertir en 0-based
     
-    // Recharger dans tous les engines
-    m_engineVoice0->load(m_tune.get());
-    m_engineVoice1->load(m_tune.get());
-    m_engineVoice2->load(m_tune.get());
-    m_engineMaster->load(m_tune.get());
-    
-    // Réappliquer les mutes
-    m_engineVoice0->mute(0, 1, false); m_engineVoice0->mute(0, 2, false);
-    m_engineVoice1->mute(0, 0, false); m_engineVoice1->mute(0, 2, false);
-    m_engineVoice2->mute(0, 0, false); m_engineVoice2->mute(0, 1, false);
+    // Recharger dans les engines actifs (master depuis le snapshot post-init du subsong s'il existe)
+    m_masterAtStart = false;
+    restartMaster();
+    if (usesAnalysisEngines()) {
+        m_engineVoice0->load(m_tune.get());
+        m_engineVoice1->load(m_tune.get());
+        m_engineVoice2->load(m_tune.get());
+        
+        // Réappliquer les mutes
+        applyAnalysisEngineMuting();
+    }
+    m_masterSamplePos = 0;
+    m_analysisSamplePos = 0;
+    lock.unlock();
     
     // Reprendre la lecture si elle était en cours
     if (wasPlaying) {
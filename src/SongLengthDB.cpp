@@ -4,6 +4,8 @@
 #include <sstream>
 #include <algorithm>
 #include <regex>
+#include <cmath>
+#include <cstdio>
 
 SongLengthDB& SongLengthDB::getInstance() {
     static SongLengthDB instance;
@@ -104,34 +106,13 @@ double SongLengthDB::parseDuration(const std::string& durationStr) {
     }
 }
 
-bool SongLengthDB::load(const std::string& filepath) {
-    // Vérifier que le fichier existe
-    if (!fs::exists(filepath)) {
-        LOG_ERROR("Songlengths.md5 file not found: {}", filepath);
-        return false;
-    }
-    
-    // Vérifier le format
-    if (!isValidFormat(filepath)) {
-        LOG_ERROR("Invalid Songlengths.md5 format: {}", filepath);
-        return false;
-    }
-    
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-        LOG_ERROR("Cannot open Songlengths.md5 file: {}", filepath);
-        return false;
-    }
-    
-    clear();
-    m_filepath = filepath;
-    
+size_t SongLengthDB::parseEntries(std::istream& input, std::unordered_map<std::string, std::vector<double>>& database) {
     std::string line;
     bool foundDatabaseHeader = false;
     size_t lineNumber = 0;
     size_t entriesLoaded = 0;
     
-    while (std::getline(file, line)) {
+    while (std::getline(input, line)) {
         lineNumber++;
         
         // Supprimer les espaces en début/fin
@@ -205,10 +186,40 @@ bool SongLengthDB::load(const std::string& filepath) {
         }
         
         if (!durations.empty()) {
-            m_database[md5Hash] = durations;
+            database[md5Hash] = durations;
             entriesLoaded++;
         }
     }
+    return entriesLoaded;
+}
+
+bool SongLengthDB::load(const std::string& filepath) {
+    // Vérifier que le fichier existe
+    if (!fs::exists(filepath)) {
+        LOG_ERROR("Songlengths.md5 file not found: {}", filepath);
+        return false;
+    }
+    
+    // Vérifier le format
+    if (!isValidFormat(filepath)) {
+        LOG_ERROR("Invalid Songlengths.md5 format: {}", filepath);
+        return false;
+    }
+    
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        LOG_ERROR("Cannot open Songlengths.md5 file: {}", filepath);
+        return false;
+    }
+    
+    // Lecture hors verrou, puis remplacement atomique de la base
+    std::unordered_map<std::string, std::vector<double>> database;
+    size_t entriesLoaded = parseEntries(file, database);
+    {
+        std::unique_lock<std::shared_mutex> lock(m_databaseMutex);
+        m_database = std::move(database);
+        m_filepath = filepath;
+    }
     
     LOG_INFO("Songlengths.md5 loaded: {} entries from {}", entriesLoaded, filepath);
     return true;
@@ -219,9 +230,18 @@ std::vector<double> SongLengthDB::getDurations(const std::string& md5Hash) const
     std::string normalizedHash = md5Hash;
     std::transform(normalizedHash.begin(), normalizedHash.end(), normalizedHash.begin(), ::tolower);
     
-    auto it = m_database.find(normalizedHash);
-    if (it != m_database.end()) {
-        return it->second;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_databaseMutex);
+        auto it = m_database.find(normalizedHash);
+        if (it != m_database.end()) {
+            return it->second;
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(m_overlayMutex);
+    auto overlayIt = m_overlay.find(normalizedHash);
+    if (overlayIt != m_overlay.end()) {
+        return overlayIt->second;
     }
     
     return {}; // Vecteur vide si non trouvé
@@ -241,14 +261,87 @@ bool SongLengthDB::hasHash(const std::string& md5Hash) const {
     std::string normalizedHash = md5Hash;
     std::transform(normalizedHash.begin(), normalizedHash.end(), normalizedHash.begin(), ::tolower);
     
+    std::shared_lock<std::shared_mutex> lock(m_databaseMutex);
     return m_database.find(normalizedHash) != m_database.end();
 }
 
+std::string SongLengthDB::getFilePath() const {
+    std::shared_lock<std::shared_mutex> lock(m_databaseMutex);
+    return m_filepath;
+}
+
+bool SongLengthDB::isLoaded() const {
+    std::shared_lock<std::shared_mutex> lock(m_databaseMutex);
+    return !m_filepath.empty() && !m_database.empty();
+}
+
+size_t SongLengthDB::getCount() const {
+    std::shared_lock<std::shared_mutex> lock(m_databaseMutex);
+    return m_database.size();
+}
+
 void SongLengthDB::clear() {
+    std::unique_lock<std::shared_mutex> lock(m_databaseMutex);
     m_database.clear();
     m_filepath.clear();
 }
 
+std::string SongLengthDB::formatDuration(double seconds) {
+    int totalMs = static_cast<int>(std::lround(std::max(0.0, seconds) * 1000.0));
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%d:%02d.%03d", totalMs / 60000, (totalMs / 1000) % 60, totalMs % 1000);
+    return buffer;
+}
 
+bool SongLengthDB::loadOverlay(const std::string& filepath) {
+    std::lock_guard<std::mutex> lock(m_overlayMutex);
+    m_overlay.clear();
+    m_overlayPath = filepath;
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        return false; // Pas encore de durées détectées
+    }
+    size_t entries = parseEntries(file, m_overlay);
+    LOG_INFO("Songlengths overlay loaded: {} entries from {}", entries, filepath);
+    return true;
+}
+
+void SongLengthDB::addDetectedDurations(const std::string& md5Hash, const std::vector<double>& durations) {
+    std::string normalizedHash = md5Hash;
+    std::transform(normalizedHash.begin(), normalizedHash.end(), normalizedHash.begin(), ::tolower);
+    
+    std::lock_guard<std::mutex> lock(m_overlayMutex);
+    m_overlay[normalizedHash] = durations;
+    if (m_overlayPath.empty()) {
+        return;
+    }
+    // Ajout en fin de fichier (l'en-tête est écrit à la création)
+    bool exists = fs::exists(m_overlayPath);
+    std::ofstream file(m_overlayPath, std::ios::app);
+    if (!file.is_open()) {
+        LOG_WARNING("Cannot write songlengths overlay: {}", m_overlayPath);
+        return;
+    }
+    if (!exists) {
+        file << "[Database]\n";
+    }
+    file << normalizedHash << "=";
+    for (size_t i = 0; i < durations.size(); ++i) {
+        file << (i ? " " : "") << formatDuration(durations[i]);
+    }
+    file << "\n";
+}
 
+bool SongLengthDB::hasOverlayEntry(const std::string& md5Hash) const {
+    std::string normalizedHash = md5Hash;
+    std::transform(normalizedHash.begin(), normalizedHash.end(), normalizedHash.begin(), ::tolower);
+    
+    std::lock_guard<std::mutex> lock(m_overlayMutex);
+    return m_overlay.find(normalizedHash) != m_overlay.end();
+}
+
+size_t SongLengthDB::getOverlayCount() const {
+    std::lock_guard<std::mutex> lock(m_overlayMutex);
+    return m_overlay.size();
+}
 
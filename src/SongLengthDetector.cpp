@@ -0,0 +1,227 @@
+#include "SongLengthDetector.h"
+#include "SongLengthDB.h"
+#include "SidCompat.h"
+#include "Logger.h"
+#include "Utils.h"
+#include <sidplayfp/sidplayfp.h>
+#include <sidplayfp/SidTune.h>
+#include <sidplayfp/SidTuneInfo.h>
+#include <sidplayfp/SidConfig.h>
+#include <sidplayfp/SidInfo.h>
+#include <sidplayfp/builders/residfp.h>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <unordered_map>
+
+namespace {
+    const int STEP_MS = 5;                    // Pas d'échantillonnage des registres (gates de 1 frame inclus)
+    const int SILENCE_PEAK_TO_PEAK = 96;      // ~ -56 dBFS sur un pas
+    const int LOOP_CHECK_INTERVAL_S = 30;     // Recherche de boucle toutes les 30 s émulées
+    const int MIN_LOOP_S = 4;                 // Période minimale (évite les motifs répétés dans une mesure)
+    const int MIN_VERIFY_S = 20;              // Durée minimale de répétition vérifiée après le point de boucle
+    const int TIMING_TOLERANCE_STEPS = 2;     // Gigue de quantification des attaques
+    const size_t MATCH_EVENTS = 32;           // Fenêtre d'attaques servant de clé de recherche
+
+    struct NoteEvent {
+        int64_t step;
+        uint32_t key;  // Voix, octet haut de fréquence, forme d'onde
+    };
+
+    uint64_t windowHash(const std::vector<NoteEvent>& events, size_t start) {
+        uint64_t hash = 1469598103934665603ull; // FNV-1a
+        for (size_t i = start; i < start + MATCH_EVENTS; ++i) {
+            hash = (hash ^ events[i].key) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // Toutes les attaques à partir de j reproduisent celles à partir de i, au même rythme
+    bool repeatsFrom(const std::vector<NoteEvent>& events, size_t i, size_t j) {
+        for (size_t m = 0; j + m < events.size(); ++m) {
+            if (events[i + m].key != events[j + m].key) return false;
+            int64_t drift = (events[j + m].step - events[j].step) - (events[i + m].step - events[i].step);
+            if (std::abs(drift) > TIMING_TOLERANCE_STEPS) return false;
+        }
+        return true;
+    }
+
+    // Premier point à partir duquel la partition se répète (en pas), 0 si aucun
+    int64_t findLoopStep(const std::vector<NoteEvent>& events, int64_t analyzedSteps) {
+        const int64_t minLoopSteps = MIN_LOOP_S * 1000 / STEP_MS;
+        const int64_t minVerifySteps = MIN_VERIFY_S * 1000 / STEP_MS;
+        if (events.size() < 2 * MATCH_EVENTS) return 0;
+        std::unordered_map<uint64_t, std::vector<size_t>> windows;
+        for (size_t j = 0; j + MATCH_EVENTS <= events.size(); ++j) {
+            std::vector<size_t>& candidates = windows[windowHash(events, j)];
+            for (size_t i : candidates) {
+                int64_t period = events[j].step - events[i].step;
+                if (period < minLoopSteps) continue;
+                // Au moins une période complète (et MIN_VERIFY_S) doit avoir été émulée après j
+                if (analyzedSteps - events[j].step < std::max(period, minVerifySteps)) continue;
+                if (repeatsFrom(events, i, j)) {
+                    // Boucle sur le début du tune : la reprise commence avant la première attaque
+                    return (i == 0) ? period : events[j].step;
+                }
+            }
+            candidates.push_back(j);
+        }
+        return 0;
+    }
+}
+
+SongLengthDetector& SongLengthDetector::getInstance() {
+    static SongLengthDetector instance;
+    return instance;
+}
+
+SongLengthDetector::~SongLengthDetector() {
+    shutdown();
+}
+
+void SongLengthDetector::request(const std::string& filepath, const std::string& md5Hash) {
+    if (filepath.empty() || md5Hash.empty()) return;
+    if (!SongLengthDB::getInstance().getDurations(md5Hash).empty()) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stopping) return;
+    // Un tune n'est analysé qu'une fois par session (même en cas d'échec de chargement)
+    if (!m_known.insert(md5Hash).second) return;
+    m_queue.push_back(Job{filepath, md5Hash});
+    if (!m_running) startWorkers();
+    m_condition.notify_one();
+}
+
+void SongLengthDetector::startWorkers() {
+    // Peu de workers : l'analyse est un travail de fond, jamais prioritaire sur la lecture
+    unsigned int count = std::max(1u, std::min(2u, std::thread::hardware_concurrency() / 4));
+    m_running = true;
+    for (unsigned int i = 0; i < count; ++i) {
+        m_workers.emplace_back(&SongLengthDetector::workerLoop, this);
+    }
+}
+
+void SongLengthDetector::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_running = false;
+        m_queue.clear();
+    }
+    m_condition.notify_all();
+    for (std::thread& worker : m_workers) {
+        if (worker.joinable()) worker.join();
+    }
+    m_workers.clear();
+}
+
+size_t SongLengthDetector::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size() + m_activeJobs;
+}
+
+void SongLengthDetector::workerLoop() {
+    lowerCurrentThreadPriority();
+    auto engine = std::make_unique<sidplayfp>();
+    auto builder = std::make_unique<ReSIDfpBuilder>("ReSIDfp-SongLength");
+    builder->create(engine->info().maxsids());
+    builder->filter(true);
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return !m_running || !m_queue.empty(); });
+            if (!m_running) return;
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_activeJobs++;
+        }
+
+        SidTune tune(job.filepath.c_str());
+        std::vector<double> durations;
+        int songs = 0;
+        if (tune.getStatus() && tune.getInfo()) {
+            const SidTuneInfo* tuneInfo = tune.getInfo();
+            songs = static_cast<int>(tuneInfo->songs());
+            SidConfig cfg;
+            cfg.frequency = ANALYSIS_SAMPLE_RATE;
+            cfg.playback = SidConfig::MONO;
+            cfg.samplingMethod = SidConfig::INTERPOLATE;
+            cfg.defaultSidModel = (tuneInfo->sidModel(0) == SidTuneInfo::SIDMODEL_8580) ? SidConfig::MOS8580 : SidConfig::MOS6581;
+            cfg.forceSidModel = true;
+            cfg.sidEmulation = builder.get();
+            if (engine->config(cfg)) {
+                for (int song = 1; song <= songs && !m_stopping; ++song) {
+                    tune.selectSong(song);
+                    if (!engine->load(&tune)) break;
+                    durations.push_back(analyzeSubsong(*engine, ANALYSIS_SAMPLE_RATE, &m_stopping));
+                }
+            }
+            engine->load(nullptr);
+        }
+
+        if (!m_stopping && songs > 0 && static_cast<int>(durations.size()) == songs) {
+            SongLengthDB::getInstance().addDetectedDurations(job.md5Hash, durations);
+            m_detectedCount.fetch_add(1, std::memory_order_relaxed);
+            LOG_INFO("Song length detected for {}: {} subsong(s), first {:.1f} s", job.filepath, songs, durations[0]);
+        } else if (!m_stopping) {
+            LOG_WARNING("Song length detection failed for {}", job.filepath);
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_activeJobs--;
+    }
+}
+
+double SongLengthDetector::analyzeSubsong(sidplayfp& engine, int sampleRate, const std::atomic<bool>* cancel) {
+    const int stepSamples = std::max(1, sampleRate * STEP_MS / 1000);
+    const double stepSeconds = static_cast<double>(stepSamples) / sampleRate;
+    const int64_t maxSteps = static_cast<int64_t>(MAX_ANALYSIS_S / stepSeconds);
+    const int64_t silenceSteps = static_cast<int64_t>(SILENCE_MIN_S / stepSeconds);
+    const int64_t loopCheckSteps = static_cast<int64_t>(LOOP_CHECK_INTERVAL_S / stepSeconds);
+
+    std::vector<short> buffer(stepSamples);
+    std::vector<NoteEvent> events;
+    bool gates[3] = {};
+    bool heardSound = false;
+    int64_t silentSince = -1;
+
+    for (int64_t step = 0; step < maxSteps; ++step) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) return 0.0;
+        if (engine.play(buffer.data(), stepSamples) == 0) {
+            // Le tune s'est arrêté (ou erreur d'émulation)
+            return step * stepSeconds;
+        }
+
+        // Silence : crête à crête minuscule sur tout le pas (insensible à l'offset DC du 6581)
+        auto [low, high] = std::minmax_element(buffer.begin(), buffer.end());
+        if (*high - *low >= SILENCE_PEAK_TO_PEAK) {
+            heardSound = true;
+            silentSince = -1;
+        } else if (heardSound) {
+            if (silentSince < 0) silentSince = step;
+            else if (step - silentSince >= silenceSteps) return silentSince * stepSeconds;
+        }
+
+#if HAS_SID_STATUS
+        // Attaques de notes : front montant du gate, avec fréquence (octet haut) et forme d'onde
+        uint8_t regs[32] = {};
+        if (engine.getSidStatus(0, regs)) {
+            for (int v = 0; v < 3; ++v) {
+                uint8_t control = regs[v * 7 + 4];
+                bool gate = (control & 0x01) != 0;
+                if (gate && !gates[v]) {
+                    uint32_t key = static_cast<uint32_t>(v) | (static_cast<uint32_t>(regs[v * 7 + 1]) << 2) |
+                                   (static_cast<uint32_t>(control & 0xF0) << 6);
+                    events.push_back(NoteEvent{step, key});
+                }
+                gates[v] = gate;
+            }
+        }
+#endif
+        if ((step + 1) % loopCheckSteps == 0) {
+            int64_t loopStep = findLoopStep(events, step + 1);
+            if (loopStep > 0) return loopStep * stepSeconds;
+        }
+    }
+    return 0.0;
+}
@@ -0,0 +1,118 @@
+#include "SpectrumAnalyzer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+    const size_t INPUT_CAPACITY = SpectrumAnalyzer::FFT_SIZE * 8;
+    const int WORKER_SLEEP_MS = 5;
+    const int DISABLED_SLEEP_MS = 50;
+    const float RELEASE_PER_HOP = 0.04f; // Retombée des barres (fraction de la plage dB par analyse)
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer()
+    : m_input{AudioRingBuffer(INPUT_CAPACITY), AudioRingBuffer(INPUT_CAPACITY),
+              AudioRingBuffer(INPUT_CAPACITY), AudioRingBuffer(INPUT_CAPACITY)},
+      m_hann(FFT_SIZE), m_windowed(FFT_SIZE), m_power(FFT_SIZE / 2 + 1), m_hop(INPUT_CAPACITY),
+      m_fft(FFT_SIZE), m_sequence(0),
+      m_running(true), m_enabled(false), m_sampleRate(44100), m_analysisTimeMs(0.0f)
+{
+    const double pi = 3.14159265358979323846;
+    for (int i = 0; i < FFT_SIZE; ++i) {
+        m_hann[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * pi * i / (FFT_SIZE - 1)));
+    }
+    for (int c = 0; c < NUM_CHANNELS; ++c) {
+        m_window[c].assign(FFT_SIZE, 0.0f);
+        std::fill(m_smoothed[c], m_smoothed[c] + NUM_BANDS, 0.0f);
+    }
+    m_worker = std::thread(&SpectrumAnalyzer::workerLoop, this);
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer() {
+    m_running = false;
+    if (m_worker.joinable()) m_worker.join();
+}
+
+void SpectrumAnalyzer::setEnabled(bool enabled) {
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void SpectrumAnalyzer::push(const int16_t* voice0, const int16_t* voice1, const int16_t* voice2, const int16_t* master, int samples) {
+    if (!m_enabled.load(std::memory_order_relaxed)) return;
+    // Tout ou rien pour garder les 4 canaux alignés
+    for (const AudioRingBuffer& input : m_input) {
+        if (input.freeSpace() < static_cast<size_t>(samples)) return;
+    }
+    m_input[0].write(voice0, samples);
+    m_input[1].write(voice1, samples);
+    m_input[2].write(voice2, samples);
+    m_input[MASTER_CHANNEL].write(master, samples);
+}
+
+void SpectrumAnalyzer::workerLoop() {
+    while (m_running) {
+        if (!m_enabled.load(std::memory_order_relaxed)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(DISABLED_SLEEP_MS));
+            continue;
+        }
+        size_t available = m_input[MASTER_CHANNEL].available();
+        for (const AudioRingBuffer& input : m_input) available = std::min(available, input.available());
+        // En retard de plus de deux fenêtres (fenêtre masquée, machine chargée) : sauter à la fin
+        if (available > static_cast<size_t>(FFT_SIZE * 2)) {
+            size_t skip = available - FFT_SIZE;
+            for (AudioRingBuffer& input : m_input) input.read(m_hop.data(), skip);
+            available -= skip;
+        }
+        if (available < static_cast<size_t>(HOP_SIZE)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(WORKER_SLEEP_MS));
+            continue;
+        }
+        // Faire glisser chaque fenêtre de HOP_SIZE et y ajouter les nouveaux échantillons
+        for (int c = 0; c < NUM_CHANNELS; ++c) {
+            std::vector<float>& window = m_window[c];
+            std::copy(window.begin() + HOP_SIZE, window.end(), window.begin());
+            m_input[c].read(m_hop.data(), HOP_SIZE);
+            for (int i = 0; i < HOP_SIZE; ++i) {
+                window[FFT_SIZE - HOP_SIZE + i] = m_hop[i] / 32768.0f;
+            }
+        }
+        analyze();
+    }
+}
+
+void SpectrumAnalyzer::analyze() {
+    auto start = std::chrono::steady_clock::now();
+    float sampleRate = static_cast<float>(m_sampleRate.load(std::memory_order_relaxed));
+    float nyquist = sampleRate * 0.5f;
+    float binWidth = sampleRate / FFT_SIZE;
+    // Normalisation : une sinusoïde pleine échelle donne 0 dB (gain cohérent de Hann = 0.5)
+    const float reference = (FFT_SIZE * 0.25f) * (FFT_SIZE * 0.25f);
+    const int lastBin = FFT_SIZE / 2;
+
+    Frame& frame = m_frames.writeBuffer();
+    for (int c = 0; c < NUM_CHANNELS; ++c) {
+        const std::vector<float>& window = m_window[c];
+        for (int i = 0; i < FFT_SIZE; ++i) m_windowed[i] = window[i] * m_hann[i];
+        m_fft.powerSpectrum(m_windowed.data(), m_power.data());
+
+        for (int b = 0; b < NUM_BANDS; ++b) {
+            // Bornes logarithmiques de MIN_FREQUENCY à Nyquist ; au moins un bin par bande
+            float lowFreq = MIN_FREQUENCY * std::pow(nyquist / MIN_FREQUENCY, static_cast<float>(b) / NUM_BANDS);
+            float highFreq = MIN_FREQUENCY * std::pow(nyquist / MIN_FREQUENCY, static_cast<float>(b + 1) / NUM_BANDS);
+            int lowBin = std::clamp(static_cast<int>(lowFreq / binWidth), 1, lastBin);
+            int highBin = std::clamp(static_cast<int>(highFreq / binWidth), lowBin, lastBin);
+            float peak = 0.0f;
+            for (int k = lowBin; k <= highBin; ++k) peak = std::max(peak, m_power[k]);
+            float db = 10.0f * std::log10(peak / reference + 1e-12f);
+            float level = std::clamp((db - MIN_DB) / -MIN_DB, 0.0f, 1.0f);
+            m_smoothed[c][b] = std::max(level, m_smoothed[c][b] - RELEASE_PER_HOP);
+            frame.bands[c][b] = m_smoothed[c][b];
+        }
+    }
+    frame.sequence = ++m_sequence;
+    m_frames.publish();
+
+    float elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    float previous = m_analysisTimeMs.load(std::memory_order_relaxed);
+    m_analysisTimeMs.store(previous == 0.0f ? elapsedMs : previous * 0.9f + elapsedMs * 0.1f, std::memory_order_relaxed);
+}
@@ -1,5 +1,8 @@
 #include "UIManager.h"
 #include "SongLengthDB.h"
+#include "SongLengthDetector.h"
+#include "LoudnessAnalyzer.h"
+#include "LoudnessMeter.h"
 #include "Config.h"
 #include "Utils.h"
 #include "FilterWidget.h"
@@ -43,8 +46,11 @@ UIManager::UIManager(SidPlayer& player, PlaylistManager& playlist, BackgroundMan
       m_flatListValid(false),        // Virtual Scrolling : liste plate invalide au départ
       m_visibleIndicesValid(false),  // Virtual Scrolling : liste d'indices invalide au départ
       m_cachedCurrentIndex(-1), m_navigationCacheValid(false),
-      m_currentFPS(0.0f), m_oscilloscopeTime(0.0f), m_oscilloscopePlot0Time(0.0f), 
-      m_oscilloscopePlot1Time(0.0f), m_oscilloscopePlot2Time(0.0f),
+      m_songLengthRequestSong(-1),
+      m_loudnessSong(-1), m_loudnessHadMetadata(false), m_loudnessEnabled(false), m_loudnessTargetLufs(0.0f),
+      m_loudnessDirty(true),
+      m_currentFPS(0.0f), m_oscilloscopeTime(0.0f), m_oscilloscopePlotTime(0.0f),
+      m_oscilloscopesVisible(false),
       m_rainbowCycleOffset(0) {
     generateRainbowPalette();
 }
@@ -144,6 +150,9 @@ void UIManager::render() {
     // Réinitialiser isConfigTabActive au début de chaque frame
     m_isConfigTabActive = false;
     
+    // Remis à true par renderOscilloscopes() si l'onglet Player est affiché
+    m_oscilloscopesVisible = false;
+    
     // Gérer le cyclage arc-en-ciel des étoiles (si activé)
     Config& config = Config::getInstance();
     bool rainbowEnabled = config.isStarRatingRainbow();
@@ -210,6 +219,11 @@ void UIManager::render() {
                          storedRenderDrawDataTime, storedPresentTime, storedTotalFrameTime);
     }
     
+    // Suspendre les moteurs d'analyse quand aucun oscilloscope n'est affiché
+    m_player.setAnalysisVisible(m_oscilloscopesVisible);
+    // Worker FFT à l'arrêt (et aucune copie côté rendu) quand le spectre n'est pas affiché
+    m_player.getSpectrumAnalyzer().setEnabled(m_oscilloscopesVisible && config.isSpectrumVisible());
+    
     // Appeler le callback pour rendre le dialog de mise à jour (si défini)
     // Cela doit être fait après ImGui::NewFrame() mais avant ImGui::Render()
     if (m_updateDialogCallback) {
@@ -403,6 +417,7 @@ void UIManager::renderPlayerTab() {
         
         // Récupérer la durée depuis les métadonnées (si sauvegardée) ou SongLengthDB
         const SidMetadata* metadata = m_database.getMetadata(m_player.getCurrentFile());
+        updateLoudnessNormalization(metadata);
         if (metadata) {
             double totalDuration = -1.0;
             int subsongIndex = m_player.getCurrentSong(); // 0-based
@@ -411,10 +426,16 @@ void UIManager::renderPlayerTab() {
             if (!metadata->songLengths.empty() && subsongIndex < metadata->songLengths.size()) {
                 totalDuration = metadata->songLengths[subsongIndex];
             } else if (!metadata->md5Hash.empty()) {
-                // Fallback : chercher dans SongLengthDB
+                // Fallback : chercher dans SongLengthDB (base officielle puis durées détectées)
                 SongLengthDB& db = SongLengthDB::getInstance();
-                if (db.isLoaded()) {
-                    totalDuration = db.getDuration(metadata->md5Hash, subsongIndex);
+                totalDuration = db.getDuration(metadata->md5Hash, subsongIndex);
+                if (totalDuration < 0.0 && (subsongIndex != m_songLengthRequestSong ||
+                                            m_player.getCurrentFile() != m_songLengthRequestFile)) {
+                    // Inconnue : analyse en arrière-plan (demandée une fois par morceau/subsong),
+                    // la barre apparaîtra une fois la durée détectée
+                    m_songLengthRequestFile = m_player.getCurrentFile();
+                    m_songLengthRequestSong = subsongIndex;
+                    SongLengthDetector::getInstance().request(m_songLengthRequestFile, metadata->md5Hash);
                 }
             }
             
@@ -443,8 +464,13 @@ void UIManager::renderPlayerTab() {
                 
                 // Formater le texte centré
                 char progressText[64];
-                snprintf(progressText, sizeof(progressText), "%d:%02d / %d:%02d", 
-                        currentMinutes, currentSeconds, totalMinutes, totalSeconds);
+                if (m_player.isSeeking()) {
+                    snprintf(progressText, sizeof(progressText), "Seeking... %d%%",
+                            static_cast<int>(m_player.getSeekProgress() * 100.0f));
+                } else {
+                    snprintf(progressText, sizeof(progressText), "%d:%02d / %d:%02d", 
+                            currentMinutes, currentSeconds, totalMinutes, totalSeconds);
+                }
                 
                 // Créer une barre de progression personnalisée avec dégradé pastel
                 ImVec2 pos = ImGui::GetCursorScreenPos();
@@ -453,6 +479,17 @@ void UIManager::renderPlayerTab() {
                 ImVec2 barMin = pos;
                 ImVec2 barMax = ImVec2(pos.x + barWidth, pos.y + barHeight);
                 
+                // Clic dans la barre : seek à la position correspondante
+                ImGui::InvisibleButton("##SeekBar", ImVec2(barWidth, barHeight));
+                if (ImGui::IsItemClicked() && barWidth > 0.0f) {
+                    float fraction = (ImGui::GetIO().MousePos.x - barMin.x) / barWidth;
+                    fraction = std::max(0.0f, std::min(1.0f, fraction));
+                    m_player.seek(static_cast<float>(fraction * totalDuration));
+                }
+                if (ImGui::IsItemHovered()) {
+                    ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
+                }
+                
                 // Dessiner le fond de la barre
                 ImDrawList* drawList = ImGui::GetWindowDrawList();
                 ImU32 bgColor = ImGui::GetColorU32(ImGuiCol_FrameBg);
@@ -553,6 +590,15 @@ void UIManager::renderPlayerTab() {
                 // Déplacer le curseur après la barre
                 ImGui::SetCursorScreenPos(ImVec2(barMin.x, barMax.y + ImGui::GetStyle().ItemSpacing.y));
                 
+                // Préparer le morceau suivant en arrière-plan quelques secondes avant la fin
+                // (enchaînement sans blanc : pas de réouverture du périphérique audio)
+                if (!m_player.isLoopEnabled() && m_player.isPlaying() && currentTime >= totalDuration - 10.0f) {
+                    PlaylistNode* preloadNode = getNextFilteredFile();
+                    if (preloadNode && !preloadNode->filepath.empty()) {
+                        m_player.preloadNextFile(preloadNode->filepath);
+                    }
+                }
+                
                 // Détecter la fin du morceau et gérer le passage au suivant (si loop désactivé)
                 // Si loop est actif, libsidplayfp boucle naturellement, on ne fait rien
                 static bool songEnded = false; // Variable statique pour éviter les déclenchements multiples
@@ -560,24 +606,8 @@ void UIManager::renderPlayerTab() {
                     // Le morceau est terminé (avec une petite marge de 0.5s) - seulement si loop désactivé
                     if (!songEnded) { // Éviter les déclenchements multiples
                         songEnded = true;
-                        
                         // Loop désactivé : passer au morceau suivant
-                        PlaylistNode* nextNode = getNextFilteredFile();
-                        if (nextNode && !nextNode->filepath.empty()) {
-                            // Toujours trouver le nœud correspondant dans l'arbre original pour setCurrentNode
-                            // (même sans filtres, pour s'assurer qu'on utilise le bon pointeur)
-                            PlaylistNode* originalNode = m_playlist.findNodeByPath(nextNode->filepath);
-                            PlaylistNode* targetNode = originalNode ? originalNode : nextNode;
-                            m_playlist.setCurrentNode(targetNode);
-                            m_playlist.setScrollToCurrent(true);
-                            if (m_player.loadFile(nextNode->filepath)) {
-                                m_player.play();
-                                recordHistoryEntry(nextNode->filepath);
-                            }
-                        } else {
-                            // Pas de morceau suivant, arrêter
-                            m_player.stop();
-                        }
+                        playNextTune();
                     }
                 } else {
                     // Réinitialiser le flag si on n'est plus à la fin
@@ -610,6 +640,12 @@ void UIManager::renderPlayerTab() {
         ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "No file loaded");
     }
     
+    // Fin détectée par le silence en sortie (durée inconnue, ou queue muette avant la durée de la base)
+    if (m_player.consumeTuneEnded() && !m_player.isLoopEnabled() && m_player.isPlaying() && !m_player.isPaused()) {
+        LOG_INFO("Silence detected, skipping to next tune: {}", m_player.getCurrentFile());
+        playNextTune();
+    }
+    
     ImGui::Separator();
     ImGui::Spacing();
 
@@ -634,139 +670,102 @@ void UIManager::renderOscilloscopes() {
     if (m_player.getCurrentFile().empty()) return;
     
     auto oscStart = std::chrono::high_resolution_clock::now();
+    m_oscilloscopesVisible = true;
     
     ImGui::Text("Oscilloscopes by voice:");
+    if (m_player.isAnalysisResyncing()) {
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.3f, 1.0f), "(syncing...)");
+    }
+    // Durée de la fenêtre (déclenchement et décimation côté audio : coût d'affichage constant)
+    ImGui::SameLine();
+    Config& config = Config::getInstance();
+    float windowMs = config.getOscilloscopeWindowMs();
+    ImGui::PushItemWidth(150.0f);
+    if (ImGui::SliderFloat("##ScopeWindow", &windowMs, 5.0f, 100.0f, "%.0f ms")) {
+        config.setOscilloscopeWindowMs(windowMs);
+        m_player.setOscilloscopeWindowMs(config.getOscilloscopeWindowMs());
+    }
+    if (ImGui::IsItemDeactivatedAfterEdit()) {
+        fs::path configDir = getConfigDir();
+        std::string configPath = (configDir / "config.txt").string();
+        config.save(configPath);
+    }
+    ImGui::PopItemWidth();
     ImGui::Spacing();
     
-    const float* voice0 = m_player.getVoiceBuffer(0);
-    const float* voice1 = m_player.getVoiceBuffer(1);
-    const float* voice2 = m_player.getVoiceBuffer(2);
+    // Trame cohérente et stable pour toute la frame UI (pas de lecture concurrente du rendu)
+    const SidPlayer::OscilloscopeFrame& scopeFrame = m_player.acquireOscilloscopeFrame();
     
-    float plotHeight = 120.0f;
+    // Une rangée de 3 oscilloscopes par puce SID (2SID/3SID : rangées moins hautes)
+    int voiceCount = std::min(scopeFrame.voiceCount, static_cast<int>(SidPlayer::MAX_VOICES));
+    float plotHeight = (voiceCount > 3) ? 80.0f : 120.0f;
     float plotWidth = ImGui::GetContentRegionAvail().x / 3.0f - 5.0f;
+    static const ImVec4 voiceColors[3] = {
+        ImVec4(1.3f, 0.3f, 0.3f, 1.0f), ImVec4(0.3f, 1.0f, 0.3f, 1.0f), ImVec4(0.3f, 0.3f, 1.0f, 1.0f)
+    };
     
-    bool voice0Active = m_player.isVoiceMuted(0);
-    bool voice1Active = m_player.isVoiceMuted(1);
-    bool voice2Active = m_player.isVoiceMuted(2);
-    
-    bool prev0 = voice0Active;
-    bool prev1 = voice1Active;
-    bool prev2 = voice2Active;
-    
-    // Voix 0
-    ImGui::PushID("voice0");
-    ImVec2 plotPos0 = ImGui::GetCursorScreenPos();
-    ImGui::SetCursorScreenPos(ImVec2(plotPos0.x + plotWidth - 20.0f, plotPos0.y + 3.0f));
-    ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(2.0f, 2.0f));
-    ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(2.0f, 2.0f));
-    ImGui::Checkbox("##mute", &voice0Active);
-    ImGui::PopStyleVar(2);
-    ImGui::SetCursorScreenPos(plotPos0);
-    ImVec4 bgColor = ImVec4(0.1f, 0.1f, 0.1f, voice0Active ? 0.1f : 0.3f);
-    ImGui::PushStyleColor(ImGuiCol_FrameBg, bgColor);
-    ImGui::PushStyleColor(ImGuiCol_PlotLines, ImVec4(1.3f, 0.3f, 0.3f, voice0Active ? 0.3f : 1.0f));
-    if (ImGui::InvisibleButton("##clickable0", ImVec2(plotWidth, plotHeight))) {
-        voice0Active = !voice0Active;
-    }
-    if (ImGui::IsItemHovered()) {
-        ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
-        ImDrawList* drawList = ImGui::GetWindowDrawList();
-        ImVec2 mMin = ImGui::GetItemRectMin();
-        ImVec2 mMax = ImGui::GetItemRectMax();
-        drawList->AddRectFilled(mMin, mMax, IM_COL32(0, 0, 0, 60), 5.0f);
-        drawList->AddRect(mMin, mMax, IM_COL32(255, 255, 255, 30), 5.0f);
-    }
-    ImGui::SetCursorScreenPos(plotPos0);
-    auto t0 = std::chrono::high_resolution_clock::now();
-    ImGui::PlotLines("##plot", voice0, SidPlayer::OSCILLOSCOPE_SIZE, 0, nullptr, -1.0f, 1.0f, 
-                    ImVec2(plotWidth, plotHeight));
-    auto t1 = std::chrono::high_resolution_clock::now();
-    static long long plot0Time = 0;
-    plot0Time += std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
-    ImGui::PopStyleColor(2);
-    ImGui::GetWindowDrawList()->AddText(ImVec2(plotPos0.x + 5.0f, plotPos0.y + 5.0f), 
-                                       IM_COL32(255, 255, 255, 255), "0");
-    ImGui::PopID();
-    
-    ImGui::SameLine();
-    
-    // Voix 1
-    ImGui::PushID("voice1");
-    ImVec2 plotPos1 = ImGui::GetCursorScreenPos();
-    ImGui::SetCursorScreenPos(ImVec2(plotPos1.x + plotWidth - 20.0f, plotPos1.y + 3.0f));
-    ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(2.0f, 2.0f));
-    ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(2.0f, 2.0f));
-    ImGui::Checkbox("##mute", &voice1Active);
-    ImGui::PopStyleVar(2);
-    ImGui::SetCursorScreenPos(plotPos1);
-    ImVec4 bgColor1 = ImVec4(0.1f, 0.1f, 0.1f, voice1Active ? 0.1f : 0.3f);
-    ImGui::PushStyleColor(ImGuiCol_FrameBg, bgColor);
-    ImGui::PushStyleColor(ImGuiCol_PlotLines, ImVec4(0.3f, 1.0f, 0.3f, voice1Active ? 0.3f : 1.0f));
-    ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 10.0f);
-    if (ImGui::InvisibleButton("##clickable1", ImVec2(plotWidth, plotHeight))) {
-        voice1Active = !voice1Active;
-    }
-    if (ImGui::IsItemHovered()) {
-        ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
-        ImDrawList* drawList = ImGui::GetWindowDrawList();
-        ImVec2 mMin = ImGui::GetItemRectMin();
-        ImVec2 mMax = ImGui::GetItemRectMax();
-        drawList->AddRectFilled(mMin, mMax, IM_COL32(0, 0, 0, 60), 5.0f);
-        drawList->AddRect(mMin, mMax, IM_COL32(255, 255, 255, 30), 5.0f);
-    }
-    ImGui::SetCursorScreenPos(plotPos1);
-    auto t2 = std::chrono::high_resolution_clock::now();
-    ImGui::PlotLines("##plot", voice1, SidPlayer::OSCILLOSCOPE_SIZE, 0, nullptr, -1.0f, 1.0f, 
-                    ImVec2(plotWidth, plotHeight));
-    auto t3 = std::chrono::high_resolution_clock::now();
-    static long long plot1Time = 0;
-    plot1Time += std::chrono::duration_cast<std::chrono::microseconds>(t3 - t2).count();
-    ImGui::PopStyleVar();
-    ImGui::PopStyleColor(2);
-    ImGui::GetWindowDrawList()->AddText(ImVec2(plotPos1.x + 5.0f, plotPos1.y + 5.0f), 
-                                       IM_COL32(255, 255, 255, 255), "1");
-    ImGui::PopID();
-    
-    ImGui::SameLine();
-    
-    // Voix 2
-    ImGui::PushID("voice2");
-    ImVec2 plotPos2 = ImGui::GetCursorScreenPos();
-    ImGui::SetCursorScreenPos(ImVec2(plotPos2.x + plotWidth - 20.0f, plotPos2.y + 3.0f));
-    ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(2.0f, 2.0f));
-    ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(2.0f, 2.0f));
-    ImGui::Checkbox("##mute", &voice2Active);
-    ImGui::PopStyleVar(2);
-    ImGui::SetCursorScreenPos(plotPos2);
-    ImVec4 bgColor2 = ImVec4(0.1f, 0.1f, 0.1f, voice1Active ? 0.1f : 0.3f);
-    ImGui::PushStyleColor(ImGuiCol_FrameBg, bgColor2);
-    ImGui::PushStyleColor(ImGuiCol_PlotLines, ImVec4(0.3f, 0.3f, 1.0f, voice2Active ? 0.3f : 1.0f));
-    if (ImGui::InvisibleButton("##clickable2", ImVec2(plotWidth, plotHeight))) {
-        voice2Active = !voice2Active;
-    }
-    if (ImGui::IsItemHovered()) {
-        ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
-        ImDrawList* drawList = ImGui::GetWindowDrawList();
-        ImVec2 mMin = ImGui::GetItemRectMin();
-        ImVec2 mMax = ImGui::GetItemRectMax();
-        drawList->AddRectFilled(mMin, mMax, IM_COL32(0, 0, 0, 60), 5.0f);
-        drawList->AddRect(mMin, mMax, IM_COL32(255, 255, 255, 30), 5.0f);
-    }
-    ImGui::SetCursorScreenPos(plotPos2);
-    auto t4 = std::chrono::high_resolution_clock::now();
-    ImGui::PlotLines("##plot", voice2, SidPlayer::OSCILLOSCOPE_SIZE, 0, nullptr, -1.0f, 1.0f, 
-                    ImVec2(plotWidth, plotHeight));
-    auto t5 = std::chrono::high_resolution_clock::now();
-    static long long plot2Time = 0;
-    plot2Time += std::chrono::duration_cast<std::chrono::microseconds>(t5 - t4).count();
-    ImGui::PopStyleColor(2);
-    ImGui::GetWindowDrawList()->AddText(ImVec2(plotPos2.x + 5.0f, plotPos2.y + 5.0f), 
-                                       IM_COL32(255, 255, 255, 255), "2");
-    ImGui::PopID();
-    
-    if (voice0Active != prev0) m_player.setVoiceMute(0, voice0Active);
-    if (voice1Active != prev1) m_player.setVoiceMute(1, voice1Active);
-    if (voice2Active != prev2) m_player.setVoiceMute(2, voice2Active);
+    long long plotTime = 0;
+    for (int v = 0; v < voiceCount; ++v) {
+        bool muted = m_player.isVoiceMuted(v);
+        bool wasMuted = muted;
+        if (v % 3 != 0) ImGui::SameLine();
+        
+        ImGui::PushID(v);
+        ImVec2 plotPos = ImGui::GetCursorScreenPos();
+        ImGui::SetCursorScreenPos(ImVec2(plotPos.x + plotWidth - 20.0f, plotPos.y + 3.0f));
+        ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(2.0f, 2.0f));
+        ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(2.0f, 2.0f));
+        ImGui::Checkbox("##mute", &muted);
+        ImGui::PopStyleVar(2);
+        ImGui::SetCursorScreenPos(plotPos);
+        ImVec4 color = voiceColors[v % 3];
+        color.w = muted ? 0.3f : 1.0f;
+        ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.1f, 0.1f, 0.1f, muted ? 0.1f : 0.3f));
+        ImGui::PushStyleColor(ImGuiCol_PlotLines, color);
+        if (ImGui::InvisibleButton("##clickable", ImVec2(plotWidth, plotHeight))) {
+            muted = !muted;
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
+            ImDrawList* drawList = ImGui::GetWindowDrawList();
+            ImVec2 mMin = ImGui::GetItemRectMin();
+            ImVec2 mMax = ImGui::GetItemRectMax();
+            drawList->AddRectFilled(mMin, mMax, IM_COL32(0, 0, 0, 60), 5.0f);
+            drawList->AddRect(mMin, mMax, IM_COL32(255, 255, 255, 30), 5.0f);
+        }
+        ImGui::SetCursorScreenPos(plotPos);
+        auto t0 = std::chrono::high_resolution_clock::now();
+        renderScopeTrace(scopeFrame.minValues[v], scopeFrame.maxValues[v], SidPlayer::OSCILLOSCOPE_POINTS,
+                         ImVec2(plotWidth, plotHeight));
+        auto t1 = std::chrono::high_resolution_clock::now();
+        plotTime += std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+        ImGui::PopStyleColor(2);
+        // Libellé : numéro de voix, préfixé de la puce pour les tunes multi-SID
+        char label[8];
+        if (voiceCount > 3) snprintf(label, sizeof(label), "%d.%d", v / 3 + 1, v % 3);
+        else snprintf(label, sizeof(label), "%d", v);
+        ImGui::GetWindowDrawList()->AddText(ImVec2(plotPos.x + 5.0f, plotPos.y + 5.0f),
+                                           IM_COL32(255, 255, 255, 255), label);
+        ImGui::PopID();
+        
+        if (muted != wasMuted) m_player.setVoiceMute(v, muted);
+    }
+    static long long totalPlotTime = 0;
+    totalPlotTime += plotTime;
+    
+    // Spectre : calculé par le worker de l'analyseur, l'UI ne fait que dessiner la dernière trame
+    ImGui::Spacing();
+    bool spectrumVisible = config.isSpectrumVisible();
+    if (ImGui::Checkbox("Spectrum", &spectrumVisible)) {
+        config.setSpectrumVisible(spectrumVisible);
+        fs::path configDir = getConfigDir();
+        std::string configPath = (configDir / "config.txt").string();
+        config.save(configPath);
+    }
+    if (spectrumVisible) {
+        renderSpectrum(ImVec2(ImGui::GetContentRegionAvail().x, plotHeight));
+    }
     
     ImGui::Spacing();
     ImGui::Separator();
@@ -782,20 +781,73 @@ void UIManager::renderOscilloscopes() {
     if (frameCount % 60 == 0) {
         // Convertir en millisecondes et stocker dans les variables membres
         m_oscilloscopeTime = totalOscTime / 60.0 / 1000.0;
-        m_oscilloscopePlot0Time = plot0Time / 60.0 / 1000.0;
-        m_oscilloscopePlot1Time = plot1Time / 60.0 / 1000.0;
-        m_oscilloscopePlot2Time = plot2Time / 60.0 / 1000.0;
+        m_oscilloscopePlotTime = totalPlotTime / 60.0 / 1000.0;
         
-        UI_LOG_DEBUG("[Oscilloscopes] Total: {:.2f} us/frame avg, Plot0: {:.2f} us, Plot1: {:.2f} us, Plot2: {:.2f} us",
-                  totalOscTime / 60.0 / 1000.0, plot0Time / 60.0 / 1000.0, 
-                  plot1Time / 60.0 / 1000.0, plot2Time / 60.0 / 1000.0);
+        UI_LOG_DEBUG("[Oscilloscopes] Total: {:.2f} us/frame avg, Plots ({}): {:.2f} us",
+                  totalOscTime / 60.0 / 1000.0, voiceCount, totalPlotTime / 60.0 / 1000.0);
         totalOscTime = 0;
-        plot0Time = 0;
-        plot1Time = 0;
-        plot2Time = 0;
+        totalPlotTime = 0;
     }
 }
 
+void UIManager::renderScopeTrace(const float* minValues, const float* maxValues, int count, const ImVec2& size) {
+    // Remplace PlotLines : fond + tracé min/max en zigzag (2 sommets par colonne, nombre fixe)
+    // Couleurs et arrondi pris dans le style courant, comme PlotLines
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ImVec2 pos = ImGui::GetCursorScreenPos();
+    ImVec2 end = ImVec2(pos.x + size.x, pos.y + size.y);
+    drawList->AddRectFilled(pos, end, ImGui::GetColorU32(ImGuiCol_FrameBg), ImGui::GetStyle().FrameRounding);
+    
+    static ImVec2 points[SidPlayer::OSCILLOSCOPE_POINTS * 2];
+    count = std::min(count, static_cast<int>(SidPlayer::OSCILLOSCOPE_POINTS));
+    float padding = ImGui::GetStyle().FramePadding.y;
+    float halfHeight = (size.y - 2.0f * padding) * 0.5f;
+    float centerY = pos.y + size.y * 0.5f;
+    float step = (count > 1) ? size.x / (count - 1) : 0.0f;
+    for (int i = 0; i < count; ++i) {
+        float x = pos.x + i * step;
+        // Alterner l'ordre min/max pour que le tracé reste continu d'une colonne à l'autre
+        float first = (i & 1) ? maxValues[i] : minValues[i];
+        float second = (i & 1) ? minValues[i] : maxValues[i];
+        points[i * 2] = ImVec2(x, centerY - std::clamp(first, -1.0f, 1.0f) * halfHeight);
+        points[i * 2 + 1] = ImVec2(x, centerY - std::clamp(second, -1.0f, 1.0f) * halfHeight);
+    }
+    drawList->AddPolyline(points, count * 2, ImGui::GetColorU32(ImGuiCol_PlotLines), ImDrawFlags_None, 1.0f);
+    ImGui::Dummy(size);
+}
+
+void UIManager::renderSpectrum(const ImVec2& size) {
+    // Barres pour le master, courbes pour les voix (mêmes couleurs que les oscilloscopes)
+    const SpectrumAnalyzer::Frame& frame = m_player.getSpectrumAnalyzer().acquireFrame();
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ImVec2 pos = ImGui::GetCursorScreenPos();
+    ImVec2 end = ImVec2(pos.x + size.x, pos.y + size.y);
+    drawList->AddRectFilled(pos, end, ImGui::GetColorU32(ImVec4(0.1f, 0.1f, 0.1f, 0.3f)), ImGui::GetStyle().FrameRounding);
+    
+    const int bands = SpectrumAnalyzer::NUM_BANDS;
+    float bandWidth = size.x / bands;
+    const float* master = frame.bands[SpectrumAnalyzer::MASTER_CHANNEL];
+    ImU32 barColor = IM_COL32(200, 200, 200, 90);
+    for (int b = 0; b < bands; ++b) {
+        float x0 = pos.x + b * bandWidth;
+        float top = end.y - std::clamp(master[b], 0.0f, 1.0f) * size.y;
+        drawList->AddRectFilled(ImVec2(x0 + 1.0f, top), ImVec2(x0 + bandWidth - 1.0f, end.y), barColor);
+    }
+    
+    static const ImVec4 voiceColors[3] = {
+        ImVec4(1.3f, 0.3f, 0.3f, 1.0f), ImVec4(0.3f, 1.3f, 0.3f, 1.0f), ImVec4(0.3f, 0.3f, 1.3f, 1.0f)
+    };
+    ImVec2 points[SpectrumAnalyzer::NUM_BANDS];
+    for (int v = 0; v < 3; ++v) {
+        if (m_player.isVoiceMuted(v)) continue;
+        for (int b = 0; b < bands; ++b) {
+            points[b] = ImVec2(pos.x + (b + 0.5f) * bandWidth, end.y - std::clamp(frame.bands[v][b], 0.0f, 1.0f) * size.y);
+        }
+        drawList->AddPolyline(points, bands, ImGui::GetColorU32(voiceColors[v]), ImDrawFlags_None, 1.0f);
+    }
+    ImGui::Dummy(size);
+}
+
 void UIManager::renderPlayerControls() {
     ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(20.0f, 12.0f));
     
@@ -914,12 +966,24 @@ void UIManager::renderPlayerControls() {
         ImGui::Text("Audio Engine:");
         ImGui::Spacing();
         
+        // Single engine : 1 émulation, voix des oscilloscopes reconstruites depuis les registres
+        // Multi engine : 3 moteurs d'analyse + master (référence, ~4x le coût CPU)
+        bool multiEngine = m_player.getVoiceCaptureMode() == VoiceCaptureMode::MultiEngine;
+        ImGui::BeginDisabled(!SidPlayer::isSingleEngineCaptureSupported());
+        if (ImGui::Checkbox("Per-voice engines (reference, 4x CPU)", &multiEngine)) {
+            m_player.setVoiceCaptureMode(multiEngine ? VoiceCaptureMode::MultiEngine : VoiceCaptureMode::SingleEngine);
+        }
+        ImGui::EndDisabled();
+        
         int engineMode = m_player.isUsingMasterEngine() ? 1 : 0;
         int prevEngineMode = engineMode;
         
+        // Le choix master/mixé n'a de sens qu'avec les moteurs par voix
+        ImGui::BeginDisabled(!multiEngine);
         ImGui::RadioButton("Master Engine (Native)", &engineMode, 1);
         ImGui::SameLine();
         ImGui::RadioButton("Mixed (3 voices)", &engineMode, 0);
+        ImGui::EndDisabled();
         
         if (engineMode != prevEngineMode) {
             m_player.setUseMasterEngine(engineMode == 1);
@@ -1116,6 +1180,124 @@ void UIManager::renderConfigTab() {
     ImGui::Separator();
     ImGui::Spacing();
     
+    // Section Audio Output
+    ImGui::Text("Audio Output");
+    ImGui::Separator();
+    
+    static const int latencyValues[] = {
+        static_cast<int>(LatencyProfile::LowLatency),
+        static_cast<int>(LatencyProfile::Default),
+        static_cast<int>(LatencyProfile::PowerSaving)
+    };
+    static const char* latencyLabels[] = { "Low latency (128)", "Default (256)", "Power saving (4096)" };
+    static const int sampleRateValues[] = { 44100, 48000, 96000 };
+    static const char* sampleRateLabels[] = { "44.1 kHz", "48 kHz", "96 kHz" };
+    
+    int latencyIndex = 1;
+    for (int i = 0; i < 3; ++i) {
+        if (latencyValues[i] == config.getAudioBufferSize()) latencyIndex = i;
+    }
+    int sampleRateIndex = 0;
+    for (int i = 0; i < 3; ++i) {
+        if (sampleRateValues[i] == config.getAudioSampleRate()) sampleRateIndex = i;
+    }
+    
+    bool audioChanged = false;
+    ImGui::PushItemWidth(200.0f);
+    if (ImGui::Combo("Latency profile", &latencyIndex, latencyLabels, 3)) {
+        config.setAudioBufferSize(latencyValues[latencyIndex]);
+        audioChanged = true;
+    }
+    if (ImGui::Combo("Sample rate", &sampleRateIndex, sampleRateLabels, 3)) {
+        config.setAudioSampleRate(sampleRateValues[sampleRateIndex]);
+        audioChanged = true;
+    }
+    ImGui::PopItemWidth();
+    if (audioChanged) {
+        m_player.setAudioSettings(config.getAudioSampleRate(), config.getAudioBufferSize());
+        // Sauvegarder la config
+        fs::path configDir = getConfigDir();
+        std::string configPath = (configDir / "config.txt").string();
+        config.save(configPath);
+    }
+    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Device: %s output, %d Hz, %d samples per buffer",
+                       m_player.getAudioSinkName(), m_player.getSampleRate(), m_player.getDeviceBufferSize());
+    
+    // Fréquence d'émulation découplée du périphérique (rééchantillonnage polyphase si elles diffèrent)
+    static const int emulationRateValues[] = { 0, 44100, 48000 };
+    static const char* emulationRateLabels[] = { "Device rate", "44.1 kHz", "48 kHz" };
+    int emulationRateIndex = 0;
+    for (int i = 0; i < 3; ++i) {
+        if (emulationRateValues[i] == config.getEmulationRate()) emulationRateIndex = i;
+    }
+    bool fastSampling = config.isFastSamplingEnabled();
+    bool emulationChanged = false;
+    ImGui::PushItemWidth(200.0f);
+    if (ImGui::Combo("Emulation rate", &emulationRateIndex, emulationRateLabels, 3)) {
+        config.setEmulationRate(emulationRateValues[emulationRateIndex]);
+        emulationChanged = true;
+    }
+    ImGui::PopItemWidth();
+    if (ImGui::Checkbox("Fast sampling (interpolate)", &fastSampling)) {
+        config.setFastSamplingEnabled(fastSampling);
+        emulationChanged = true;
+    }
+    if (emulationChanged) {
+        m_player.setEmulationSettings(config.getEmulationRate(), config.isFastSamplingEnabled());
+        // Sauvegarder la config
+        fs::path configDir = getConfigDir();
+        std::string configPath = (configDir / "config.txt").string();
+        config.save(configPath);
+    }
+    if (m_player.isResampling()) {
+        ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Emulation: %d Hz, resampled to %d Hz",
+                           m_player.getEmulationRate(), m_player.getSampleRate());
+    } else {
+        ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Emulation: %d Hz (no resampling)", m_player.getEmulationRate());
+    }
+    
+    int snapshotMemory = config.getSnapshotMemoryMB();
+    ImGui::PushItemWidth(200.0f);
+    if (ImGui::SliderInt("Snapshot memory (MB)", &snapshotMemory, 0, 64)) {
+        config.setSnapshotMemoryMB(snapshotMemory);
+        m_player.setSnapshotMemoryBudget(config.getSnapshotMemoryMB());
+    }
+    if (ImGui::IsItemDeactivatedAfterEdit()) {
+        fs::path configDir = getConfigDir();
+        std::string configPath = (configDir / "config.txt").string();
+        config.save(configPath);
+    }
+    ImGui::PopItemWidth();
+    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Emulator snapshots for instant seek and subsong restart (0 = off)");
+    
+    int silenceSkip = config.getSilenceSkipSeconds();
+    ImGui::PushItemWidth(200.0f);
+    if (ImGui::SliderInt("Skip after silence (s)", &silenceSkip, 0, 30)) {
+        config.setSilenceSkipSeconds(silenceSkip);
+        m_player.setSilenceTimeout(static_cast<float>(config.getSilenceSkipSeconds()));
+    }
+    if (ImGui::IsItemDeactivatedAfterEdit()) {
+        fs::path configDir = getConfigDir();
+        std::string configPath = (configDir / "config.txt").string();
+        config.save(configPath);
+    }
+    ImGui::PopItemWidth();
+    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Next tune when the output stays silent this long (0 = off, loop disabled only)");
+    
+    bool normalization = config.isLoudnessNormalizationEnabled();
+    if (ImGui::Checkbox("Loudness normalization", &normalization)) {
+        config.setLoudnessNormalizationEnabled(normalization);
+        fs::path configDir = getConfigDir();
+        std::string configPath = (configDir / "config.txt").string();
+        config.save(configPath);
+    }
+    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Plays every tune at %.0f LUFS (EBU R128, analysed in the background)",
+                       config.getLoudnessTargetLufs());
+    
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::Spacing();
+    
 #ifdef ENABLE_CLOUD_SAVE
     // Section Cloud Save
     ImGui::Text("Cloud Save");
@@ -1743,8 +1925,12 @@ void UIManager::renderPlaylistNavigation() {
                 }
             }
             m_playlist.setCurrentNode(targetNode);
-            if (m_player.loadFile(next->filepath)) {
+            bool started = m_player.playPreloadedFile(next->filepath);
+            if (!started && m_player.loadFile(next->filepath)) {
                 m_player.play();
+                started = true;
+            }
+            if (started) {
                 recordHistoryEntry(next->filepath);
             }
         }
@@ -2248,6 +2434,71 @@ void UIManager::invalidateNavigationCache() {
     m_cachedCurrentIndex = -1;
 }
 
+void UIManager::updateLoudnessNormalization(const SidMetadata* metadata) {
+    Config& config = Config::getInstance();
+    int song = m_player.getCurrentSong();
+    bool enabled = config.isLoudnessNormalizationEnabled();
+    float targetLufs = config.getLoudnessTargetLufs();
+    if (!m_loudnessDirty && song == m_loudnessSong && (metadata != nullptr) == m_loudnessHadMetadata &&
+        enabled == m_loudnessEnabled && targetLufs == m_loudnessTargetLufs && m_player.getCurrentFile() == m_loudnessFile) {
+        return;
+    }
+    m_loudnessFile = m_player.getCurrentFile();
+    m_loudnessSong = song;
+    m_loudnessHadMetadata = (metadata != nullptr);
+    m_loudnessEnabled = enabled;
+    m_loudnessTargetLufs = targetLufs;
+    m_loudnessDirty = false;
+    
+    float gainDb = 0.0f;
+    if (metadata) {
+        size_t subsongIndex = static_cast<size_t>(song);
+        float lufs = (subsongIndex < metadata->loudness.size()) ? metadata->loudness[subsongIndex] : 0.0f;
+        if (!metadata->isLoudnessAnalyzed()) {
+            LoudnessAnalyzer::getInstance().request(metadata->filepath, metadata->md5Hash, metadata->numberOfSongs);
+        }
+        if (lufs != 0.0f && enabled && lufs > imsid::audio::LoudnessMeter::SILENCE_LUFS) {
+            // Amplification bornée : au-delà, un tune très calme serait surtout du bruit de fond saturé
+            gainDb = std::clamp(targetLufs - lufs, -MAX_NORMALIZATION_DB, MAX_NORMALIZATION_DB);
+        }
+    }
+    m_player.setNormalizationGain(gainDb);
+    
+    // Analyser aussi le morceau suivant pour que son gain soit connu dès le début de sa lecture
+    PlaylistNode* nextNode = getNextFilteredFile();
+    if (nextNode && !nextNode->filepath.empty()) {
+        const SidMetadata* nextMetadata = m_database.getMetadata(nextNode->filepath);
+        if (nextMetadata && !nextMetadata->isLoudnessAnalyzed()) {
+            LoudnessAnalyzer::getInstance().request(nextMetadata->filepath, nextMetadata->md5Hash,
+                                                    nextMetadata->numberOfSongs);
+        }
+    }
+}
+
+void UIManager::playNextTune() {
+    PlaylistNode* nextNode = getNextFilteredFile();
+    if (nextNode && !nextNode->filepath.empty()) {
+        // Toujours trouver le nœud correspondant dans l'arbre original pour setCurrentNode
+        // (même sans filtres, pour s'assurer qu'on utilise le bon pointeur)
+        PlaylistNode* originalNode = m_playlist.findNodeByPath(nextNode->filepath);
+        PlaylistNode* targetNode = originalNode ? originalNode : nextNode;
+        m_playlist.setCurrentNode(targetNode);
+        m_playlist.setScrollToCurrent(true);
+        // Bascule sans blanc si le morceau a été préchargé, sinon chargement classique
+        bool started = m_player.playPreloadedFile(nextNode->filepath);
+        if (!started && m_player.loadFile(nextNode->filepath)) {
+            m_player.play();
+            started = true;
+        }
+        if (started) {
+            recordHistoryEntry(nextNode->filepath);
+        }
+    } else {
+        // Pas de morceau suivant, arrêter
+        m_player.stop();
+    }
+}
+
 PlaylistNode* UIManager::getNextFilteredFile() {
     // Utiliser uniquement le cache existant (construit par renderPlaylistNavigation)
     // Le cache est construit/mis à jour par renderPlaylistNavigation() à chaque frame
@@ -3013,9 +3264,64 @@ void UIManager::renderDebugWindow(long long newFrameTime, long long mainPanelTim
         // Oscilloscope timings
         ImGui::Text("Oscilloscope Timings:");
         ImGui::Text("  Total:     %.2f ms", m_oscilloscopeTime);
-        ImGui::Text("  Plot 0:    %.2f ms", m_oscilloscopePlot0Time);
-        ImGui::Text("  Plot 1:    %.2f ms", m_oscilloscopePlot1Time);
-        ImGui::Text("  Plot 2:    %.2f ms", m_oscilloscopePlot2Time);
+        ImGui::Text("  Plots:     %.2f ms (%d voices)", m_oscilloscopePlotTime, m_player.getVoiceCount());
+        ImGui::Text("  Spectrum FFT: %.3f ms/frame (worker)", m_player.getSpectrumAnalyzer().getAnalysisTimeMs());
+        ImGui::Separator();
+        
+        // Détection des durées manquantes
+        SongLengthDetector& detector = SongLengthDetector::getInstance();
+        ImGui::Text("Song lengths: %zu pending, %llu detected, overlay %zu", detector.getPendingCount(),
+                    static_cast<unsigned long long>(detector.getDetectedCount()),
+                    SongLengthDB::getInstance().getOverlayCount());
+        LoudnessAnalyzer& loudness = LoudnessAnalyzer::getInstance();
+        ImGui::Text("Loudness: %zu pending, %llu analysed, gain %+.1f dB", loudness.getPendingCount(),
+                    static_cast<unsigned long long>(loudness.getAnalyzedCount()), m_player.getNormalizationGain());
+        ImGui::Separator();
+        
+        // Thread de rendu audio
+        ImGui::Text("Audio Render Thread:");
+        ImGui::Text("  Ring fill: %zu samples (%.1f%%)", m_player.getRingFillSamples(), m_player.getRingFillLevel() * 100.0f);
+        ImGui::Text("  Underruns: %llu", static_cast<unsigned long long>(m_player.getUnderrunCount()));
+        
+        // Temps par étape (µs) face au budget temps réel : bloc émulé et buffer périphérique
+        const AudioTimingStats& timing = m_player.getTimingStats();
+        ImGui::Text("  Late callbacks: %llu, block overruns: %llu",
+                    static_cast<unsigned long long>(timing.getLateCallbacks()),
+                    static_cast<unsigned long long>(timing.getOverruns()));
+        ImGui::Text("  Budgets: block %.0f us, callback %.0f us",
+                    timing.getBlockBudgetNs() / 1000.0, timing.getCallbackBudgetNs() / 1000.0);
+        for (int stage = 0; stage < AudioTimingStats::STAGE_COUNT; ++stage) {
+            AudioTimingStats::Summary summary = timing.getSummary(stage);
+            if (summary.count == 0) continue;
+            ImGui::Text("  %-9s mean %7.1f  p99 %6.0f  max %7.1f us", AudioTimingStats::stageName(stage),
+                        summary.meanUs, summary.p99Us, summary.maxUs);
+        }
+        float blockHistogram[AudioTimingStats::BUCKETS];
+        int lastBucket = 0;
+        for (int b = 0; b < AudioTimingStats::BUCKETS; ++b) {
+            blockHistogram[b] = static_cast<float>(timing.getBucketCount(AudioTimingStats::STAGE_BLOCK, b));
+            if (blockHistogram[b] > 0.0f) lastBucket = b;
+        }
+        ImGui::PlotHistogram("##block_timing", blockHistogram, lastBucket + 1, 0, "Block time (log buckets)",
+                             0.0f, FLT_MAX, ImVec2(0, 60));
+        if (ImGui::Button("Reset timings")) m_player.resetTimingStats();
+        ImGui::SameLine();
+        if (ImGui::Button("Dump to file")) {
+            std::string path = (getConfigDir() / "audio_timing.txt").string();
+            if (m_player.dumpTimingStats(path)) {
+                LOG_INFO("Audio timing report appended to {}", path);
+            } else {
+                LOG_ERROR("Failed to write audio timing report to {}", path);
+            }
+        }
+        PlaylistNode* nextNode = getNextFilteredFile();
+        bool nextReady = nextNode && m_player.isNextFilePreloaded(nextNode->filepath);
+        ImGui::Text("  Next tune: %s", nextReady ? "preloaded (gapless)" : "not preloaded");
+        const EngineSnapshotPool& snapshots = m_player.getSnapshotPool();
+        ImGui::Text("  Snapshots: %zu / %zu, hit rate %.0f%% (%llu hits, %llu misses)",
+                    snapshots.size(), snapshots.getCapacity(), snapshots.getHitRate() * 100.0f,
+                    static_cast<unsigned long long>(snapshots.getHits()),
+                    static_cast<unsigned long long>(snapshots.getMisses()));
     }
     ImGui::End();
 }
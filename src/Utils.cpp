@@ -11,6 +11,11 @@
 #else
 #include <unistd.h>
 #include <pwd.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 #endif
 
 fs::path getConfigDir() {
@@ -55,6 +60,17 @@ fs::path getConfigDir() {
     return configDir;
 }
 
+void lowerCurrentThreadPriority() {
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#elif defined(__APPLE__)
+    pthread_set_qos_class_self_np(QOS_CLASS_BACKGROUND, 0);
+#elif defined(__linux__)
+    // Sous Linux, la priorité "nice" s'applique au thread (tid) et non au processus entier
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10);
+#endif
+}
+
 std::string calculateFileMD5(const std::string& filepath) {
     try {
         std::ifstream file(filepath, std::ios::binary);
@@ -82,6 +98,27 @@ std::string calculateFileMD5(const std::string& filepath) {
     }
 }
 
+std::string calculateDataMD5(const uint8_t* data, size_t size) {
+    imsid::ImSidMD5 md5;
+    md5.update(data, size);
+    md5.finalize();
+    return md5.toString();
+}
+
+bool readFileBytes(const std::string& filepath, std::vector<uint8_t>& data, size_t maxBytes) {
+    std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    std::streamoff size = static_cast<std::streamoff>(file.tellg());
+    if (size <= 0 || static_cast<uint64_t>(size) > maxBytes) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(data.data()), size));
+}
+
 std::string latin1ToUtf8(const std::string& latin1) {
     std::string utf8;
     utf8.reserve(latin1.length() * 2); // UTF-8 peut être jusqu'à 2x plus grand
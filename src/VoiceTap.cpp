@@ -0,0 +1,115 @@
+#include "VoiceTap.h"
+#include <algorithm>
+
+namespace {
+    // Durées d'attaque du SID en millisecondes (datasheet 6581), decay/release = x3
+    const float ATTACK_MS[16] = {
+        2.0f, 8.0f, 16.0f, 24.0f, 38.0f, 56.0f, 68.0f, 80.0f,
+        100.0f, 250.0f, 500.0f, 800.0f, 1000.0f, 3000.0f, 5000.0f, 8000.0f
+    };
+
+    const uint32_t ACCUMULATOR_MASK = 0xFFFFFF;
+    const uint32_t NOISE_LFSR_INIT = 0x7FFFF8;
+
+    // Octet de sortie du générateur de bruit (bits 20,18,14,11,9,5,2,0 du LFSR) sur 12 bits
+    inline uint32_t noiseOutput(uint32_t lfsr) {
+        return (((lfsr >> 20) & 1) << 11) | (((lfsr >> 18) & 1) << 10) |
+               (((lfsr >> 14) & 1) << 9) | (((lfsr >> 11) & 1) << 8) |
+               (((lfsr >> 9) & 1) << 7) | (((lfsr >> 5) & 1) << 6) |
+               (((lfsr >> 2) & 1) << 5) | ((lfsr & 1) << 4);
+    }
+}
+
+VoiceTap::VoiceTap() {
+    reset();
+}
+
+void VoiceTap::reset() {
+    m_accumulator = 0;
+    m_noiseLfsr = NOISE_LFSR_INIT;
+    m_envelope = 0.0f;
+    m_envState = EnvelopeState::Release;
+    m_prevGate = false;
+}
+
+void VoiceTap::render(const uint8_t regs[32], int voice, int16_t* out, int samples, double cyclesPerSample, int sampleRate) {
+    const uint8_t* v = regs + voice * 7;
+    uint32_t freq = v[0] | (v[1] << 8);
+    uint32_t pulseWidth = v[2] | ((v[3] & 0x0F) << 8);
+    uint8_t control = v[4];
+    uint8_t attack = v[5] >> 4, decay = v[5] & 0x0F;
+    uint8_t sustain = v[6] >> 4, release = v[6] & 0x0F;
+    float sustainLevel = sustain / 15.0f;
+
+    bool gate = (control & 0x01) != 0;
+    bool test = (control & 0x08) != 0;
+
+    // Front montant de la gate : attaque, front descendant : release
+    if (gate && !m_prevGate) m_envState = EnvelopeState::Attack;
+    else if (!gate && m_prevGate) m_envState = EnvelopeState::Release;
+    m_prevGate = gate;
+
+    // Pas d'enveloppe par échantillon (approximation linéaire des courbes du SID)
+    float samplesPerMs = sampleRate / 1000.0f;
+    float attackStep = 1.0f / (ATTACK_MS[attack] * samplesPerMs);
+    float decayStep = 1.0f / (ATTACK_MS[decay] * 3.0f * samplesPerMs);
+    float releaseStep = 1.0f / (ATTACK_MS[release] * 3.0f * samplesPerMs);
+
+    uint32_t step = static_cast<uint32_t>(freq * cyclesPerSample);
+
+    for (int i = 0; i < samples; ++i) {
+        // Oscillateur
+        if (test) {
+            m_accumulator = 0;
+            m_noiseLfsr = NOISE_LFSR_INIT;
+        } else {
+            uint32_t prev = m_accumulator;
+            m_accumulator = (m_accumulator + step) & ACCUMULATOR_MASK;
+            // Le LFSR avance sur le front montant du bit 19 de l'accumulateur
+            if (!(prev & 0x080000) && (m_accumulator & 0x080000)) {
+                uint32_t bit = ((m_noiseLfsr >> 22) ^ (m_noiseLfsr >> 17)) & 1;
+                m_noiseLfsr = ((m_noiseLfsr << 1) | bit) & 0x7FFFFF;
+            }
+        }
+
+        // Formes d'onde sur 12 bits, combinées par ET logique comme sur le SID
+        uint32_t wave = 0xFFF;
+        bool anyWave = false;
+        if (control & 0x10) {
+            uint32_t tri = (m_accumulator & 0x800000) ? (~m_accumulator & 0x7FFFFF) : (m_accumulator & 0x7FFFFF);
+            wave &= (tri >> 11) & 0xFFF;
+            anyWave = true;
+        }
+        if (control & 0x20) {
+            wave &= m_accumulator >> 12;
+            anyWave = true;
+        }
+        if (control & 0x40) {
+            wave &= ((m_accumulator >> 12) >= pulseWidth) ? 0xFFF : 0x000;
+            anyWave = true;
+        }
+        if (control & 0x80) {
+            wave &= noiseOutput(m_noiseLfsr);
+            anyWave = true;
+        }
+        if (!anyWave) wave = 0x800;
+
+        // Enveloppe
+        switch (m_envState) {
+            case EnvelopeState::Attack:
+                m_envelope += attackStep;
+                if (m_envelope >= 1.0f) { m_envelope = 1.0f; m_envState = EnvelopeState::DecaySustain; }
+                break;
+            case EnvelopeState::DecaySustain:
+                if (m_envelope > sustainLevel) m_envelope = std::max(sustainLevel, m_envelope - decayStep);
+                break;
+            case EnvelopeState::Release:
+                m_envelope = std::max(0.0f, m_envelope - releaseStep);
+                break;
+        }
+
+        // Centrer autour de 0 et mettre à l'échelle int16 (marge pour rester proche du niveau reSIDfp d'une voix)
+        float sample = (static_cast<int>(wave) - 0x800) * 8.0f * m_envelope;
+        out[i] = static_cast<int16_t>(sample);
+    }
+}
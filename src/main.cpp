@@ -1,5 +1,8 @@
 #include "Application.h"
 #include "Logger.h"
+#include "OfflineRenderer.h"
+#include "BatchRenderer.h"
+#include "HeadlessPlayer.h"
 #include <iostream>
 
 #ifdef _WIN32
@@ -12,6 +15,22 @@ int main(int argc, char* argv[]) {
     // Initialiser le logger en premier (avant Application)
     Logger::initialize();
     
+    // Rendu hors ligne et lecture sans sortie son : ni fenêtre SDL ni ImGui
+    if (isOfflineRenderCommand(argc, argv) || isBatchRenderCommand(argc, argv) || isHeadlessPlayCommand(argc, argv)) {
+#ifdef _WIN32
+        // Exécutable WIN32 : rattacher la console parente pour afficher le résultat
+        if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+            freopen("CONOUT$", "w", stdout);
+            freopen("CONOUT$", "w", stderr);
+        }
+#endif
+        int result = isBatchRenderCommand(argc, argv)   ? runBatchRenderCommand(argc, argv)
+                   : isHeadlessPlayCommand(argc, argv) ? runHeadlessPlayCommand(argc, argv)
+                                                       : runOfflineRenderCommand(argc, argv);
+        Logger::shutdown();
+        return result;
+    }
+    
     Application app;
     
     if (!app.initialize()) {
@@ -0,0 +1,15 @@
+#ifndef TEST_REPORT_H
+#define TEST_REPORT_H
+
+#include <iostream>
+#include <string>
+
+// Ligne de résultat des exécutables de test : "✓ nom: PASSED (détail)" ; rend ok
+inline bool report(const std::string& name, bool ok, const std::string& detail = "") {
+    std::cout << (ok ? "✓ " : "✗ ") << name << ": " << (ok ? "PASSED" : "FAILED");
+    if (!detail.empty()) std::cout << " (" << detail << ")";
+    std::cout << "\n";
+    return ok;
+}
+
+#endif // TEST_REPORT_H
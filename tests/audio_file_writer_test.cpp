@@ -0,0 +1,406 @@
+#include "AudioFileWriter.h"
+#include "MD5.h"
+#include "TestReport.h"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Décodeur FLAC de référence du test, écrit d'après la spécification et indépendant de l'encodeur :
+// CRC bit à bit, numéros de trame UTF-8, sous-trames CONSTANT/VERBATIM/FIXED, Rice 4/5 bits et échappement
+namespace {
+    class BitReader {
+    public:
+        BitReader(const std::vector<uint8_t>& data, size_t bytePos) : m_data(data), m_pos(bytePos * 8) {}
+        uint32_t get(int bits) {
+            uint32_t value = 0;
+            for (int i = 0; i < bits; ++i) {
+                if (m_pos >= m_data.size() * 8) { m_ok = false; return 0; }
+                value = (value << 1) | ((m_data[m_pos >> 3] >> (7 - (m_pos & 7))) & 1);
+                ++m_pos;
+            }
+            return value;
+        }
+        int32_t getSigned(int bits) {
+            uint32_t value = get(bits);
+            if (bits > 0 && bits < 32 && (value >> (bits - 1))) value |= ~0u << bits;
+            return static_cast<int32_t>(value);
+        }
+        uint32_t unary() {
+            uint32_t zeros = 0;
+            while (m_ok && get(1) == 0) ++zeros;
+            return zeros;
+        }
+        void align() { m_pos = (m_pos + 7) & ~static_cast<size_t>(7); }
+        void seek(size_t bytePos) { m_pos = bytePos * 8; }
+        size_t bytePos() const { return m_pos >> 3; }
+        bool ok() const { return m_ok; }
+    private:
+        const std::vector<uint8_t>& m_data;
+        size_t m_pos;
+        bool m_ok = true;
+    };
+
+    uint8_t referenceCrc8(const uint8_t* data, size_t size) {
+        uint32_t crc = 0;
+        for (size_t i = 0; i < size; ++i) {
+            crc ^= data[i];
+            for (int b = 0; b < 8; ++b) crc = ((crc << 1) ^ ((crc & 0x80) ? 0x07 : 0)) & 0xFF;
+        }
+        return static_cast<uint8_t>(crc);
+    }
+
+    uint16_t referenceCrc16(const uint8_t* data, size_t size) {
+        uint32_t crc = 0;
+        for (size_t i = 0; i < size; ++i) {
+            crc ^= static_cast<uint32_t>(data[i]) << 8;
+            for (int b = 0; b < 8; ++b) crc = ((crc << 1) ^ ((crc & 0x8000) ? 0x8005 : 0)) & 0xFFFF;
+        }
+        return static_cast<uint16_t>(crc);
+    }
+
+    struct DecodedFlac {
+        int sampleRate = 0;
+        int channels = 0;
+        int bitsPerSample = 0;
+        uint32_t minBlock = 0, maxBlock = 0, minFrameBytes = 0, maxFrameBytes = 0;
+        uint32_t seenMinFrameBytes = 0, seenMaxFrameBytes = 0;
+        uint64_t totalFrames = 0;
+        uint8_t md5[16] = {};
+        std::vector<int16_t> samples;   // Entrelacés
+        int subframeTypes[3] = {};      // CONSTANT, VERBATIM, FIXED
+        int fixedOrders = 0;            // Bit n : prédicteur fixe d'ordre n rencontré
+        int maxFrameNumberBytes = 0;
+        std::string error;
+    };
+
+    bool readResidual(BitReader& bits, int blockSize, int order, std::vector<int32_t>& out) {
+        int method = bits.get(2);
+        if (method > 1) return false;
+        int paramBits = method == 0 ? 4 : 5;
+        uint32_t escape = method == 0 ? 15 : 31;
+        int partitionOrder = bits.get(4);
+        int partitionSize = blockSize >> partitionOrder;
+        if ((partitionSize << partitionOrder) != blockSize || partitionSize < order) return false;
+        for (int part = 0; part < (1 << partitionOrder); ++part) {
+            int count = part == 0 ? partitionSize - order : partitionSize;
+            uint32_t k = bits.get(paramBits);
+            if (k == escape) {
+                int raw = bits.get(5);
+                for (int i = 0; i < count; ++i) out.push_back(bits.getSigned(raw));
+                continue;
+            }
+            for (int i = 0; i < count; ++i) {
+                uint32_t folded = (bits.unary() << k) | bits.get(k);
+                out.push_back(static_cast<int32_t>(folded >> 1) ^ -static_cast<int32_t>(folded & 1));
+            }
+        }
+        return bits.ok();
+    }
+
+    bool readSubframe(BitReader& bits, int blockSize, int bitsPerSample, std::vector<int32_t>& out, DecodedFlac& result) {
+        if (bits.get(1) != 0) return false;
+        int type = bits.get(6);
+        int wasted = bits.get(1) ? static_cast<int>(bits.unary()) + 1 : 0;
+        int sampleBits = bitsPerSample - wasted;
+        out.clear();
+        if (type == 0) {
+            out.assign(blockSize, bits.getSigned(sampleBits));
+            result.subframeTypes[0]++;
+        } else if (type == 1) {
+            for (int i = 0; i < blockSize; ++i) out.push_back(bits.getSigned(sampleBits));
+            result.subframeTypes[1]++;
+        } else if (type >= 8 && type <= 12) {
+            int order = type - 8;
+            for (int i = 0; i < order; ++i) out.push_back(bits.getSigned(sampleBits));
+            if (!readResidual(bits, blockSize, order, out)) return false;
+            static const int COEFS[5][4] = {{0, 0, 0, 0}, {1, 0, 0, 0}, {2, -1, 0, 0}, {3, -3, 1, 0}, {4, -6, 4, -1}};
+            for (int i = order; i < blockSize; ++i) {
+                int64_t prediction = 0;
+                for (int j = 0; j < order; ++j) prediction += static_cast<int64_t>(COEFS[order][j]) * out[i - 1 - j];
+                out[i] += static_cast<int32_t>(prediction);
+            }
+            result.subframeTypes[2]++;
+            result.fixedOrders |= 1 << order;
+        } else {
+            return false; // LPC : jamais produit par l'encodeur
+        }
+        for (auto& sample : out) sample = static_cast<int32_t>(static_cast<uint32_t>(sample) << wasted);
+        return bits.ok() && static_cast<int>(out.size()) == blockSize;
+    }
+
+    bool decodeFlac(const std::string& path, DecodedFlac& result) {
+        std::ifstream file(path, std::ios::binary);
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (data.size() < 42 || std::memcmp(data.data(), "fLaC", 4) != 0) { result.error = "no fLaC marker"; return false; }
+
+        // Métadonnées : STREAMINFO doit être le premier bloc
+        BitReader bits(data, 4);
+        bool last = false;
+        bool first = true;
+        while (!last) {
+            last = bits.get(1);
+            int type = bits.get(7);
+            uint32_t length = bits.get(24);
+            size_t next = bits.bytePos() + length;
+            if (first && (type != 0 || length != 34)) { result.error = "bad STREAMINFO"; return false; }
+            if (type == 0) {
+                result.minBlock = bits.get(16);
+                result.maxBlock = bits.get(16);
+                result.minFrameBytes = bits.get(24);
+                result.maxFrameBytes = bits.get(24);
+                result.sampleRate = bits.get(20);
+                result.channels = bits.get(3) + 1;
+                result.bitsPerSample = bits.get(5) + 1;
+                result.totalFrames = (static_cast<uint64_t>(bits.get(4)) << 32) | bits.get(32);
+                for (auto& byte : result.md5) byte = static_cast<uint8_t>(bits.get(8));
+            }
+            first = false;
+            bits.seek(next);
+        }
+
+        std::vector<std::vector<int32_t>> channels(result.channels);
+        uint64_t expectedNumber = 0;
+        while (bits.bytePos() < data.size()) {
+            size_t start = bits.bytePos();
+            if (bits.get(14) != 0x3FFE || bits.get(1) != 0 || bits.get(1) != 0) { result.error = "bad sync"; return false; }
+            int blockCode = bits.get(4);
+            int rateCode = bits.get(4);
+            int assignment = bits.get(4);
+            int sizeCode = bits.get(3);
+            if (bits.get(1) != 0 || assignment >= 8 || rateCode == 15) { result.error = "bad frame header"; return false; }
+
+            // Numéro de trame "UTF-8"
+            uint32_t lead = bits.get(8);
+            int extra = 0;
+            while (extra < 7 && (lead & (0x80 >> extra))) ++extra;
+            if (extra == 1 || extra > 7) { result.error = "bad frame number"; return false; }
+            uint64_t number = extra == 0 ? lead : (lead & (0x7F >> extra));
+            for (int i = 1; i < extra; ++i) {
+                uint32_t next = bits.get(8);
+                if ((next & 0xC0) != 0x80) { result.error = "bad frame number continuation"; return false; }
+                number = (number << 6) | (next & 0x3F);
+            }
+            result.maxFrameNumberBytes = std::max(result.maxFrameNumberBytes, std::max(extra, 1));
+            if (number != expectedNumber++) { result.error = "frame number " + std::to_string(number); return false; }
+
+            int blockSize = 0;
+            if (blockCode == 1) blockSize = 192;
+            else if (blockCode >= 2 && blockCode <= 5) blockSize = 576 << (blockCode - 2);
+            else if (blockCode == 6) blockSize = bits.get(8) + 1;
+            else if (blockCode == 7) blockSize = bits.get(16) + 1;
+            else if (blockCode >= 8) blockSize = 256 << (blockCode - 8);
+            if (rateCode == 12) bits.get(8);
+            else if (rateCode == 13 || rateCode == 14) bits.get(16);
+            static const int SAMPLE_SIZES[8] = {0, 8, 12, 0, 16, 20, 24, 32};
+            int bitsPerSample = sizeCode == 0 ? result.bitsPerSample : SAMPLE_SIZES[sizeCode];
+
+            size_t headerEnd = bits.bytePos();
+            if (referenceCrc8(data.data() + start, headerEnd - start) != bits.get(8)) { result.error = "CRC-8"; return false; }
+            if (blockSize == 0 || blockSize > static_cast<int>(result.maxBlock) || assignment + 1 != result.channels) {
+                result.error = "bad block size or channel count";
+                return false;
+            }
+
+            for (int c = 0; c < result.channels; ++c) {
+                if (!readSubframe(bits, blockSize, bitsPerSample, channels[c], result)) { result.error = "bad subframe"; return false; }
+            }
+            bits.align();
+            size_t crcPos = bits.bytePos();
+            if (referenceCrc16(data.data() + start, crcPos - start) != bits.get(16)) { result.error = "CRC-16"; return false; }
+
+            uint32_t frameBytes = static_cast<uint32_t>(bits.bytePos() - start);
+            result.seenMinFrameBytes = result.seenMinFrameBytes == 0 ? frameBytes : std::min(result.seenMinFrameBytes, frameBytes);
+            result.seenMaxFrameBytes = std::max(result.seenMaxFrameBytes, frameBytes);
+            for (int i = 0; i < blockSize; ++i) {
+                for (int c = 0; c < result.channels; ++c) result.samples.push_back(static_cast<int16_t>(channels[c][i]));
+            }
+        }
+        return true;
+    }
+
+    void md5Of(const std::vector<int16_t>& samples, uint8_t digest[16]) {
+        imsid::ImSidMD5 md5;
+        for (int16_t sample : samples) {
+            unsigned char bytes[2] = {static_cast<unsigned char>(static_cast<uint16_t>(sample) & 0xFF),
+                                      static_cast<unsigned char>(static_cast<uint16_t>(sample) >> 8)};
+            md5.update(bytes, 2);
+        }
+        md5.finalize();
+        md5.getDigest(digest);
+    }
+
+    // Écriture par morceaux irréguliers : les blocs FLAC ne sont pas alignés sur les appels à write()
+    bool writeFile(const std::string& path, const std::vector<int16_t>& samples, int sampleRate, int channels) {
+        AudioFileFormat format;
+        if (!AudioFileWriter::formatFromPath(path, format)) return false;
+        std::unique_ptr<AudioFileWriter> writer = AudioFileWriter::create(format);
+        if (!writer->open(path, sampleRate, channels)) return false;
+        size_t frames = samples.size() / channels;
+        size_t done = 0;
+        size_t chunk = 777;
+        while (done < frames) {
+            size_t take = std::min(chunk, frames - done);
+            if (!writer->write(samples.data() + done * channels, take)) return false;
+            done += take;
+            chunk = chunk * 3 % 5000 + 1;
+        }
+        return writer->close();
+    }
+
+    uint32_t readLE(const std::vector<uint8_t>& data, size_t pos, int bytes) {
+        uint32_t value = 0;
+        for (int i = bytes - 1; i >= 0; --i) value = (value << 8) | data[pos + i];
+        return value;
+    }
+
+    std::vector<int16_t> makeSignal(const std::string& kind, size_t frames, int channels) {
+        const double pi = 3.14159265358979323846;
+        std::vector<int16_t> samples(frames * channels);
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<int> full(-32768, 32767);
+        std::uniform_int_distribution<int> quiet(-40, 40);
+        for (size_t i = 0; i < frames; ++i) {
+            for (int c = 0; c < channels; ++c) {
+                int16_t& s = samples[i * channels + c];
+                if (kind == "constant") s = static_cast<int16_t>(c == 0 ? -1234 : 32767);
+                else if (kind == "sine") s = static_cast<int16_t>(std::lround(30000.0 * std::sin(2.0 * pi * (440.0 + 110.0 * c) * i / 44100.0)));
+                else if (kind == "noise") s = static_cast<int16_t>(full(rng));
+                else if (kind == "quiet noise") s = static_cast<int16_t>(quiet(rng));
+                else s = 0;
+            }
+        }
+        return samples;
+    }
+}
+
+int main() {
+    int failures = 0;
+    int tests = 0;
+    const fs::path dir = fs::temp_directory_path() / "audio_file_writer_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    std::cout << "=== Audio File Writer Tests ===\n\n";
+
+    // 3 blocs complets + un dernier bloc court
+    const size_t frames = 3 * FlacFileWriter::BLOCK_SIZE + 1000;
+    const int sampleRate = 44100;
+
+    // Test 1-10: FLAC décodé identique à l'entrée (échantillons, MD5, STREAMINFO, CRC, numéros de trame)
+    for (int channels = 1; channels <= 2; ++channels) {
+        for (const std::string kind : {"silence", "constant", "sine", "noise", "quiet noise"}) {
+            tests++;
+            std::vector<int16_t> input = makeSignal(kind, frames, channels);
+            std::string path = (dir / "signal.flac").string();
+            DecodedFlac decoded;
+            bool ok = writeFile(path, input, sampleRate, channels) && decodeFlac(path, decoded);
+            uint8_t inputMd5[16];
+            md5Of(input, inputMd5);
+            ok = ok && decoded.samples == input && std::memcmp(decoded.md5, inputMd5, 16) == 0 &&
+                 decoded.sampleRate == sampleRate && decoded.channels == channels && decoded.bitsPerSample == 16 &&
+                 decoded.totalFrames == frames && decoded.minBlock == FlacFileWriter::BLOCK_SIZE &&
+                 decoded.maxBlock == FlacFileWriter::BLOCK_SIZE &&
+                 decoded.minFrameBytes == decoded.seenMinFrameBytes && decoded.maxFrameBytes == decoded.seenMaxFrameBytes;
+            // Chaque signal passe par le type de sous-trame attendu
+            if (kind == "silence" || kind == "constant") ok = ok && decoded.subframeTypes[0] == 4 * channels;
+            if (kind == "sine" || kind == "quiet noise") ok = ok && decoded.subframeTypes[2] > 0;
+            if (kind == "noise") ok = ok && decoded.subframeTypes[1] > 0;
+            std::string detail = decoded.error.empty() ? std::to_string(fs::file_size(path)) + " bytes" : decoded.error;
+            if (!report("FLAC " + kind + (channels == 1 ? " mono" : " stereo"), ok, detail)) failures++;
+        }
+    }
+
+    // Test 11: un bloc court par ordre de prédicteur fixe (le moins coûteux est choisi)
+    tests++;
+    {
+        std::mt19937 rng(99);
+        std::uniform_int_distribution<int> step(-3, 3);
+        bool ok = true;
+        std::string detail;
+        for (int order = 1; order <= 4 && ok; ++order) {
+            // Marche aléatoire (ordre 1), puis polynômes exacts de degré 1 à 3 (résidus nuls à l'ordre degré+1)
+            int length = order == 4 ? 30 : 100;
+            std::vector<int16_t> input(length);
+            int walk = 0;
+            for (int i = 0; i < length; ++i) {
+                walk += step(rng);
+                int value = order == 1 ? walk : order == 2 ? 7 * i - 300 : order == 3 ? i * i - 5000 : i * i * i - 10000;
+                input[i] = static_cast<int16_t>(value);
+            }
+            std::string path = (dir / "order.flac").string();
+            DecodedFlac decoded;
+            ok = writeFile(path, input, sampleRate, 1) && decodeFlac(path, decoded) && decoded.samples == input &&
+                 decoded.fixedOrders == (1 << order);
+            detail = decoded.error.empty() ? "order " + std::to_string(order) : decoded.error;
+        }
+        if (!report("FLAC fixed predictor orders", ok, detail)) failures++;
+    }
+
+    // Test 12: plus de 2048 trames, numéros de trame sur 1, 2 et 3 octets
+    tests++;
+    {
+        const size_t longFrames = 2100 * static_cast<size_t>(FlacFileWriter::BLOCK_SIZE) + 17;
+        std::vector<int16_t> input(longFrames, 0);
+        for (size_t i = 0; i < longFrames; i += FlacFileWriter::BLOCK_SIZE) input[i] = static_cast<int16_t>(i / FlacFileWriter::BLOCK_SIZE);
+        std::string path = (dir / "long.flac").string();
+        DecodedFlac decoded;
+        bool ok = writeFile(path, input, 8000, 1) && decodeFlac(path, decoded);
+        uint8_t inputMd5[16];
+        md5Of(input, inputMd5);
+        ok = ok && decoded.samples == input && std::memcmp(decoded.md5, inputMd5, 16) == 0 &&
+             decoded.totalFrames == longFrames && decoded.maxFrameNumberBytes == 3;
+        if (!report("FLAC frame numbers", ok, decoded.error)) failures++;
+    }
+
+    // Test 13: en-tête WAV (tailles RIFF/data, format) et échantillons little-endian
+    tests++;
+    {
+        std::vector<int16_t> input = makeSignal("sine", frames, 2);
+        std::string path = (dir / "signal.wav").string();
+        bool ok = writeFile(path, input, 48000, 2);
+        std::ifstream file(path, std::ios::binary);
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        uint32_t dataBytes = static_cast<uint32_t>(input.size() * 2);
+        ok = ok && data.size() == 44 + dataBytes && std::memcmp(data.data(), "RIFF", 4) == 0 &&
+             readLE(data, 4, 4) == 36 + dataBytes && std::memcmp(data.data() + 8, "WAVEfmt ", 8) == 0 &&
+             readLE(data, 16, 4) == 16 && readLE(data, 20, 2) == 1 && readLE(data, 22, 2) == 2 &&
+             readLE(data, 24, 4) == 48000 && readLE(data, 28, 4) == 48000 * 4 && readLE(data, 32, 2) == 4 &&
+             readLE(data, 34, 2) == 16 && std::memcmp(data.data() + 36, "data", 4) == 0 && readLE(data, 40, 4) == dataBytes;
+        for (size_t i = 0; ok && i < input.size(); ++i) {
+            ok = static_cast<int16_t>(readLE(data, 44 + i * 2, 2)) == input[i];
+        }
+        if (!report("WAV header and samples", ok)) failures++;
+    }
+
+    // Test 14: flux brut sans en-tête, format déduit de l'extension
+    tests++;
+    {
+        std::vector<int16_t> input = makeSignal("noise", 5000, 1);
+        std::string path = (dir / "signal.raw").string();
+        AudioFileFormat format = AudioFileFormat::Wav;
+        bool ok = AudioFileWriter::formatFromPath("A.PCM", format) && format == AudioFileFormat::Raw &&
+                  !AudioFileWriter::formatFromPath("a.mp3", format) && writeFile(path, input, 44100, 1);
+        std::ifstream file(path, std::ios::binary);
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        ok = ok && data.size() == input.size() * 2;
+        for (size_t i = 0; ok && i < input.size(); ++i) {
+            ok = static_cast<int16_t>(readLE(data, i * 2, 2)) == input[i];
+        }
+        if (!report("Raw samples", ok)) failures++;
+    }
+
+    fs::remove_all(dir);
+
+    std::cout << "\n=== Test Results ===\n";
+    std::cout << "Tests run: " << tests << "\n";
+    std::cout << "Passed: " << (tests - failures) << "\n";
+    std::cout << "Failed: " << failures << "\n";
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+#include "AudioKernels.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include <algorithm>
+
+using namespace imsid::audio;
+
+// Buffers aléatoires couvrant toute la plage int16 (y compris les extrêmes pour la saturation)
+static std::vector<int16_t> randomBuffer(std::mt19937& rng, int count) {
+    std::uniform_int_distribution<int> dist(-32768, 32767);
+    std::vector<int16_t> buf(count);
+    for (int i = 0; i < count; ++i) buf[i] = static_cast<int16_t>(dist(rng));
+    if (count > 2) { buf[0] = 32767; buf[1] = -32768; }
+    return buf;
+}
+
+// Compare un chemin vectorisé à la référence scalaire sur plusieurs tailles (queues incluses)
+static int testPath(KernelPath path, int& tests) {
+    int failures = 0;
+    const char* name = kernelPathName(path);
+    if (!setKernelPath(path)) {
+        std::cout << "- " << name << ": not supported on this CPU, skipped\n";
+        return 0;
+    }
+
+    std::mt19937 rng(1234);
+    const int sizes[] = {0, 1, 7, 8, 15, 16, 17, 255, 256, 512, 1031, 4096};
+
+    // Test 1: somme saturée de 3 voix (doit être identique bit à bit)
+    tests++;
+    bool ok = true;
+    for (int n : sizes) {
+        auto a = randomBuffer(rng, n), b = randomBuffer(rng, n), c = randomBuffer(rng, n);
+        std::vector<int16_t> ref(n), out(n);
+        scalar::mixSaturate3(a.data(), b.data(), c.data(), ref.data(), n);
+        mixSaturate3(a.data(), b.data(), c.data(), out.data(), n);
+        if (ref != out) {
+            ok = false;
+            std::cout << "  mixSaturate3 mismatch at size " << n << "\n";
+            break;
+        }
+    }
+    std::cout << (ok ? "✓ " : "✗ ") << name << " mixSaturate3: " << (ok ? "PASSED" : "FAILED") << "\n";
+    if (!ok) failures++;
+
+    // Test 2: rampe de gain (tolérance d'1 LSB : contraction FMA possible selon le compilateur)
+    tests++;
+    ok = true;
+    for (int n : sizes) {
+        auto buf = randomBuffer(rng, n);
+        std::vector<int16_t> ref = buf, out = buf;
+        // Gain dans [0, 1] sur toute la rampe (comme le fade-in du lecteur)
+        float start = 37.0f / 2000.0f;
+        float step = (1.0f - start) / std::max(n, 1);
+        scalar::applyGainRamp(ref.data(), n, start, step);
+        applyGainRamp(out.data(), n, start, step);
+        for (int i = 0; i < n; ++i) {
+            if (std::abs(ref[i] - out[i]) > 1) {
+                ok = false;
+                std::cout << "  applyGainRamp mismatch at size " << n << " index " << i
+                          << ": " << ref[i] << " vs " << out[i] << "\n";
+                break;
+            }
+        }
+        if (!ok) break;
+    }
+    std::cout << (ok ? "✓ " : "✗ ") << name << " applyGainRamp: " << (ok ? "PASSED" : "FAILED") << "\n";
+    if (!ok) failures++;
+
+    // Test 2b: gain d'amplification (normalisation du volume) : saturation au lieu du repliement
+    tests++;
+    ok = true;
+    for (int n : sizes) {
+        auto buf = randomBuffer(rng, n);
+        std::vector<int16_t> ref = buf, out = buf;
+        scalar::applyGainRamp(ref.data(), n, 1.5f, 0.0f);
+        applyGainRamp(out.data(), n, 1.5f, 0.0f);
+        for (int i = 0; i < n; ++i) {
+            bool sameSign = (buf[i] >= 0) == (ref[i] >= 0) || ref[i] == 0;
+            if (std::abs(ref[i] - out[i]) > 1 || !sameSign) {
+                ok = false;
+                std::cout << "  applyGainRamp (boost) mismatch at size " << n << " index " << i
+                          << ": " << ref[i] << " vs " << out[i] << "\n";
+                break;
+            }
+        }
+        if (!ok) break;
+    }
+    std::cout << (ok ? "✓ " : "✗ ") << name << " applyGainRamp boost: " << (ok ? "PASSED" : "FAILED") << "\n";
+    if (!ok) failures++;
+
+    // Test 3: conversion int16 -> float (exacte : division par une puissance de 2)
+    tests++;
+    ok = true;
+    for (int n : sizes) {
+        auto in = randomBuffer(rng, n);
+        std::vector<float> ref(n), out(n);
+        scalar::int16ToFloat(in.data(), ref.data(), n);
+        int16ToFloat(in.data(), out.data(), n);
+        if (ref != out) {
+            ok = false;
+            std::cout << "  int16ToFloat mismatch at size " << n << "\n";
+            break;
+        }
+    }
+    std::cout << (ok ? "✓ " : "✗ ") << name << " int16ToFloat: " << (ok ? "PASSED" : "FAILED") << "\n";
+    if (!ok) failures++;
+
+    // Test 4: produit scalaire (ordre des additions propre à chaque chemin : tolérance relative)
+    tests++;
+    ok = true;
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    for (int n : sizes) {
+        std::vector<float> a(n), b(n);
+        float magnitude = 0.0f;
+        for (int i = 0; i < n; ++i) { a[i] = unit(rng); b[i] = unit(rng); magnitude += std::abs(a[i] * b[i]); }
+        float ref = scalar::dotProduct(a.data(), b.data(), n);
+        float out = dotProduct(a.data(), b.data(), n);
+        if (std::abs(ref - out) > 1e-5f * std::max(magnitude, 1.0f)) {
+            ok = false;
+            std::cout << "  dotProduct mismatch at size " << n << ": " << out << " vs " << ref << "\n";
+            break;
+        }
+    }
+    std::cout << (ok ? "✓ " : "✗ ") << name << " dotProduct: " << (ok ? "PASSED" : "FAILED") << "\n";
+    if (!ok) failures++;
+
+    return failures;
+}
+
+int main() {
+    int failures = 0;
+    int tests = 0;
+
+    std::cout << "=== Audio Kernels Tests ===\n\n";
+    std::cout << "Detected path: " << kernelPathName(getKernelPath()) << "\n\n";
+
+    const KernelPath paths[] = {KernelPath::Scalar, KernelPath::SSE2, KernelPath::AVX2, KernelPath::NEON};
+    for (KernelPath path : paths) {
+        failures += testPath(path, tests);
+    }
+
+    // Valeurs connues : saturation dans les deux sens, sans saturation intermédiaire
+    tests++;
+    setKernelPath(KernelPath::Scalar);
+    int16_t a[3] = {30000, -30000, 30000};
+    int16_t b[3] = {30000, -30000, 30000};
+    int16_t c[3] = {-30000, -30000, 10};
+    int16_t out[3];
+    mixSaturate3(a, b, c, out, 3);
+    if (out[0] == 30000 && out[1] == -32768 && out[2] == 32767) {
+        std::cout << "✓ Known values (saturation): PASSED\n";
+    } else {
+        std::cout << "✗ Known values (saturation): FAILED\n";
+        std::cout << "  Got: " << out[0] << ", " << out[1] << ", " << out[2] << "\n";
+        failures++;
+    }
+
+    std::cout << "\n=== Test Results ===\n";
+    std::cout << "Tests run: " << tests << "\n";
+    std::cout << "Passed: " << (tests - failures) << "\n";
+    std::cout << "Failed: " << failures << "\n";
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+#include "AudioTimingStats.h"
+#include "TestReport.h"
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+int main() {
+    int failures = 0;
+    int tests = 0;
+
+    std::cout << "=== Audio Timing Stats Tests ===\n\n";
+
+    // Test 1: seaux contigus et croissants, chaque borne basse retombe dans son propre seau
+    tests++;
+    {
+        bool ok = true;
+        for (int b = 0; b + 1 < AudioTimingStats::BUCKETS; ++b) {
+            int64_t low = AudioTimingStats::bucketLowerUs(b);
+            int64_t high = AudioTimingStats::bucketLowerUs(b + 1);
+            if (high <= low || AudioTimingStats::bucketIndex(low) != b || AudioTimingStats::bucketIndex(high - 1) != b) ok = false;
+        }
+        ok = ok && AudioTimingStats::bucketIndex(-5) == 0;
+        ok = ok && AudioTimingStats::bucketIndex(int64_t(1) << 40) == AudioTimingStats::BUCKETS - 1;
+        if (!report("Bucket boundaries", ok)) failures++;
+    }
+
+    // Test 2: moyenne, maximum et percentiles (borne haute du seau, plafonnée au maximum)
+    tests++;
+    {
+        AudioTimingStats stats;
+        for (int i = 0; i < 99; ++i) stats.record(AudioTimingStats::STAGE_MASTER, 100000); // 100 µs
+        stats.record(AudioTimingStats::STAGE_MASTER, 5000000);                            // 5 ms
+        AudioTimingStats::Summary summary = stats.getSummary(AudioTimingStats::STAGE_MASTER);
+        int64_t p50Upper = AudioTimingStats::bucketLowerUs(AudioTimingStats::bucketIndex(100) + 1);
+        bool ok = summary.count == 100 && std::abs(summary.meanUs - 149.0) < 1e-6 && summary.maxUs == 5000.0 &&
+                  summary.p50Us == static_cast<double>(p50Upper) && summary.p99Us == static_cast<double>(p50Upper);
+        std::ostringstream detail;
+        detail << "mean " << summary.meanUs << ", p50 " << summary.p50Us << ", p99 " << summary.p99Us << ", max " << summary.maxUs;
+        if (!report("Summary", ok, detail.str())) failures++;
+    }
+
+    // Test 3: dépassements de budget (blocs trop lents, callbacks en retard) et remise à zéro
+    tests++;
+    {
+        AudioTimingStats stats;
+        stats.setBudgets(5000000, 2000000);
+        stats.record(AudioTimingStats::STAGE_BLOCK, 1000000);
+        stats.record(AudioTimingStats::STAGE_BLOCK, 3000000);        // Dépassement
+        stats.recordCallback(10000, 5000000);                       // À l'heure
+        stats.recordCallback(10000, 8000000);                       // Intervalle > 1,5 période
+        stats.recordCallback(6000000, 0);                           // Callback plus long que la période
+        stats.countUnderrun();
+        bool ok = stats.getOverruns() == 1 && stats.getLateCallbacks() == 2 && stats.getUnderruns() == 1;
+        stats.reset();
+        ok = ok && stats.getOverruns() == 0 && stats.getLateCallbacks() == 0 && stats.getUnderruns() == 0 &&
+             stats.getSummary(AudioTimingStats::STAGE_BLOCK).count == 0;
+        if (!report("Budgets and counters", ok)) failures++;
+    }
+
+    // Test 4: rapport ajouté en fin de fichier (deux rapports successifs)
+    tests++;
+    {
+        std::string path = "audio_timing_stats_test.txt";
+        std::remove(path.c_str());
+        AudioTimingStats stats;
+        stats.record(AudioTimingStats::STAGE_RESAMPLE, 12000);
+        bool ok = stats.appendReport(path, "first") && stats.appendReport(path, "second");
+        std::ifstream file(path);
+        std::stringstream content;
+        content << file.rdbuf();
+        std::string text = content.str();
+        ok = ok && text.find("first") != std::string::npos && text.find("second") != std::string::npos &&
+             text.find("Resample") != std::string::npos && text.find("Master") == std::string::npos;
+        file.close();
+        std::remove(path.c_str());
+        if (!report("Append report", ok)) failures++;
+    }
+
+    std::cout << "\n=== Test Results ===\n";
+    std::cout << "Tests run: " << tests << "\n";
+    std::cout << "Passed: " << (tests - failures) << "\n";
+    std::cout << "Failed: " << failures << "\n";
+
+    return (failures == 0) ? 0 : 1;
+}
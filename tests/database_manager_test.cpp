@@ -0,0 +1,91 @@
+#include "DatabaseManager.h"
+#include "TestReport.h"
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+// Métadonnées préparées comme par le pipeline d'indexation (pas de lecture libsidplayfp)
+static SidMetadata prepared(const fs::path& path, uint32_t metadataHash) {
+    std::ofstream(path, std::ios::binary) << "PSID " << metadataHash;
+    SidMetadata metadata;
+    metadata.filepath = path.string();
+    metadata.filename = path.filename().string();
+    metadata.title = path.stem().string();
+    metadata.numberOfSongs = 2;
+    metadata.metadataHash = metadataHash;
+    metadata.md5Hash = "md5-" + std::to_string(metadataHash);
+    SidMetadata::statFile(metadata.filepath, metadata.fileSize, metadata.lastModified);
+    return metadata;
+}
+
+static const SidMetadata* findStored(const DatabaseManager& db, const std::string& rootFolder, const std::string& filename) {
+    for (const auto& rootEntry : db.getRootFolders()) {
+        if (rootEntry.rootFolder != rootFolder) continue;
+        for (const auto& meta : rootEntry.sidList) {
+            if (meta.filename == filename) return &meta;
+        }
+    }
+    return nullptr;
+}
+
+int main() {
+    int failures = 0;
+    int tests = 0;
+    const fs::path dir = fs::temp_directory_path() / "database_manager_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "A");
+    fs::create_directories(dir / "B");
+#ifndef _WIN32
+    setenv("HOME", dir.string().c_str(), 1); // Configuration de test : ne jamais toucher à la base de l'utilisateur
+#endif
+
+    std::cout << "=== Database Manager Tests ===\n\n";
+
+    DatabaseManager db;
+    uint32_t nextHash = 1;
+    auto index = [&](const std::string& root, const std::string& name) {
+        fs::path path = dir / root / name;
+        return db.indexMetadata(path.string(), root, prepared(path, nextHash++));
+    };
+
+    // Test 1: racines A=[a1,a2] puis B=[b1], a3 ajouté ensuite à A (en fin de cache, pas en fin de A)
+    tests++;
+    {
+        bool ok = index("A", "a1.sid") && index("A", "a2.sid") && index("B", "b1.sid") && index("A", "a3.sid");
+        const SidMetadata* a3 = findStored(db, "A", "a3.sid");
+        ok = ok && db.getRootFolders().size() == 2 && a3 && a3->filepath == "a3.sid" && db.getCount() == 4;
+        if (!report("Index into an earlier root", ok)) failures++;
+    }
+
+    // Test 2: la sonie d'a3 est persistée sur a3, pas sur l'entrée à la même position du cache (b1)
+    tests++;
+    {
+        const std::string a3Path = (dir / "A" / "a3.sid").string();
+        bool ok = db.setLoudness(a3Path, 1, -21.5f);
+        const SidMetadata* a3 = findStored(db, "A", "a3.sid");
+        const SidMetadata* b1 = findStored(db, "B", "b1.sid");
+        const SidMetadata* cached = db.getMetadata(a3Path);
+        ok = ok && a3 && a3->loudness.size() == 2 && a3->loudness[1] == -21.5f && a3->loudness[0] == 0.0f &&
+             b1 && b1->loudness.empty() && cached && cached->loudness.size() == 2 && cached->loudness[1] == -21.5f;
+        if (!report("Loudness stored on the right tune", ok)) failures++;
+    }
+
+    // Test 3: fichier inconnu ou subsong négatif refusés sans rien modifier
+    tests++;
+    {
+        bool ok = !db.setLoudness((dir / "A" / "unknown.sid").string(), 0, -20.0f) &&
+                  !db.setLoudness((dir / "B" / "b1.sid").string(), -1, -20.0f);
+        const SidMetadata* b1 = findStored(db, "B", "b1.sid");
+        ok = ok && b1 && b1->loudness.empty();
+        if (!report("Rejected loudness updates", ok)) failures++;
+    }
+
+    fs::remove_all(dir);
+
+    std::cout << "\n=== Test Results ===\n";
+    std::cout << "Tests run: " << tests << "\n";
+    std::cout << "Passed: " << (tests - failures) << "\n";
+    std::cout << "Failed: " << failures << "\n";
+
+    return (failures == 0) ? 0 : 1;
+}
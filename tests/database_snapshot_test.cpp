@@ -0,0 +1,194 @@
+#include "DatabaseSnapshot.h"
+#include "DatabaseManager.h"
+#include "TestReport.h"
+#include <iostream>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+static SidMetadata makeMeta(const std::string& filepath, const std::string& title, uint32_t hash) {
+    SidMetadata meta;
+    meta.filepath = filepath;
+    meta.filename = filepath.substr(filepath.find_last_of('/') + 1);
+    meta.title = title;
+    meta.author = "Rob Hubbard";
+    meta.released = "1985 Gremlin Graphics";
+    meta.sidModel = "6581";
+    meta.numberOfSongs = 3;
+    meta.defaultSong = 2;
+    meta.clockSpeed = 1;
+    meta.infoStrings = {title, "Rob Hubbard", "1985 Gremlin Graphics"};
+    meta.metadataHash = hash;
+    meta.md5Hash = "0123456789abcdef0123456789abcdef";
+    meta.fileSize = 4096 + hash % 100;
+    meta.lastModified = 1700000000 + hash;
+    meta.hvscNum = 84;
+    meta.songLengths = {181.5, 42.0, 7.25};
+    meta.loudness = {-17.5f, 0.0f, -20.25f};
+    return meta;
+}
+
+static bool sameMeta(const SidMetadata& a, const SidMetadata& b) {
+    return a.filepath == b.filepath && a.filename == b.filename && a.title == b.title && a.author == b.author &&
+           a.released == b.released && a.sidModel == b.sidModel && a.numberOfSongs == b.numberOfSongs &&
+           a.defaultSong == b.defaultSong && a.clockSpeed == b.clockSpeed && a.infoStrings == b.infoStrings &&
+           a.metadataHash == b.metadataHash && a.md5Hash == b.md5Hash && a.fileSize == b.fileSize &&
+           a.lastModified == b.lastModified && a.hvscNum == b.hvscNum && a.rootFolder == b.rootFolder &&
+           a.songLengths == b.songLengths && a.loudness == b.loudness;
+}
+
+int main() {
+    int failures = 0;
+    int tests = 0;
+    const std::string path = "database_snapshot_test.bin";
+
+    std::cout << "=== Database Snapshot Tests ===\n\n";
+
+    // Structure persistée : chemins relatifs à rootPath, un chemin absolu (ancien format), un dossier sans rootPath
+    std::vector<RootFolderEntry> roots(3);
+    roots[0].rootPath = "/music/HVSC";
+    roots[0].rootFolder = "HVSC";
+    roots[0].sidList.push_back(makeMeta("MUSICIANS/H/Hubbard_Rob/Commando.sid", "Commando", 1001));
+    roots[0].sidList.push_back(makeMeta("MUSICIANS/H/Hubbard_Rob/Monty_on_the_Run.sid", "Monty on the Run", 1002));
+    roots[0].sidList.push_back(makeMeta("/elsewhere/Delta.sid", "Delta", 1003));
+    roots[1].rootPath = "/music/Demos";
+    roots[1].rootFolder = "Demos";
+    roots[1].sidList.push_back(makeMeta("Commando_copy.sid", "Commando", 1001));   // Même morceau, autre dossier
+    roots[2].rootFolder = "";
+    roots[2].sidList.push_back(makeMeta("/tmp/Loose.sid", "Loose", 0));             // Sans metadataHash
+    roots[2].sidList.back().infoStrings.clear();
+    roots[2].sidList.back().loudness.clear();
+
+    // Cache attendu : mêmes règles que DatabaseManager::rebuildCacheAndIndexes
+    std::vector<SidMetadata> expectedCache;
+    for (const auto& root : roots) {
+        for (const auto& meta : root.sidList) {
+            SidMetadata full = meta;
+            if (!root.rootPath.empty() && !meta.filepath.empty() && meta.filepath[0] != '/') {
+                full.filepath = root.rootPath + "/" + meta.filepath;
+            }
+            full.rootFolder = root.rootFolder;
+            expectedCache.push_back(full);
+        }
+    }
+
+    std::remove(path.c_str());
+    std::string error;
+    bool written = DatabaseSnapshot::write(path, roots, 123456, 987654321, error);
+
+    // Test 1: aller-retour complet (structure persistée et cache à chemins absolus)
+    tests++;
+    {
+        DatabaseSnapshot snapshot;
+        std::vector<RootFolderEntry> loadedRoots;
+        std::vector<SidMetadata> cache;
+        bool ok = written && snapshot.open(path) &&
+                  snapshot.materializeRoots(loadedRoots) && snapshot.materializeCache(cache);
+        ok = ok && snapshot.getRootCount() == 3 && snapshot.getRecordCount() == 5 &&
+             snapshot.getJsonSize() == 123456 && snapshot.getJsonMtime() == 987654321;
+        ok = ok && loadedRoots.size() == roots.size() && cache.size() == expectedCache.size();
+        for (size_t r = 0; ok && r < roots.size(); ++r) {
+            ok = loadedRoots[r].rootPath == roots[r].rootPath && loadedRoots[r].rootFolder == roots[r].rootFolder &&
+                 loadedRoots[r].sidList.size() == roots[r].sidList.size();
+            for (size_t i = 0; ok && i < roots[r].sidList.size(); ++i) ok = sameMeta(loadedRoots[r].sidList[i], roots[r].sidList[i]);
+        }
+        for (size_t i = 0; ok && i < cache.size(); ++i) ok = sameMeta(cache[i], expectedCache[i]);
+        if (!report("Round trip", ok, written ? snapshot.getLastError() : error)) failures++;
+    }
+
+    // Test 2: index prébâtis (chemin absolu, metadataHash avec la dernière occurrence gagnante)
+    tests++;
+    {
+        DatabaseSnapshot snapshot;
+        bool ok = snapshot.open(path);
+        for (size_t i = 0; ok && i < expectedCache.size(); ++i) {
+            ok = snapshot.findPath(expectedCache[i].filepath) == static_cast<int64_t>(i);
+        }
+        ok = ok && snapshot.findPath("/music/HVSC/missing.sid") == -1 && snapshot.findPath("") == -1;
+        ok = ok && snapshot.findPath("MUSICIANS/H/Hubbard_Rob/Commando.sid") == -1; // Clé = chemin absolu
+        ok = ok && snapshot.findHash(1001) == 3 && snapshot.findHash(1002) == 1 && snapshot.findHash(1003) == 2;
+        ok = ok && snapshot.findHash(0) == -1 && snapshot.findHash(4242) == -1;
+        std::vector<uint32_t> hashes = snapshot.getMetadataHashes();
+        ok = ok && std::set<uint32_t>(hashes.begin(), hashes.end()) == std::set<uint32_t>{1001, 1002, 1003};
+        if (!report("Prebuilt indexes", ok)) failures++;
+    }
+
+    // Test 3: base vide et grand volume (index sans collision perdue)
+    tests++;
+    {
+        std::vector<RootFolderEntry> big(1);
+        big[0].rootPath = "/hvsc";
+        big[0].rootFolder = "HVSC";
+        for (uint32_t i = 0; i < 20000; ++i) {
+            SidMetadata meta;
+            meta.filepath = "DEMOS/" + std::to_string(i % 37) + "/tune_" + std::to_string(i) + ".sid";
+            meta.title = "Tune " + std::to_string(i);
+            meta.author = "Author " + std::to_string(i % 50);
+            meta.metadataHash = 0x9E3779B1u * (i + 1);
+            big[0].sidList.push_back(meta);
+        }
+        DatabaseSnapshot snapshot;
+        bool ok = DatabaseSnapshot::write(path, big, 0, 0, error) && snapshot.open(path);
+        for (uint32_t i = 0; ok && i < 20000; ++i) {
+            ok = snapshot.findPath("/hvsc/" + big[0].sidList[i].filepath) == i &&
+                 snapshot.findHash(big[0].sidList[i].metadataHash) == i;
+        }
+        snapshot.close();
+        std::vector<RootFolderEntry> loadedRoots;
+        std::vector<SidMetadata> cache;
+        ok = ok && DatabaseSnapshot::write(path, {}, 0, 0, error) && snapshot.open(path) &&
+             snapshot.materializeRoots(loadedRoots) && snapshot.materializeCache(cache) && loadedRoots.empty() && cache.empty() &&
+             snapshot.findPath("/hvsc/x.sid") == -1 && snapshot.findHash(1) == -1;
+        if (!report("Empty and large databases", ok)) failures++;
+    }
+
+    // Test 4: fichiers refusés (absent, tronqué, version inconnue)
+    tests++;
+    {
+        bool ok = DatabaseSnapshot::write(path, roots, 0, 0, error);
+        std::string content;
+        {
+            std::ifstream in(path, std::ios::binary);
+            content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        DatabaseSnapshot snapshot;
+        ok = ok && !snapshot.open("database_snapshot_missing.bin") && !snapshot.isOpen();
+
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(content.data(), static_cast<std::streamsize>(content.size() - 16));
+        }
+        ok = ok && !snapshot.open(path) && !snapshot.getLastError().empty();
+
+        std::string bumped = content;
+        bumped[8] = static_cast<char>(DatabaseSnapshot::VERSION + 1); // Version (après le magic)
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(bumped.data(), static_cast<std::streamsize>(bumped.size()));
+        }
+        ok = ok && !snapshot.open(path);
+        std::string detail = snapshot.getLastError();
+
+        // Table de chaînes réduite à 1 octet (champ stringsSize de l'en-tête) : références hors bornes
+        std::string shrunk = content;
+        uint64_t tinyStrings = 1;
+        shrunk.replace(72, sizeof(tinyStrings), reinterpret_cast<const char*>(&tinyStrings), sizeof(tinyStrings));
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(shrunk.data(), static_cast<std::streamsize>(shrunk.size()));
+        }
+        ok = ok && !snapshot.open(path) && !snapshot.isOpen();
+        detail += ", " + snapshot.getLastError();
+        if (!report("Rejected files", ok, detail)) failures++;
+    }
+    std::remove(path.c_str());
+
+    std::cout << "\n=== Test Results ===\n";
+    std::cout << "Tests run: " << tests << "\n";
+    std::cout << "Passed: " << (tests - failures) << "\n";
+    std::cout << "Failed: " << failures << "\n";
+
+    return (failures == 0) ? 0 : 1;
+}
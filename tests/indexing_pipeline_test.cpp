@@ -0,0 +1,134 @@
+#include "IndexingPipeline.h"
+#include "Utils.h"
+#include "TestReport.h"
+#include <iostream>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Extraction factice : pas de libsidplayfp, le contenu commence par "SID" sinon le fichier est refusé
+static bool fakeExtract(const std::string& filepath, const uint8_t* data, size_t size, SidMetadata& metadata) {
+    if (size < 3 || data[0] != 'S' || data[1] != 'I' || data[2] != 'D') return false;
+    metadata.filepath = filepath;
+    metadata.title = std::string(reinterpret_cast<const char*>(data), size);
+    metadata.fileSize = static_cast<int64_t>(size);
+    metadata.metadataHash = static_cast<uint32_t>(size);
+    return true;
+}
+
+int main() {
+    int failures = 0;
+    int tests = 0;
+    const fs::path dir = fs::temp_directory_path() / "indexing_pipeline_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    std::cout << "=== Indexing Pipeline Tests ===\n\n";
+
+    const int fileCount = 500;
+    std::vector<IndexingPipeline::Job> jobs;
+    for (int i = 0; i < fileCount; ++i) {
+        std::string path = (dir / ("tune_" + std::to_string(i) + ".sid")).string();
+        std::ofstream(path, std::ios::binary) << (i % 50 == 7 ? "PSX" : "SID") << " tune " << i;
+        jobs.push_back({path, "Root"});
+    }
+    jobs.push_back({(dir / "missing.sid").string(), "Root"});
+
+    IndexingPipeline::Stats fullRun;
+
+    // Test 1: chaque fichier lu une fois, analysé et haché, validé sur le thread appelant uniquement
+    tests++;
+    {
+        IndexingPipeline pipeline(4, 16);
+        pipeline.setExtractor(fakeExtract);
+        std::set<std::string> seen;
+        bool sameThread = true;
+        bool md5Ok = true;
+        const auto caller = std::this_thread::get_id();
+        size_t lastDone = 0;
+        size_t changed = pipeline.run(jobs,
+            [&](IndexingPipeline::Result& result) {
+                sameThread = sameThread && std::this_thread::get_id() == caller;
+                const std::string& title = result.metadata.title;
+                md5Ok = md5Ok && result.metadata.md5Hash ==
+                        calculateDataMD5(reinterpret_cast<const uint8_t*>(title.data()), title.size());
+                seen.insert(result.job.filepath);
+                return true;
+            },
+            [&](const std::string&, size_t done, size_t) { lastDone = done; });
+        IndexingPipeline::Stats stats = pipeline.getStats();
+        fullRun = stats;
+        const size_t invalid = fileCount / 50;
+        bool ok = changed == fileCount - invalid && seen.size() == changed && sameThread && md5Ok &&
+                  stats.committed == changed && stats.failed == invalid && stats.missing == 1 && stats.skipped == 0 &&
+                  stats.stages[IndexingPipeline::STAGE_WALK].items == jobs.size() &&
+                  stats.stages[IndexingPipeline::STAGE_READ].items == fileCount &&
+                  stats.stages[IndexingPipeline::STAGE_HASH].items == changed &&
+                  stats.stages[IndexingPipeline::STAGE_READ].bytes > 0 && lastDone == jobs.size() && !stats.cancelled;
+        if (!report("Full run", ok, std::to_string(changed) + " committed")) failures++;
+    }
+
+    // Test 2: fichiers connus et inchangés écartés sans être lus, fichier modifié relu avec sa nouvelle date
+    tests++;
+    {
+        std::unordered_map<std::string, IndexingPipeline::FileStamp> known;
+        for (int i = 0; i < fileCount; ++i) {
+            IndexingPipeline::FileStamp stamp;
+            SidMetadata::statFile(jobs[i].filepath, stamp.fileSize, stamp.lastModified);
+            known[jobs[i].filepath] = stamp;
+        }
+        // Même unité que l'estampille historique (fs::last_write_time)
+        bool sameUnit = known[jobs[1].filepath].lastModified == std::chrono::duration_cast<std::chrono::seconds>(
+            fs::last_write_time(jobs[1].filepath).time_since_epoch()).count();
+        known[jobs[0].filepath].lastModified -= 10; // "Modifié"
+
+        IndexingPipeline pipeline(3, 8);
+        pipeline.setExtractor(fakeExtract);
+        pipeline.setKnownFiles(known);
+        std::vector<SidMetadata> committed;
+        pipeline.run(jobs, [&](IndexingPipeline::Result& result) { committed.push_back(result.metadata); return true; });
+        IndexingPipeline::Stats stats = pipeline.getStats();
+        bool ok = sameUnit && stats.skipped == fileCount - 1 && stats.missing == 1 &&
+                  stats.stages[IndexingPipeline::STAGE_READ].items == 1 && committed.size() == 1 &&
+                  committed[0].filepath == jobs[0].filepath &&
+                  committed[0].lastModified == known[jobs[0].filepath].lastModified + 10 &&
+                  committed[0].fileSize == static_cast<int64_t>(fs::file_size(jobs[0].filepath));
+        if (!report("Known files", ok, std::to_string(stats.skipped) + " skipped")) failures++;
+    }
+
+    // Test 3: annulation depuis le callback de validation, run() rend la main sans tout traiter
+    tests++;
+    {
+        IndexingPipeline pipeline(2, 4);
+        pipeline.setExtractor(fakeExtract);
+        size_t committed = 0;
+        pipeline.run(jobs, [&](IndexingPipeline::Result&) {
+            if (++committed == 10) pipeline.cancel();
+            return true;
+        });
+        IndexingPipeline::Stats stats = pipeline.getStats();
+        bool ok = stats.cancelled && pipeline.isCancelled() && committed == 10 && stats.committed == 10 &&
+                  stats.stages[IndexingPipeline::STAGE_READ].items < fileCount;
+        if (!report("Cancellation", ok, std::to_string(stats.stages[IndexingPipeline::STAGE_READ].items) + " read")) failures++;
+
+        // Annulé avant le départ : rien n'est lu
+        IndexingPipeline cancelled(2);
+        cancelled.setExtractor(fakeExtract);
+        cancelled.cancel();
+        size_t changed = cancelled.run(jobs, [](IndexingPipeline::Result&) { return true; });
+        tests++;
+        if (!report("Cancelled before run", changed == 0 && cancelled.getStats().stages[IndexingPipeline::STAGE_READ].items == 0)) failures++;
+    }
+
+    std::cout << "\n" << IndexingPipeline::formatStats(fullRun) << "\n";
+    fs::remove_all(dir);
+
+    std::cout << "\n=== Test Results ===\n";
+    std::cout << "Tests run: " << tests << "\n";
+    std::cout << "Passed: " << (tests - failures) << "\n";
+    std::cout << "Failed: " << failures << "\n";
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+#include "LibraryScanner.h"
+#include "TestReport.h"
+#include <iostream>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+static void writeFile(const fs::path& path, const std::string& content) {
+    fs::create_directories(path.parent_path());
+    std::ofstream(path, std::ios::binary) << content;
+}
+
+// Ce que la base connaîtrait après avoir indexé tous les fichiers rendus
+static void remember(LibraryScanner::KnownFiles& known, const LibraryScanner::Changes& changes) {
+    for (const auto& job : changes.changed) known[job.filepath] = {};
+    for (const auto& path : changes.removed) known.erase(path);
+}
+
+static std::set<std::string> changedPaths(const LibraryScanner::Changes& changes) {
+    std::set<std::string> paths;
+    for (const auto& job : changes.changed) paths.insert(job.filepath);
+    return paths;
+}
+
+int main() {
+    int failures = 0;
+    int tests = 0;
+    const fs::path dir = fs::temp_directory_path() / "library_scanner_test";
+    const std::string journal = (dir / "scan_journal.bin").string();
+    const fs::path music = dir / "HVSC";
+    fs::remove_all(dir);
+
+    std::cout << "=== Library Scanner Tests ===\n\n";
+
+    // Arborescence : 3 niveaux, fichiers .sid (casse mélangée) et fichiers ignorés
+    for (int a = 0; a < 4; ++a) {
+        for (int b = 0; b < 5; ++b) {
+            fs::path sub = music / ("A" + std::to_string(a)) / ("B" + std::to_string(b));
+            for (int f = 0; f < 10; ++f) {
+                writeFile(sub / ("tune_" + std::to_string(f) + (f == 3 ? ".SID" : ".sid")), "SID " + std::to_string(f));
+            }
+            writeFile(sub / "readme.txt", "not a tune");
+        }
+    }
+    const size_t fileCount = 4 * 5 * 10;
+    std::vector<LibraryScanner::Root> roots{{music.string(), "HVSC"}};
+    LibraryScanner::KnownFiles known;
+
+    // Test 1: premier scan sans journal, tout est listé et ajouté avec son rootFolder
+    tests++;
+    {
+        LibraryScanner scanner;
+        bool loaded = scanner.load(journal);
+        LibraryScanner::Changes changes = scanner.scan(roots, known);
+        bool ok = !loaded && changes.added == fileCount && changes.changed.size() == fileCount &&
+                  changes.removed.empty() && changes.directories == 1 + 4 + 20 &&
+                  changes.directoriesListed == changes.directories && changes.changed[0].rootFolder == "HVSC" &&
+                  scanner.save(journal);
+        remember(known, changes);
+        if (!report("First scan", ok, std::to_string(changes.added) + " added")) failures++;
+    }
+
+    // Test 2: rescan sans changement, aucun dossier relu ni fichier rendu
+    tests++;
+    {
+        LibraryScanner scanner;
+        bool ok = scanner.load(journal);
+        LibraryScanner::Changes changes = scanner.scan(roots, known);
+        ok = ok && changes.changed.empty() && changes.removed.empty() && changes.unchanged == fileCount &&
+             changes.directoriesListed == 0 && changes.directories == 25;
+        if (!report("Unchanged rescan", ok, std::to_string(changes.seconds * 1000.0) + " ms")) failures++;
+    }
+
+    // Test 3: ajout, modification sur place, suppression d'un fichier et d'un sous-arbre
+    tests++;
+    {
+        const fs::path added = music / "A1" / "B2" / "new.sid";
+        const fs::path modified = music / "A2" / "B0" / "tune_5.sid";
+        const fs::path deleted = music / "A0" / "B4" / "tune_7.sid";
+        writeFile(added, "SID new");
+        std::ofstream(modified, std::ios::binary | std::ios::app) << " longer";
+        fs::remove(deleted);
+        fs::remove_all(music / "A3" / "B1");
+
+        LibraryScanner scanner;
+        bool ok = scanner.load(journal);
+        LibraryScanner::Changes changes = scanner.scan(roots, known);
+        std::set<std::string> removed(changes.removed.begin(), changes.removed.end());
+        ok = ok && changes.added == 1 && changes.modified == 1 &&
+             changedPaths(changes) == std::set<std::string>{added.string(), modified.string()} &&
+             removed.size() == 11 && removed.count(deleted.string()) &&
+             removed.count((music / "A3" / "B1" / "tune_0.sid").string()) &&
+             changes.directoriesListed == 3 && changes.unchanged == fileCount - 11 - 1;
+        remember(known, changes);
+        ok = ok && scanner.save(journal);
+
+        // Journal à jour : plus rien à signaler
+        LibraryScanner again;
+        LibraryScanner::Changes after = again.load(journal) ? again.scan(roots, known) : LibraryScanner::Changes{};
+        ok = ok && after.changed.empty() && after.removed.empty() && after.unchanged == fileCount - 10;
+        if (!report("Added, modified, removed", ok, std::to_string(changes.directoriesListed) + " folders listed")) failures++;
+    }
+
+    // Test 4: fichier inchangé mais absent de la base (base vidée) rendu comme ajouté
+    tests++;
+    {
+        const std::string lost = (music / "A0" / "B0" / "tune_1.sid").string();
+        LibraryScanner::KnownFiles partial = known;
+        partial.erase(lost);
+        LibraryScanner scanner;
+        bool ok = scanner.load(journal);
+        LibraryScanner::Changes changes = scanner.scan(roots, partial);
+        ok = ok && changes.added == 1 && changedPaths(changes) == std::set<std::string>{lost} && changes.directoriesListed == 0;
+        if (!report("Files missing from the database", ok)) failures++;
+    }
+
+    // Test 5: journal refusé (tronqué, magic invalide) et racine disparue
+    tests++;
+    {
+        std::string content;
+        {
+            std::ifstream in(journal, std::ios::binary);
+            content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        {
+            std::ofstream out(journal, std::ios::binary | std::ios::trunc);
+            out.write(content.data(), static_cast<std::streamsize>(content.size() - 5));
+        }
+        LibraryScanner scanner;
+        bool ok = !scanner.load(journal) && !scanner.getLastError().empty() && scanner.getDirectoryCount() == 0;
+        std::string detail = scanner.getLastError();
+        content[0] = 'X';
+        {
+            std::ofstream out(journal, std::ios::binary | std::ios::trunc);
+            out.write(content.data(), static_cast<std::streamsize>(content.size()));
+        }
+        ok = ok && !scanner.load(journal);
+        detail += ", " + scanner.getLastError();
+
+        // Journal valide puis racine supprimée : tous ses fichiers sont rendus comme supprimés
+        LibraryScanner fresh;
+        fresh.scan(roots, known);
+        fs::rename(music, dir / "moved");
+        LibraryScanner::Changes changes = fresh.scan(roots, known);
+        ok = ok && changes.removed.size() == fileCount - 10 && changes.changed.empty() && fresh.getDirectoryCount() == 0;
+        fs::rename(dir / "moved", music);
+        if (!report("Rejected journals and missing roots", ok, detail)) failures++;
+    }
+
+    // Test 6: annulation, le journal en mémoire n'est pas modifié
+    tests++;
+    {
+        LibraryScanner scanner;
+        scanner.scan(roots, known);
+        size_t before = scanner.getDirectoryCount();
+        std::atomic<bool> stop{true};
+        LibraryScanner::Changes changes = scanner.scan({{(dir / "other").string(), "Other"}}, known, &stop);
+        bool ok = changes.cancelled && scanner.getDirectoryCount() == before && before > 0;
+        if (!report("Cancellation", ok)) failures++;
+    }
+    fs::remove_all(dir);
+
+    std::cout << "\n=== Test Results ===\n";
+    std::cout << "Tests run: " << tests << "\n";
+    std::cout << "Passed: " << (tests - failures) << "\n";
+    std::cout << "Failed: " << failures << "\n";
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+#include "LoudnessMeter.h"
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+using namespace imsid::audio;
+
+// Sinus mono de fréquence et niveau donnés (dBFS crête)
+static std::vector<int16_t> sine(int sampleRate, double frequency, double levelDb, double seconds) {
+    const double pi = 3.14159265358979323846;
+    double amplitude = 32767.0 * std::pow(10.0, levelDb / 20.0);
+    std::vector<int16_t> out(static_cast<size_t>(seconds * sampleRate));
+    for (size_t i = 0; i < out.size(); ++i) {
+        out[i] = static_cast<int16_t>(std::lround(amplitude * std::sin(2.0 * pi * frequency * i / sampleRate)));
+    }
+    return out;
+}
+
+static bool expectNear(const char* name, double value, double expected, double tolerance) {
+    bool ok = std::abs(value - expected) <= tolerance;
+    std::cout << (ok ? "✓ " : "✗ ") << name << ": " << value << " LUFS (expected " << expected << ")\n";
+    return ok;
+}
+
+int main() {
+    int failures = 0;
+    int tests = 0;
+
+    std::cout << "=== Loudness Meter Tests ===\n\n";
+
+    // Test 1: sinus 997 Hz à -20 dBFS -> -23 LUFS (pondération K ~0 dB à 1 kHz), à plusieurs fréquences d'échantillonnage
+    const int rates[] = {22050, 44100, 48000, 96000};
+    for (int rate : rates) {
+        tests++;
+        LoudnessMeter meter(rate);
+        std::vector<int16_t> tone = sine(rate, 997.0, -20.0, 10.0);
+        meter.process(tone.data(), static_cast<int>(tone.size()));
+        std::string name = "997 Hz at -20 dBFS, " + std::to_string(rate) + " Hz";
+        if (!expectNear(name.c_str(), meter.getIntegratedLufs(), -23.0, 0.1)) failures++;
+    }
+
+    // Test 2: passe-haut RLB : un 20 Hz est fortement atténué
+    tests++;
+    {
+        LoudnessMeter meter(48000);
+        std::vector<int16_t> tone = sine(48000, 20.0, -20.0, 10.0);
+        meter.process(tone.data(), static_cast<int>(tone.size()));
+        double lufs = meter.getIntegratedLufs();
+        bool ok = lufs < -30.0;
+        std::cout << (ok ? "✓ " : "✗ ") << "20 Hz attenuated: " << lufs << " LUFS\n";
+        if (!ok) failures++;
+    }
+
+    // Test 3: porte relative : de longs silences et un passage très faible n'abaissent pas la mesure
+    // (seuls les blocs de transition, à cheval sur le passage fort, la tirent légèrement vers le bas)
+    tests++;
+    {
+        LoudnessMeter meter(44100);
+        std::vector<int16_t> loud = sine(44100, 997.0, -20.0, 5.0);
+        std::vector<int16_t> quiet = sine(44100, 997.0, -50.0, 5.0);
+        std::vector<int16_t> silence(44100 * 10, 0);
+        meter.process(silence.data(), static_cast<int>(silence.size()));
+        meter.process(loud.data(), static_cast<int>(loud.size()));
+        meter.process(quiet.data(), static_cast<int>(quiet.size()));
+        meter.process(silence.data(), static_cast<int>(silence.size()));
+        if (!expectNear("Gated silence and quiet passage", meter.getIntegratedLufs(), -23.0, 0.5)) failures++;
+    }
+
+    // Test 4: silence complet et signal trop court
+    tests++;
+    {
+        LoudnessMeter meter(44100);
+        std::vector<int16_t> silence(44100 * 3, 0);
+        meter.process(silence.data(), static_cast<int>(silence.size()));
+        bool ok = meter.getIntegratedLufs() == LoudnessMeter::SILENCE_LUFS;
+        std::vector<int16_t> shortTone = sine(44100, 997.0, -20.0, 0.2);
+        meter.reset();
+        meter.process(shortTone.data(), static_cast<int>(shortTone.size()));
+        ok = ok && meter.getIntegratedLufs() == LoudnessMeter::SILENCE_LUFS;
+        std::cout << (ok ? "✓ " : "✗ ") << "Silence and short input: " << (ok ? "PASSED" : "FAILED") << "\n";
+        if (!ok) failures++;
+    }
+
+    std::cout << "\n=== Test Results ===\n";
+    std::cout << "Tests run: " << tests << "\n";
+    std::cout << "Passed: " << (tests - failures) << "\n";
+    std::cout << "Failed: " << failures << "\n";
+
+    return (failures == 0) ? 0 : 1;
+}
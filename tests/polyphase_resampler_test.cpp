@@ -0,0 +1,160 @@
+#include "PolyphaseResampler.h"
+#include "TestReport.h"
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <algorithm>
+#include <string>
+
+using namespace imsid::audio;
+
+// Sinus entrelacé (même signal sur chaque canal sauf silentRight)
+static std::vector<int16_t> sine(int sampleRate, double frequency, double amplitude, int frames, int channels, bool silentRight = false) {
+    const double pi = 3.14159265358979323846;
+    std::vector<int16_t> out(static_cast<size_t>(frames) * channels);
+    for (int i = 0; i < frames; ++i) {
+        int16_t value = static_cast<int16_t>(std::lround(amplitude * std::sin(2.0 * pi * frequency * i / sampleRate)));
+        for (int c = 0; c < channels; ++c) out[i * channels + c] = (silentRight && c == 1) ? 0 : value;
+    }
+    return out;
+}
+
+// Rééchantillonne tout le signal en blocs de taille fixe (comme le thread de rendu)
+static std::vector<int16_t> resample(PolyphaseResampler& resampler, const std::vector<int16_t>& in, int channels, int block) {
+    int frames = static_cast<int>(in.size()) / channels;
+    std::vector<int16_t> out;
+    std::vector<int16_t> buffer(static_cast<size_t>(resampler.maxOutputFrames(block)) * channels);
+    for (int pos = 0; pos < frames; pos += block) {
+        int n = std::min(block, frames - pos);
+        int produced = resampler.process(in.data() + static_cast<size_t>(pos) * channels, n, buffer.data());
+        if (produced > resampler.maxOutputFrames(n)) return {};
+        out.insert(out.end(), buffer.begin(), buffer.begin() + static_cast<size_t>(produced) * channels);
+    }
+    return out;
+}
+
+// RMS d'un canal, en ignorant le début (transitoire du filtre)
+static double rms(const std::vector<int16_t>& signal, int channels, int channel, int skipFrames) {
+    double sum = 0.0;
+    int count = 0;
+    for (size_t i = static_cast<size_t>(skipFrames) * channels + channel; i < signal.size(); i += channels) {
+        sum += static_cast<double>(signal[i]) * signal[i];
+        count++;
+    }
+    return count > 0 ? std::sqrt(sum / count) : 0.0;
+}
+
+// Fréquence estimée par comptage des passages par zéro (fronts montants)
+static double zeroCrossingFrequency(const std::vector<int16_t>& signal, int channels, int sampleRate, int skipFrames) {
+    int first = -1, last = -1, crossings = 0;
+    int frames = static_cast<int>(signal.size()) / channels;
+    for (int i = skipFrames + 1; i < frames; ++i) {
+        if (signal[(i - 1) * channels] < 0 && signal[i * channels] >= 0) {
+            if (first < 0) first = i; else crossings++;
+            last = i;
+        }
+    }
+    if (crossings == 0) return 0.0;
+    return crossings * static_cast<double>(sampleRate) / (last - first);
+}
+
+int main() {
+    int failures = 0;
+    int tests = 0;
+
+    std::cout << "=== Polyphase Resampler Tests ===\n\n";
+
+    // Test 1: fréquences égales -> recopie exacte
+    tests++;
+    {
+        PolyphaseResampler resampler;
+        resampler.configure(44100, 44100, 2);
+        std::vector<int16_t> in = sine(44100, 440.0, 12000.0, 4410, 2);
+        std::vector<int16_t> out = resample(resampler, in, 2, 256);
+        if (!report("Passthrough", resampler.isPassthrough() && out == in)) failures++;
+    }
+
+    // Test 2: amplitude et fréquence conservées (1 kHz) vers plusieurs fréquences de sortie
+    const int outputRates[] = {48000, 96000, 22050, 32000};
+    for (int outputRate : outputRates) {
+        tests++;
+        PolyphaseResampler resampler;
+        resampler.configure(44100, outputRate, 2);
+        std::vector<int16_t> in = sine(44100, 1000.0, 16384.0, 44100, 2);
+        std::vector<int16_t> out = resample(resampler, in, 2, 512);
+        int frames = static_cast<int>(out.size()) / 2;
+        double expectedFrames = static_cast<double>(outputRate);
+        double gainDb = 20.0 * std::log10(rms(out, 2, 0, outputRate / 100) / rms(in, 2, 0, 441));
+        double frequency = zeroCrossingFrequency(out, 2, outputRate, outputRate / 100);
+        // Il manque au plus la latence du filtre (une demi-fenêtre) en fin de signal
+        double latencyFrames = resampler.getTapsPerPhase() * expectedFrames / 44100.0;
+        bool ok = std::abs(frames - expectedFrames) <= latencyFrames &&
+                  std::abs(gainDb) < 0.05 && std::abs(frequency - 1000.0) < 0.5;
+        std::string detail = std::to_string(frames) + " frames, " + std::to_string(gainDb) + " dB, " + std::to_string(frequency) + " Hz";
+        if (!report("44100 -> " + std::to_string(outputRate) + " Hz", ok, detail)) failures++;
+    }
+
+    // Test 3: sous-échantillonnage : une fréquence au-dessus de la nouvelle Nyquist est éliminée
+    tests++;
+    {
+        PolyphaseResampler resampler;
+        resampler.configure(44100, 22050, 1);
+        std::vector<int16_t> in = sine(44100, 15000.0, 16384.0, 44100, 1);
+        std::vector<int16_t> out = resample(resampler, in, 1, 512);
+        double attenuationDb = 20.0 * std::log10(std::max(rms(out, 1, 0, 2205), 1e-3) / rms(in, 1, 0, 0));
+        if (!report("Anti-aliasing 15 kHz at 22050 Hz", attenuationDb < -60.0, std::to_string(attenuationDb) + " dB")) failures++;
+    }
+
+    // Test 4: découpage en blocs quelconques identique à un traitement en blocs fixes
+    tests++;
+    {
+        PolyphaseResampler a, b;
+        a.configure(44100, 48000, 2);
+        b.configure(44100, 48000, 2);
+        std::vector<int16_t> in = sine(44100, 3000.0, 20000.0, 20000, 2);
+        std::vector<int16_t> reference = resample(a, in, 2, 512);
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> size(1, 900);
+        std::vector<int16_t> chunked;
+        std::vector<int16_t> buffer(static_cast<size_t>(b.maxOutputFrames(900)) * 2);
+        for (int pos = 0; pos < 20000;) {
+            int n = std::min(size(rng), 20000 - pos);
+            int produced = b.process(in.data() + static_cast<size_t>(pos) * 2, n, buffer.data());
+            chunked.insert(chunked.end(), buffer.begin(), buffer.begin() + static_cast<size_t>(produced) * 2);
+            pos += n;
+        }
+        if (!report("Arbitrary chunking", chunked == reference)) failures++;
+    }
+
+    // Test 5: canaux indépendants (canal droit silencieux)
+    tests++;
+    {
+        PolyphaseResampler resampler;
+        resampler.configure(44100, 96000, 2);
+        std::vector<int16_t> in = sine(44100, 1000.0, 16384.0, 8820, 2, true);
+        std::vector<int16_t> out = resample(resampler, in, 2, 512);
+        if (!report("Channel separation", rms(out, 2, 1, 0) == 0.0 && rms(out, 2, 0, 960) > 10000.0)) failures++;
+    }
+
+    // Test 6: rapport non réductible (phase quantifiée) : fréquence toujours exacte
+    tests++;
+    {
+        PolyphaseResampler resampler;
+        resampler.configure(44100, 47999, 1);
+        std::vector<int16_t> in = sine(44100, 1000.0, 16384.0, 44100, 1);
+        std::vector<int16_t> out = resample(resampler, in, 1, 512);
+        double frequency = zeroCrossingFrequency(out, 1, 47999, 480);
+        double gainDb = 20.0 * std::log10(rms(out, 1, 0, 480) / rms(in, 1, 0, 441));
+        bool ok = std::abs(frequency - 1000.0) < 0.5 && std::abs(gainDb) < 0.05;
+        if (!report("Quantized phases (44100 -> 47999)", ok, std::to_string(frequency) + " Hz, " + std::to_string(gainDb) + " dB")) failures++;
+    }
+
+    std::cout << "\n=== Test Results ===\n";
+    std::cout << "Tests run: " << tests << "\n";
+    std::cout << "Passed: " << (tests - failures) << "\n";
+    std::cout << "Failed: " << failures << "\n";
+
+    return (failures == 0) ? 0 : 1;
+}
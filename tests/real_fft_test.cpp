@@ -0,0 +1,82 @@
+#include "RealFft.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+using namespace imsid::audio;
+
+// DFT directe en double (référence)
+static void naiveDft(const std::vector<float>& input, std::vector<double>& re, std::vector<double>& im) {
+    const double pi = 3.14159265358979323846;
+    int n = static_cast<int>(input.size());
+    re.assign(n / 2 + 1, 0.0);
+    im.assign(n / 2 + 1, 0.0);
+    for (int k = 0; k <= n / 2; ++k) {
+        for (int t = 0; t < n; ++t) {
+            double angle = -2.0 * pi * k * t / n;
+            re[k] += input[t] * std::cos(angle);
+            im[k] += input[t] * std::sin(angle);
+        }
+    }
+}
+
+int main() {
+    int failures = 0;
+    int tests = 0;
+
+    std::cout << "=== Real FFT Tests ===\n\n";
+
+    // Test 1: spectre complexe identique à la DFT directe (erreur relative à la norme du signal)
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    const int sizes[] = {4, 8, 64, 256, 2048};
+    for (int n : sizes) {
+        tests++;
+        std::vector<float> input(n);
+        for (float& x : input) x = dist(rng);
+        std::vector<double> refRe, refIm;
+        naiveDft(input, refRe, refIm);
+        std::vector<float> outRe(n / 2 + 1), outIm(n / 2 + 1);
+        RealFft fft(n);
+        fft.forward(input.data(), outRe.data(), outIm.data());
+        double maxError = 0.0;
+        for (int k = 0; k <= n / 2; ++k) {
+            maxError = std::max(maxError, std::abs(outRe[k] - refRe[k]));
+            maxError = std::max(maxError, std::abs(outIm[k] - refIm[k]));
+        }
+        double tolerance = 1e-5 * n;
+        bool ok = maxError < tolerance;
+        std::cout << (ok ? "✓ " : "✗ ") << "forward N=" << n << " vs DFT: " << (ok ? "PASSED" : "FAILED")
+                  << " (max error " << maxError << ")\n";
+        if (!ok) failures++;
+    }
+
+    // Test 2: une sinusoïde centrée sur un bin donne son pic de puissance sur ce bin
+    tests++;
+    {
+        const int n = 2048;
+        const int bin = 100;
+        const double pi = 3.14159265358979323846;
+        std::vector<float> input(n);
+        for (int t = 0; t < n; ++t) input[t] = static_cast<float>(std::sin(2.0 * pi * bin * t / n));
+        std::vector<float> power(n / 2 + 1);
+        RealFft fft(n);
+        fft.powerSpectrum(input.data(), power.data());
+        int peak = static_cast<int>(std::max_element(power.begin(), power.end()) - power.begin());
+        // |X[bin]| = N/2 pour une sinusoïde d'amplitude 1
+        double expected = (n / 2.0) * (n / 2.0);
+        bool ok = (peak == bin) && std::abs(power[bin] - expected) < expected * 1e-3;
+        std::cout << (ok ? "✓ " : "✗ ") << "Sine peak at bin " << bin << ": " << (ok ? "PASSED" : "FAILED")
+                  << " (peak " << peak << ", power " << power[peak] << ")\n";
+        if (!ok) failures++;
+    }
+
+    std::cout << "\n=== Test Results ===\n";
+    std::cout << "Tests run: " << tests << "\n";
+    std::cout << "Passed: " << (tests - failures) << "\n";
+    std::cout << "Failed: " << failures << "\n";
+
+    return (failures == 0) ? 0 : 1;
+}